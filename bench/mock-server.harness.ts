@@ -0,0 +1,204 @@
+import * as http from 'node:http';
+import * as https from 'node:https';
+import { getTlsCaCertificate, makeConsumerPact } from '../src';
+import { FfiSpecificationVersion } from '../src/ffi/types';
+import {
+  elapsedMs,
+  envNumber,
+  envNumbers,
+  HOST,
+  nowNs,
+  summarise,
+  writeResults,
+} from './utils';
+
+// Throughput and tail latency of a mock server under load, over http and
+// https, for a range of interaction counts and concurrency levels. Also
+// measures how long fetching the mismatch report takes once requests have
+// piled up. Everything runs against 127.0.0.1.
+//
+//   npm run bench:mock-server
+//
+// BENCH_DURATION_MS, BENCH_CONCURRENCY, BENCH_INTERACTIONS and
+// BENCH_MISMATCHES override the defaults below.
+
+const DURATION_MS = envNumber('BENCH_DURATION_MS', 5000);
+const CONCURRENCY = envNumbers('BENCH_CONCURRENCY', [1, 8, 32, 128]);
+const INTERACTIONS = envNumbers('BENCH_INTERACTIONS', [1, 100, 1000]);
+const MISMATCHES = envNumber('BENCH_MISMATCHES', 1000);
+const TRANSPORTS = ['http', 'https'] as const;
+
+type Transport = (typeof TRANSPORTS)[number];
+
+type Client = {
+  get: (path: string) => Promise<number>;
+  destroy: () => void;
+};
+
+const makeClient = (
+  transport: Transport,
+  port: number,
+  concurrency: number,
+): Client => {
+  const agent =
+    transport === 'https'
+      ? new https.Agent({
+          keepAlive: true,
+          maxSockets: concurrency,
+          ca: getTlsCaCertificate('error') ?? undefined,
+        })
+      : new http.Agent({ keepAlive: true, maxSockets: concurrency });
+  const requester = transport === 'https' ? https : http;
+
+  return {
+    get: (path: string) =>
+      new Promise<number>((resolve, reject) => {
+        const req = requester.request(
+          { host: HOST, port, path, agent, method: 'GET' },
+          (res) => {
+            res.resume();
+            res.on('end', () => resolve(res.statusCode ?? 0));
+          },
+        );
+        req.on('error', reject);
+        req.end();
+      }),
+    destroy: () => agent.destroy(),
+  };
+};
+
+const startMockServer = (transport: Transport, interactions: number) => {
+  const pact = makeConsumerPact(
+    'bench-consumer',
+    'bench-provider',
+    FfiSpecificationVersion.SPECIFICATION_VERSION_V4,
+    'error',
+  );
+
+  for (let i = 0; i < interactions; i += 1) {
+    const interaction = pact.newInteraction(`a request for item ${i}`);
+    interaction.uponReceiving(`a request for item ${i}`);
+    interaction.withRequest('GET', `/items/${i}`);
+    interaction.withStatus(200);
+    interaction.withResponseBody(
+      JSON.stringify({ id: i, name: `item ${i}` }),
+      'application/json',
+    );
+  }
+
+  return { pact, port: pact.createMockServer(HOST, 0, transport === 'https') };
+};
+
+// Closed loop load: each of `concurrency` workers sends its next request as
+// soon as the previous one completes, over keep-alive connections
+const drive = async (
+  client: Client,
+  concurrency: number,
+  interactions: number,
+  durationMs: number,
+) => {
+  const latencies: number[] = [];
+  let errors = 0;
+  const start = nowNs();
+  const deadline = Date.now() + durationMs;
+
+  const worker = async (offset: number) => {
+    for (let i = offset; Date.now() < deadline; i += concurrency) {
+      const sent = nowNs();
+      try {
+        const status = await client.get(`/items/${i % interactions}`);
+        if (status !== 200) {
+          errors += 1;
+        }
+        latencies.push(elapsedMs(sent));
+      } catch {
+        errors += 1;
+      }
+    }
+  };
+
+  await Promise.all(Array.from({ length: concurrency }, (_, i) => worker(i)));
+  const wallMs = elapsedMs(start);
+
+  return {
+    rps: (latencies.length / wallMs) * 1000,
+    errors,
+    latency: summarise(latencies),
+  };
+};
+
+// Sends requests no interaction matches, then times fetching (and parsing)
+// the mismatch report the mock server has built up
+const mismatchReport = async (transport: Transport) => {
+  const { pact, port } = startMockServer(transport, 1);
+  const client = makeClient(transport, port, 8);
+
+  await Promise.all(
+    Array.from({ length: MISMATCHES }, (_, i) =>
+      client.get(`/unexpected/${i}`).catch(() => 0),
+    ),
+  );
+
+  const start = nowNs();
+  const mismatches = pact.mockServerMismatches(port);
+  const reportMs = elapsedMs(start);
+
+  client.destroy();
+  pact.cleanupMockServer(port);
+
+  return { requests: MISMATCHES, mismatches: mismatches.length, reportMs };
+};
+
+describe('mock server throughput', () => {
+  it(
+    'measures rps and tail latency',
+    async () => {
+      const results: unknown[] = [];
+
+      for (const transport of TRANSPORTS) {
+        for (const interactions of INTERACTIONS) {
+          const { pact, port } = startMockServer(transport, interactions);
+
+          for (const concurrency of CONCURRENCY) {
+            const client = makeClient(transport, port, concurrency);
+            const load = await drive(
+              client,
+              concurrency,
+              interactions,
+              DURATION_MS,
+            );
+            client.destroy();
+
+            const start = nowNs();
+            const mismatches = pact.mockServerMismatches(port);
+            const mismatchReportMs = elapsedMs(start);
+
+            results.push({
+              transport,
+              interactions,
+              concurrency,
+              ...load,
+              mismatches: mismatches.length,
+              mismatchReportMs,
+            });
+          }
+
+          pact.cleanupMockServer(port);
+        }
+
+        results.push({
+          transport,
+          scenario: 'mismatch report',
+          ...(await mismatchReport(transport)),
+        });
+      }
+
+      const file = writeResults('mock-server', results);
+      console.log(`mock server results written to ${file}`);
+    },
+    TRANSPORTS.length *
+      INTERACTIONS.length *
+      CONCURRENCY.length *
+      (DURATION_MS + 30000),
+  );
+});
@@ -0,0 +1,592 @@
+import * as fs from 'node:fs';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { getFfiLib } from '../src/ffi';
+import {
+  type FfiPactHandle,
+  FfiSpecificationVersion,
+  INTERACTION_PART_REQUEST,
+  INTERACTION_PART_RESPONSE,
+} from '../src/ffi/types';
+import { writeResults } from './utils';
+
+// Per call cost of the native exports, with small and large arguments. Run
+// with `npm run bench:native`, which writes ops/sec and percentiles to
+// bench/results/native.json. Compare against the raw pact_ffi cost from
+// `npm run bench:ffi` to see what the binding layer adds.
+
+const ffi = getFfiLib('error');
+
+// String arguments are decoded without allocating (see native/marshal.h), so
+// heapAllocations should stay flat however many strings are passed
+afterAll(() => {
+  const file = writeResults(
+    'native-marshalling',
+    ffi.pactffiStats().marshalling,
+  );
+  console.log(`marshalling counts written to ${file}`);
+});
+
+const jsonBody = (bytes: number): string => {
+  const items: { id: number; name: string }[] = [];
+  let size = 0;
+  for (let i = 0; size < bytes; i += 1) {
+    items.push({ id: i, name: `item ${i}` });
+    size += 24;
+  }
+  return JSON.stringify({ items });
+};
+
+const SMALL_BODY = jsonBody(64);
+const LARGE_BODY = jsonBody(1024 * 1024);
+const LARGE_OBJECT = JSON.parse(LARGE_BODY);
+const SMALL_BINARY = Buffer.alloc(64, 0xab);
+const LARGE_BINARY = Buffer.alloc(1024 * 1024, 0xab);
+const SMALL_LIST = ['consumer-1'];
+const LARGE_LIST = Array.from({ length: 1000 }, (_, i) => `consumer-${i}`);
+const HEADERS = Object.fromEntries(
+  Array.from({ length: 20 }, (_, i) => [`x-header-${i}`, `value ${i}`]),
+);
+
+const newPact = () => {
+  const pact = ffi.pactffiNewPact('bench-consumer', 'bench-provider');
+  ffi.pactffiWithSpecification(
+    pact,
+    FfiSpecificationVersion.SPECIFICATION_VERSION_V4,
+  );
+  return pact;
+};
+
+// Calls that add to a pact (interactions, states, matching rules) would grow it
+// for as long as a bench runs, so results would drift with the iteration count
+// and the process would leak. They go to a pact that is freed and replaced
+// every RECYCLE_EVERY calls instead, which bounds its size.
+const RECYCLE_EVERY = 100;
+
+const recycled = <T>(create: (pact: FfiPactHandle) => T): (() => T) => {
+  let pact = newPact();
+  let subject = create(pact);
+  let calls = 0;
+  afterAll(() => {
+    ffi.pactffiFreePactHandle(pact);
+  });
+  return () => {
+    calls += 1;
+    if (calls > RECYCLE_EVERY) {
+      ffi.pactffiFreePactHandle(pact);
+      pact = newPact();
+      subject = create(pact);
+      calls = 1;
+    }
+    return subject;
+  };
+};
+
+describe('core', () => {
+  bench('pactffiVersion', () => {
+    ffi.pactffiVersion();
+  });
+});
+
+describe('consumer DSL', () => {
+  const pact = newPact();
+  const interaction = ffi.pactffiNewInteraction(pact, 'a bench interaction');
+  const growingPact = recycled((pact) => pact);
+  const growing = recycled((pact) =>
+    ffi.pactffiNewInteraction(pact, 'a bench interaction'),
+  );
+  afterAll(() => {
+    ffi.pactffiFreePactHandle(pact);
+  });
+
+  bench('pactffiNewPact + pactffiFreePactHandle', () => {
+    ffi.pactffiFreePactHandle(newPact());
+  });
+
+  bench('pactffiNewInteraction', () => {
+    ffi.pactffiNewInteraction(growingPact(), 'another interaction');
+  });
+
+  bench('pactffiUponReceiving', () => {
+    ffi.pactffiUponReceiving(interaction, 'a request for an item');
+  });
+
+  bench('pactffiGiven', () => {
+    ffi.pactffiGiven(growing(), 'an item exists');
+  });
+
+  bench('pactffiGivenWithParam', () => {
+    ffi.pactffiGivenWithParam(growing(), 'an item exists', 'id', '10');
+  });
+
+  bench('pactffiGivenWithParams (small)', () => {
+    ffi.pactffiGivenWithParams(growing(), 'an item exists', '{"id":10}');
+  });
+
+  bench('pactffiGivenWithParams (large)', () => {
+    ffi.pactffiGivenWithParams(growing(), 'an item exists', LARGE_BODY);
+  });
+
+  bench('pactffiWithRequest', () => {
+    ffi.pactffiWithRequest(interaction, 'GET', '/items/10');
+  });
+
+  bench('pactffiWithQueryParameter', () => {
+    ffi.pactffiWithQueryParameter(interaction, 'page', 0, '1');
+  });
+
+  bench('pactffiWithHeader', () => {
+    ffi.pactffiWithHeader(
+      interaction,
+      INTERACTION_PART_REQUEST,
+      'Accept',
+      0,
+      'application/json',
+    );
+  });
+
+  // 20 headers in one call, against one call per header
+  bench('pactffiWithHeaders (20)', () => {
+    ffi.pactffiWithHeaders(interaction, INTERACTION_PART_REQUEST, HEADERS);
+  });
+
+  bench('pactffiWithHeader (20 calls)', () => {
+    for (const [name, value] of Object.entries(HEADERS)) {
+      ffi.pactffiWithHeader(
+        interaction,
+        INTERACTION_PART_REQUEST,
+        name,
+        0,
+        value,
+      );
+    }
+  });
+
+  bench('pactffiWithQueryParameters', () => {
+    ffi.pactffiWithQueryParameters(interaction, {
+      page: '1',
+      tag: ['a', 'b', 'c'],
+    });
+  });
+
+  bench('pactffiResponseStatus', () => {
+    ffi.pactffiResponseStatus(interaction, '200');
+  });
+
+  bench('pactffiWithBody (small)', () => {
+    ffi.pactffiWithBody(
+      interaction,
+      INTERACTION_PART_RESPONSE,
+      'application/json',
+      SMALL_BODY,
+    );
+  });
+
+  bench('pactffiWithBody (large)', () => {
+    ffi.pactffiWithBody(
+      interaction,
+      INTERACTION_PART_RESPONSE,
+      'application/json',
+      LARGE_BODY,
+    );
+  });
+
+  // The same body given as an object, serialised natively (see native/json.h),
+  // against stringifying it in JS first
+  bench('pactffiWithBody (large object)', () => {
+    ffi.pactffiWithBody(
+      interaction,
+      INTERACTION_PART_RESPONSE,
+      'application/json',
+      LARGE_OBJECT,
+    );
+  });
+
+  bench('pactffiWithBody (large object, JSON.stringify)', () => {
+    ffi.pactffiWithBody(
+      interaction,
+      INTERACTION_PART_RESPONSE,
+      'application/json',
+      JSON.stringify(LARGE_OBJECT),
+    );
+  });
+
+  bench('pactffiWithBinaryFile (small)', () => {
+    ffi.pactffiWithBinaryFile(
+      interaction,
+      INTERACTION_PART_RESPONSE,
+      'application/octet-stream',
+      SMALL_BINARY,
+      SMALL_BINARY.length,
+    );
+  });
+
+  bench('pactffiWithBinaryFile (large)', () => {
+    ffi.pactffiWithBinaryFile(
+      interaction,
+      INTERACTION_PART_RESPONSE,
+      'application/octet-stream',
+      LARGE_BINARY,
+      LARGE_BINARY.length,
+    );
+  });
+
+  // A body read from disk: mapped natively, against reading it into a Buffer
+  const binaryFile = path.join(
+    fs.mkdtempSync(path.join(os.tmpdir(), 'pact-bench-')),
+    'body.bin',
+  );
+  fs.writeFileSync(binaryFile, LARGE_BINARY);
+
+  bench('pactffiWithBinaryFilePath (large)', () => {
+    ffi.pactffiWithBinaryFilePath(
+      interaction,
+      INTERACTION_PART_RESPONSE,
+      'application/octet-stream',
+      binaryFile,
+    );
+  });
+
+  bench('readFileSync + pactffiWithBinaryFile (large)', () => {
+    const body = fs.readFileSync(binaryFile);
+    ffi.pactffiWithBinaryFile(
+      interaction,
+      INTERACTION_PART_RESPONSE,
+      'application/octet-stream',
+      body,
+      body.length,
+    );
+  });
+
+  // Multipart bodies of three parts, from Buffers against temp files
+  const partBodies = [SMALL_BINARY, Buffer.from(SMALL_BODY), LARGE_BINARY];
+  const partsDir = fs.mkdtempSync(path.join(os.tmpdir(), 'pact-bench-'));
+
+  bench('pactffiWithMultipartParts (3 parts)', () => {
+    ffi.pactffiWithMultipartParts(
+      growing(),
+      INTERACTION_PART_REQUEST,
+      partBodies.map((body, i) => ({
+        name: `part-${i}`,
+        contentType: 'application/octet-stream',
+        body,
+      })),
+    );
+  });
+
+  bench('temp files + pactffiWithMultipartFile (3 parts)', () => {
+    const interaction = growing();
+    partBodies.forEach((body, i) => {
+      const file = path.join(partsDir, `part-${i}`);
+      fs.writeFileSync(file, body);
+      ffi.pactffiWithMultipartFile(
+        interaction,
+        INTERACTION_PART_REQUEST,
+        'application/octet-stream',
+        file,
+        `part-${i}`,
+        'bench-boundary',
+      );
+      fs.unlinkSync(file);
+    });
+  });
+
+  bench('pactffiWithMatchingRules', () => {
+    ffi.pactffiWithMatchingRules(
+      growing(),
+      INTERACTION_PART_RESPONSE,
+      '{"$.body.id":{"match":"type"}}',
+    );
+  });
+});
+
+describe('interaction cloning', () => {
+  const withBase = recycled((pact) => {
+    ffi.pactffiEnableJournal(pact);
+    const base = ffi.pactffiNewInteraction(pact, 'a base interaction');
+    ffi.pactffiUponReceiving(base, 'a request for an item');
+    ffi.pactffiGiven(base, 'items exist');
+    ffi.pactffiWithRequest(base, 'GET', '/items/1');
+    ffi.pactffiWithHeaders(base, INTERACTION_PART_REQUEST, HEADERS);
+    ffi.pactffiResponseStatus(base, '200');
+    ffi.pactffiWithBody(
+      base,
+      INTERACTION_PART_RESPONSE,
+      'application/json',
+      SMALL_BODY,
+    );
+    return base;
+  });
+  const growingPact = recycled((pact) => pact);
+  let variant = 0;
+
+  // One call per variant, against rebuilding the interaction through the DSL
+  bench('pactffiCloneInteraction', () => {
+    variant += 1;
+    ffi.pactffiCloneInteraction(withBase(), {
+      description: `variant ${variant}`,
+      path: `/items/${variant}`,
+    });
+  });
+
+  bench('rebuild through the DSL', () => {
+    variant += 1;
+    const interaction = ffi.pactffiNewInteraction(
+      growingPact(),
+      `variant ${variant}`,
+    );
+    ffi.pactffiUponReceiving(interaction, 'a request for an item');
+    ffi.pactffiGiven(interaction, 'items exist');
+    ffi.pactffiWithRequest(interaction, 'GET', `/items/${variant}`);
+    for (const [name, value] of Object.entries(HEADERS)) {
+      ffi.pactffiWithHeader(
+        interaction,
+        INTERACTION_PART_REQUEST,
+        name,
+        0,
+        value,
+      );
+    }
+    ffi.pactffiResponseStatus(interaction, '200');
+    ffi.pactffiWithBody(
+      interaction,
+      INTERACTION_PART_RESPONSE,
+      'application/json',
+      SMALL_BODY,
+    );
+  });
+});
+
+// Loading a stored pact of 100 interactions in one call, from a mapped file and
+// from a Buffer
+describe('pact import', () => {
+  const contents = Buffer.from(
+    JSON.stringify({
+      consumer: { name: 'bench-consumer' },
+      provider: { name: 'bench-provider' },
+      interactions: Array.from({ length: 100 }, (_, i) => ({
+        description: `a request for item ${i}`,
+        providerStates: [{ name: 'items exist' }],
+        request: { method: 'GET', path: `/items/${i}`, headers: HEADERS },
+        response: {
+          status: 200,
+          headers: { 'Content-Type': 'application/json' },
+          body: JSON.parse(SMALL_BODY),
+        },
+      })),
+      metadata: { pactSpecification: { version: '4.0' } },
+    }),
+  );
+  const file = path.join(
+    fs.mkdtempSync(path.join(os.tmpdir(), 'pact-bench-')),
+    'pact.json',
+  );
+  fs.writeFileSync(file, contents);
+
+  bench('pactffiImportPact (file)', () => {
+    ffi.pactffiFreePactHandle(ffi.pactffiImportPact(file));
+  });
+
+  bench('pactffiImportPact (Buffer)', () => {
+    ffi.pactffiFreePactHandle(ffi.pactffiImportPact(contents));
+  });
+});
+
+// Restoring a base pact of 20 interactions from a snapshot, against building
+// it through the DSL
+describe('pact snapshots', () => {
+  const build = (journal = false) => {
+    const pact = newPact();
+    if (journal) {
+      ffi.pactffiEnableJournal(pact);
+    }
+    for (let i = 0; i < 20; i += 1) {
+      const interaction = ffi.pactffiNewInteraction(pact, `base ${i}`);
+      ffi.pactffiUponReceiving(interaction, `a request for item ${i}`);
+      ffi.pactffiWithRequest(interaction, 'GET', `/items/${i}`);
+      ffi.pactffiWithHeaders(interaction, INTERACTION_PART_REQUEST, HEADERS);
+      ffi.pactffiResponseStatus(interaction, '200');
+      ffi.pactffiWithBody(
+        interaction,
+        INTERACTION_PART_RESPONSE,
+        'application/json',
+        SMALL_BODY,
+      );
+    }
+    return pact;
+  };
+  const base = build(true);
+  const snapshot = ffi.pactffiSnapshotPact(base);
+  ffi.pactffiFreePactHandle(base);
+
+  bench('pactffiRestorePact', () => {
+    ffi.pactffiFreePactHandle(ffi.pactffiRestorePact(snapshot));
+  });
+
+  bench('rebuild through the DSL', () => {
+    ffi.pactffiFreePactHandle(build());
+  });
+});
+
+// Typed exports check their arguments in one pass over a table derived from
+// the FFI signature (see native/typed_export.h); this is the cost of a
+// rejected call, including building the error
+describe('argument checks', () => {
+  const pact = newPact();
+  const interaction = ffi.pactffiNewInteraction(pact, 'a bench interaction');
+  const invalid = ffi.pactffiWithRequest as unknown as (
+    ...args: unknown[]
+  ) => boolean;
+
+  bench('pactffiWithRequest (mistyped argument)', () => {
+    try {
+      invalid(interaction, 'GET', 10);
+    } catch {
+      // expected
+    }
+  });
+
+  bench('pactffiWithRequest (missing argument)', () => {
+    try {
+      invalid(interaction, 'GET');
+    } catch {
+      // expected
+    }
+  });
+});
+
+describe('messages', () => {
+  const pact = newPact();
+  const message = ffi.pactffiNewAsyncMessage(pact, 'an item event');
+  ffi.pactffiMessageWithContents(message, 'application/json', SMALL_BODY);
+  const growingPact = recycled((pact) => pact);
+  afterAll(() => {
+    ffi.pactffiFreePactHandle(pact);
+  });
+
+  bench('pactffiNewAsyncMessage', () => {
+    ffi.pactffiNewAsyncMessage(growingPact(), 'another item event');
+  });
+
+  bench('pactffiMessageWithContents (small)', () => {
+    ffi.pactffiMessageWithContents(message, 'application/json', SMALL_BODY);
+  });
+
+  bench('pactffiMessageWithContents (large)', () => {
+    ffi.pactffiMessageWithContents(message, 'application/json', LARGE_BODY);
+  });
+
+  bench('pactffiMessageWithContents (large object)', () => {
+    ffi.pactffiMessageWithContents(message, 'application/json', LARGE_OBJECT);
+  });
+
+  bench('pactffiMessageWithBinaryContents (large)', () => {
+    ffi.pactffiMessageWithBinaryContents(
+      message,
+      'application/octet-stream',
+      LARGE_BINARY,
+      LARGE_BINARY.length,
+    );
+  });
+
+  bench('pactffiMessageWithMetadata', () => {
+    ffi.pactffiMessageWithMetadata(message, 'queue', 'items');
+  });
+
+  bench('pactffiMessageReify', () => {
+    ffi.pactffiMessageReify(message);
+  });
+});
+
+describe('mock server', () => {
+  const pact = newPact();
+  const interaction = ffi.pactffiNewInteraction(pact, 'a bench interaction');
+  ffi.pactffiWithRequest(interaction, 'GET', '/items/10');
+  ffi.pactffiResponseStatus(interaction, '200');
+  const port = ffi.pactffiCreateMockServerForTransport(
+    pact,
+    '127.0.0.1',
+    0,
+    'http',
+    '',
+  );
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'pact-bench-'));
+
+  bench(
+    'pactffiCreateMockServerForTransport + pactffiCleanupMockServer',
+    () => {
+      const started = ffi.pactffiCreateMockServerForTransport(
+        pact,
+        '127.0.0.1',
+        0,
+        'http',
+        '',
+      );
+      ffi.pactffiCleanupMockServer(started);
+    },
+    { time: 2000 },
+  );
+
+  bench('pactffiMockServerMatched', () => {
+    ffi.pactffiMockServerMatched(port);
+  });
+
+  bench('pactffiMockServerMismatches', () => {
+    ffi.pactffiMockServerMismatches(port);
+  });
+
+  bench(
+    'pactffiWritePactFile',
+    () => {
+      ffi.pactffiWritePactFile(pact, dir, true);
+    },
+    { time: 2000 },
+  );
+});
+
+// One call for a batch of fixture values, against one call per value
+describe('matcher definitions', () => {
+  const definition = "matching(regex, '[0-9]+', '100')";
+  const values = Array.from({ length: 1000 }, (_, i) => `${i}`);
+
+  bench('pactffiMatchValues (1000 values)', () => {
+    ffi.pactffiMatchValues(definition, values);
+  });
+
+  bench('pactffiMatchValues (1000 calls)', () => {
+    for (const value of values) {
+      ffi.pactffiMatchValues(definition, [value]);
+    }
+  });
+});
+
+describe('verifier', () => {
+  const handle = ffi.pactffiVerifierNewForApplication('pact-js-bench', '1.0.0');
+
+  bench('pactffiVerifierSetProviderInfo', () => {
+    ffi.pactffiVerifierSetProviderInfo(
+      handle,
+      'bench-provider',
+      'http',
+      '127.0.0.1',
+      8080,
+      '/',
+    );
+  });
+
+  bench('pactffiVerifierAddCustomHeader', () => {
+    ffi.pactffiVerifierAddCustomHeader(handle, 'Authorization', 'Bearer 1234');
+  });
+
+  bench('pactffiVerifierSetConsumerFilters (small)', () => {
+    ffi.pactffiVerifierSetConsumerFilters(handle, SMALL_LIST);
+  });
+
+  bench('pactffiVerifierSetConsumerFilters (large)', () => {
+    ffi.pactffiVerifierSetConsumerFilters(handle, LARGE_LIST);
+  });
+
+  bench('pactffiVerifierJson', () => {
+    ffi.pactffiVerifierJson(handle);
+  });
+});
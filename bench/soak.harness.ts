@@ -0,0 +1,260 @@
+import * as fs from 'node:fs';
+import * as http from 'node:http';
+import type { AddressInfo } from 'node:net';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import * as v8 from 'node:v8';
+import * as vm from 'node:vm';
+import { getFfiLib, setLogSinks } from '../src/ffi';
+import {
+  FfiSpecificationVersion,
+  INTERACTION_PART_RESPONSE,
+} from '../src/ffi/types';
+import { elapsedMs, envNumber, HOST, nowNs, writeResults } from './utils';
+
+// Memory soak for long lived processes (verification daemons, watch mode
+// runners). Runs create/verify/cleanup cycles through the native layer and
+// samples RSS, V8 external memory and the C allocator, then fails if any of
+// them grows faster than its budget per 10k cycles.
+//
+// Each cycle goes through the paths that have held on to memory before:
+// mock server mismatches, message reification, message iterators, the log
+// buffer, verifier handles and the string arrays passed to the verifier.
+//
+//   npm run bench:soak
+//
+// BENCH_SOAK_MINUTES (or BENCH_SOAK_CYCLES), BENCH_SAMPLE_EVERY,
+// BENCH_VERIFY_EVERY and the BENCH_BUDGET_*_MB budgets override the defaults
+// below.
+
+const SOAK_MS = envNumber('BENCH_SOAK_MINUTES', 10) * 60 * 1000;
+const SOAK_CYCLES = envNumber('BENCH_SOAK_CYCLES', Number.POSITIVE_INFINITY);
+const SAMPLE_EVERY = envNumber('BENCH_SAMPLE_EVERY', 500);
+const VERIFY_EVERY = envNumber('BENCH_VERIFY_EVERY', 10);
+// Allowed growth per 10k cycles, once warmed up
+const BUDGET_MB = {
+  rss: envNumber('BENCH_BUDGET_RSS_MB', 16),
+  external: envNumber('BENCH_BUDGET_EXTERNAL_MB', 4),
+  native: envNumber('BENCH_BUDGET_NATIVE_MB', 8),
+};
+// Samples taken before this fraction of the run are ignored, so allocator
+// and JIT warm up doesn't count as growth
+const WARMUP_FRACTION = 0.1;
+
+setLogSinks([{ type: 'buffer', level: 'info' }]);
+const ffi = getFfiLib('error');
+
+v8.setFlagsFromString('--expose-gc');
+const gc = vm.runInNewContext('gc') as () => void;
+
+type Sample = {
+  cycle: number;
+  elapsedMs: number;
+  rssMb: number;
+  externalMb: number;
+  heapUsedMb: number;
+  nativeMb: number | null;
+};
+
+const sample = (cycle: number, start: bigint): Sample => {
+  gc();
+  const memory = process.memoryUsage();
+  const allocator = ffi.pactffiAllocatorStats();
+  return {
+    cycle,
+    elapsedMs: elapsedMs(start),
+    rssMb: memory.rss / 1024 / 1024,
+    externalMb: memory.external / 1024 / 1024,
+    heapUsedMb: memory.heapUsed / 1024 / 1024,
+    nativeMb: allocator ? allocator.allocatedBytes / 1024 / 1024 : null,
+  };
+};
+
+// Least squares slope of `value` against cycle count, scaled to 10k cycles
+const growthPer10k = (
+  samples: Sample[],
+  value: (s: Sample) => number | null,
+): number | null => {
+  const points = samples
+    .map((s) => [s.cycle, value(s)] as const)
+    .filter((p): p is readonly [number, number] => p[1] !== null);
+  if (points.length < 2) {
+    return null;
+  }
+
+  const meanX = points.reduce((sum, [x]) => sum + x, 0) / points.length;
+  const meanY = points.reduce((sum, [, y]) => sum + y, 0) / points.length;
+  let covariance = 0;
+  let variance = 0;
+  for (const [x, y] of points) {
+    covariance += (x - meanX) * (y - meanY);
+    variance += (x - meanX) ** 2;
+  }
+  return variance === 0 ? 0 : (covariance / variance) * 10000;
+};
+
+const get = (port: number, urlPath: string) =>
+  new Promise<number>((resolve, reject) => {
+    http
+      .get({ host: HOST, port, path: urlPath }, (res) => {
+        res.resume();
+        res.on('end', () => resolve(res.statusCode ?? 0));
+      })
+      .on('error', reject);
+  });
+
+const startProvider = async () => {
+  const server = http.createServer((req, res) => {
+    req.resume();
+    res.writeHead(200, { 'Content-Type': 'application/json' });
+    res.end(JSON.stringify({ id: 1, name: 'item 1' }));
+  });
+  await new Promise<void>((resolve) => server.listen(0, HOST, resolve));
+  return server;
+};
+
+const writePactFile = (dir: string) => {
+  const file = path.join(dir, 'soak-consumer-soak-provider.json');
+  fs.writeFileSync(
+    file,
+    JSON.stringify({
+      consumer: { name: 'soak-consumer' },
+      provider: { name: 'soak-provider' },
+      interactions: [
+        {
+          description: 'a request for an item',
+          request: { method: 'GET', path: '/items/1' },
+          response: {
+            status: 200,
+            headers: { 'Content-Type': 'application/json' },
+            body: { id: 1, name: 'item 1' },
+          },
+        },
+      ],
+      metadata: { pactSpecification: { version: '3.0.0' } },
+    }),
+  );
+  return file;
+};
+
+const consumerCycle = async () => {
+  const pact = ffi.pactffiNewPact('soak-consumer', 'soak-provider');
+  ffi.pactffiWithSpecification(
+    pact,
+    FfiSpecificationVersion.SPECIFICATION_VERSION_V4,
+  );
+
+  const interaction = ffi.pactffiNewInteraction(pact, 'a request for an item');
+  ffi.pactffiUponReceiving(interaction, 'a request for an item');
+  ffi.pactffiWithRequest(interaction, 'GET', '/items/1');
+  ffi.pactffiResponseStatus(interaction, '200');
+  ffi.pactffiWithBody(
+    interaction,
+    INTERACTION_PART_RESPONSE,
+    'application/json',
+    '{"id":1,"name":"item 1"}',
+  );
+
+  const message = ffi.pactffiNewAsyncMessage(pact, 'an item event');
+  ffi.pactffiMessageWithContents(message, 'application/json', '{"id":1}');
+  ffi.pactffiMessageReify(message);
+  ffi.pactffiGetAsyncMessageRequestContents(pact, 1, 0);
+
+  const port = ffi.pactffiCreateMockServerForTransport(
+    pact,
+    HOST,
+    0,
+    'http',
+    '',
+  );
+  await get(port, '/items/1');
+  await get(port, '/unexpected');
+  ffi.pactffiMockServerMatched(port);
+  ffi.pactffiMockServerMismatches(port);
+  ffi.pactffiCleanupMockServer(port);
+
+  ffi.pactffiFetchLogBuffer('');
+};
+
+const verifierCycle = async (
+  providerPort: number,
+  pactFile: string,
+  execute: boolean,
+) => {
+  const handle = ffi.pactffiVerifierNewForApplication('pact-js-soak', '1.0.0');
+  ffi.pactffiVerifierSetProviderInfo(
+    handle,
+    'soak-provider',
+    'http',
+    HOST,
+    providerPort,
+    '/',
+  );
+  ffi.pactffiVerifierSetConsumerFilters(handle, ['soak-consumer', 'other']);
+  ffi.pactffiVerifierAddCustomHeader(handle, 'Authorization', 'Bearer 1234');
+  ffi.pactffiVerifierAddFileSource(handle, pactFile);
+
+  if (execute) {
+    await new Promise<void>((resolve, reject) => {
+      ffi.pactffiVerifierExecute(handle, (err: Error) =>
+        err ? reject(err) : resolve(),
+      );
+    });
+    ffi.pactffiVerifierJson(handle);
+  }
+
+  ffi.pactffiVerifierShutdown(handle);
+};
+
+describe('memory soak', () => {
+  it(
+    'stays within its memory growth budget',
+    async () => {
+      const provider = await startProvider();
+      const providerPort = (provider.address() as AddressInfo).port;
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'pact-bench-soak-'));
+      const pactFile = writePactFile(dir);
+
+      const samples: Sample[] = [];
+      const start = nowNs();
+      let cycle = 0;
+
+      samples.push(sample(cycle, start));
+      while (cycle < SOAK_CYCLES && elapsedMs(start) < SOAK_MS) {
+        await consumerCycle();
+        await verifierCycle(providerPort, pactFile, cycle % VERIFY_EVERY === 0);
+        cycle += 1;
+
+        if (cycle % SAMPLE_EVERY === 0) {
+          samples.push(sample(cycle, start));
+        }
+      }
+      samples.push(sample(cycle, start));
+
+      await new Promise((resolve) => provider.close(resolve));
+      fs.rmSync(dir, { recursive: true, force: true });
+
+      const steady = samples.filter((s) => s.cycle >= cycle * WARMUP_FRACTION);
+      const growth = {
+        rssMbPer10k: growthPer10k(steady, (s) => s.rssMb),
+        externalMbPer10k: growthPer10k(steady, (s) => s.externalMb),
+        nativeMbPer10k: growthPer10k(steady, (s) => s.nativeMb),
+      };
+
+      const file = writeResults('soak', {
+        cycles: cycle,
+        budgetMbPer10k: BUDGET_MB,
+        growth,
+        samples,
+      });
+      console.log(`soak results written to ${file}`);
+
+      expect(growth.rssMbPer10k ?? 0).toBeLessThanOrEqual(BUDGET_MB.rss);
+      expect(growth.externalMbPer10k ?? 0).toBeLessThanOrEqual(
+        BUDGET_MB.external,
+      );
+      expect(growth.nativeMbPer10k ?? 0).toBeLessThanOrEqual(BUDGET_MB.native);
+    },
+    SOAK_MS + 10 * 60 * 1000,
+  );
+});
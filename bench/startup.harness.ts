@@ -0,0 +1,108 @@
+import { execFileSync } from 'node:child_process';
+import * as fs from 'node:fs';
+import * as path from 'node:path';
+import { envNumber, summarise, writeResults } from './utils';
+
+// Time from require to the first native call, in a fresh process each run,
+// for callers that only need part of the package: a CLI that only verifies,
+// a test file that only runs a mock server, and so on. Runs against the
+// compiled package in dist, so build it first.
+//
+// Each scenario runs twice: lazily, as shipped, where each export group is
+// registered on first use, and eagerly (PACT_EAGER_EXPORT_GROUPS=1), where
+// every group is registered when the core is loaded. The difference between
+// the two is what the deferred registration saves.
+//
+//   npm run build && npm run bench:startup
+//
+// BENCH_STARTUP_RUNS overrides the number of processes started per scenario.
+
+const RUNS = envNumber('BENCH_STARTUP_RUNS', 20);
+const DIST = path.resolve(__dirname, '..', 'dist', 'index.js');
+
+// Each scenario runs after `core` has been required
+const SCENARIOS: Record<string, string> = {
+  'require only': '',
+  version: `core.getFfiLib('error').pactffiVersion();`,
+  verifier: `
+    const ffi = core.getFfiLib('error');
+    ffi.pactffiVerifierShutdown(
+      ffi.pactffiVerifierNewForApplication('pact-js-bench', '1.0.0'),
+    );`,
+  consumer: `
+    // 5 is SPECIFICATION_VERSION_V4
+    const pact = core.makeConsumerPact('bench-consumer', 'bench-provider', 5, 'error');
+    pact.newInteraction('a request').withRequest('GET', '/');
+    pact.dispose();`,
+};
+
+const child = (scenario: string) => `
+const start = process.hrtime.bigint();
+const core = require(${JSON.stringify(DIST)});
+const required = process.hrtime.bigint();
+${scenario}
+const done = process.hrtime.bigint();
+console.log(JSON.stringify({
+  requireMs: Number(required - start) / 1e6,
+  firstCallMs: Number(done - required) / 1e6,
+  totalMs: Number(done - start) / 1e6,
+}));
+`;
+
+type Run = { requireMs: number; firstCallMs: number; totalMs: number };
+
+type Mode = 'lazy' | 'eager';
+
+const MODES: Mode[] = ['lazy', 'eager'];
+
+const run = (scenario: string, mode: Mode): Run =>
+  JSON.parse(
+    execFileSync(process.execPath, ['-e', child(scenario)], {
+      env: {
+        ...process.env,
+        LOG_LEVEL: 'error',
+        PACT_EAGER_EXPORT_GROUPS: mode === 'eager' ? '1' : '',
+      },
+    }).toString(),
+  );
+
+describe('startup', () => {
+  it(
+    'measures require to first call time',
+    () => {
+      if (!fs.existsSync(DIST)) {
+        throw new Error(`${DIST} not found, run \`npm run build\` first`);
+      }
+
+      const results = Object.entries(SCENARIOS).flatMap(([name, scenario]) =>
+        MODES.map((mode) => {
+          // The first run warms the OS file cache, so isn't counted
+          run(scenario, mode);
+          const runs = Array.from({ length: RUNS }, () => run(scenario, mode));
+          return {
+            scenario: name,
+            mode,
+            requireMs: summarise(runs.map((r) => r.requireMs)),
+            firstCallMs: summarise(runs.map((r) => r.firstCallMs)),
+            totalMs: summarise(runs.map((r) => r.totalMs)),
+          };
+        }),
+      );
+
+      for (const name of Object.keys(SCENARIOS)) {
+        const [lazy, eager] = MODES.map(
+          (mode) =>
+            results.find((r) => r.scenario === name && r.mode === mode)
+              ?.totalMs.p50Ms ?? 0,
+        );
+        console.log(
+          `${name}: ${lazy?.toFixed(1)}ms lazy, ${eager?.toFixed(1)}ms eager (p50 total)`,
+        );
+      }
+
+      const file = writeResults('startup', results);
+      console.log(`startup results written to ${file}`);
+    },
+    10 * 60 * 1000,
+  );
+});
@@ -0,0 +1,84 @@
+import * as fs from 'node:fs';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { getFfiLib } from '../src/ffi';
+
+export const HOST = '127.0.0.1';
+
+export const RESULTS_DIR = path.resolve(__dirname, 'results');
+
+export type LatencySummary = {
+  count: number;
+  meanMs: number;
+  p50Ms: number;
+  p99Ms: number;
+  p999Ms: number;
+  maxMs: number;
+};
+
+/**
+ * Reads a numeric harness setting from the environment, e.g. BENCH_DURATION_MS
+ */
+export const envNumber = (name: string, fallback: number): number => {
+  const value = process.env[name];
+  return value ? Number(value) : fallback;
+};
+
+/**
+ * Reads a comma separated list of numbers from the environment, e.g.
+ * BENCH_CONCURRENCY=1,8,32
+ */
+export const envNumbers = (name: string, fallback: number[]): number[] => {
+  const value = process.env[name];
+  return value ? value.split(',').map(Number) : fallback;
+};
+
+export const nowNs = (): bigint => process.hrtime.bigint();
+
+export const elapsedMs = (start: bigint): number =>
+  Number(process.hrtime.bigint() - start) / 1e6;
+
+export const percentile = (sorted: number[], p: number): number =>
+  sorted.length === 0
+    ? 0
+    : (sorted[Math.min(sorted.length - 1, Math.ceil(p * sorted.length) - 1)] ??
+      0);
+
+export const summarise = (latenciesMs: number[]): LatencySummary => {
+  const sorted = [...latenciesMs].sort((a, b) => a - b);
+  const total = sorted.reduce((sum, latency) => sum + latency, 0);
+  return {
+    count: sorted.length,
+    meanMs: sorted.length ? total / sorted.length : 0,
+    p50Ms: percentile(sorted, 0.5),
+    p99Ms: percentile(sorted, 0.99),
+    p999Ms: percentile(sorted, 0.999),
+    maxMs: sorted[sorted.length - 1] ?? 0,
+  };
+};
+
+/**
+ * Writes a harness's results to bench/results/<name>.json, along with what
+ * they were measured on, so runs can be compared over time.
+ */
+export const writeResults = (name: string, results: unknown): string => {
+  fs.mkdirSync(RESULTS_DIR, { recursive: true });
+  const file = path.join(RESULTS_DIR, `${name}.json`);
+  fs.writeFileSync(
+    file,
+    JSON.stringify(
+      {
+        name,
+        timestamp: new Date().toISOString(),
+        node: process.version,
+        platform: `${process.platform}-${process.arch}`,
+        cpus: os.cpus().length,
+        pactFfiVersion: getFfiLib('error').pactffiVersion(),
+        results,
+      },
+      null,
+      2,
+    ),
+  );
+  return file;
+};
@@ -0,0 +1,245 @@
+import * as fs from 'node:fs';
+import * as http from 'node:http';
+import type { AddressInfo } from 'node:net';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { getFfiLib } from '../src/ffi';
+import {
+  elapsedMs,
+  envNumber,
+  envNumbers,
+  HOST,
+  nowNs,
+  writeResults,
+} from './utils';
+
+// How verification time scales with interaction count, provider latency and
+// provider state setup cost. Synthetic pact files are generated into a temp
+// directory, served with pactffiVerifierAddDirectorySource, and verified
+// against a local provider stand-in whose response and state change latency
+// are configurable. No broker or network access is needed, so runs are
+// reproducible offline.
+//
+//   npm run bench:verifier
+//
+// BENCH_INTERACTIONS, BENCH_PROVIDER_LATENCY_MS, BENCH_STATE_LATENCY_MS and
+// BENCH_SLOW_MAX_INTERACTIONS override the defaults below.
+
+const INTERACTIONS = envNumbers(
+  'BENCH_INTERACTIONS',
+  [10, 100, 1000, 10000, 50000],
+);
+const PROVIDER_LATENCY_MS = envNumbers('BENCH_PROVIDER_LATENCY_MS', [0, 5]);
+const STATE_LATENCY_MS = envNumbers('BENCH_STATE_LATENCY_MS', [0, 5]);
+// Verification is sequential, so latency runs are capped to keep the suite
+// to minutes rather than hours
+const SLOW_MAX_INTERACTIONS = envNumber('BENCH_SLOW_MAX_INTERACTIONS', 1000);
+const INTERACTIONS_PER_FILE = 1000;
+
+const ffi = getFfiLib('error');
+
+type Provider = {
+  port: number;
+  requests: number;
+  stateChanges: number;
+  handlerMs: number;
+  stateMs: number;
+  reset: (latencyMs: number, stateLatencyMs: number) => void;
+  close: () => Promise<void>;
+};
+
+const sleep = (ms: number) =>
+  ms > 0 ? new Promise((resolve) => setTimeout(resolve, ms)) : undefined;
+
+// Answers every /items/:id request the generated pacts expect, and every
+// provider state change, after a configurable delay
+const startProvider = async (): Promise<Provider> => {
+  let latencyMs = 0;
+  let stateLatencyMs = 0;
+
+  const provider: Provider = {
+    port: 0,
+    requests: 0,
+    stateChanges: 0,
+    handlerMs: 0,
+    stateMs: 0,
+    reset: (latency, stateLatency) => {
+      latencyMs = latency;
+      stateLatencyMs = stateLatency;
+      provider.requests = 0;
+      provider.stateChanges = 0;
+      provider.handlerMs = 0;
+      provider.stateMs = 0;
+    },
+    close: () => new Promise((resolve) => server.close(() => resolve())),
+  };
+
+  const server = http.createServer(async (req, res) => {
+    const start = nowNs();
+    const body: Buffer[] = [];
+    for await (const chunk of req) {
+      body.push(chunk as Buffer);
+    }
+
+    if (req.url === '/_pactState') {
+      await sleep(stateLatencyMs);
+      res.writeHead(200, { 'Content-Type': 'application/json' });
+      res.end('{}');
+      provider.stateChanges += 1;
+      provider.stateMs += elapsedMs(start);
+      return;
+    }
+
+    await sleep(latencyMs);
+    const id = Number(req.url?.split('/')[2]);
+    res.writeHead(200, { 'Content-Type': 'application/json' });
+    res.end(JSON.stringify({ id, name: `item ${id}` }));
+    provider.requests += 1;
+    provider.handlerMs += elapsedMs(start);
+  });
+
+  await new Promise<void>((resolve) => server.listen(0, HOST, resolve));
+  provider.port = (server.address() as AddressInfo).port;
+  return provider;
+};
+
+// Writes `interactions` interactions across files of at most
+// INTERACTIONS_PER_FILE, one consumer per file
+const generatePacts = (interactions: number): string => {
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'pact-bench-verifier-'));
+
+  for (let file = 0; file * INTERACTIONS_PER_FILE < interactions; file += 1) {
+    const first = file * INTERACTIONS_PER_FILE;
+    const count = Math.min(INTERACTIONS_PER_FILE, interactions - first);
+    const pact = {
+      consumer: { name: `bench-consumer-${file}` },
+      provider: { name: 'bench-provider' },
+      interactions: Array.from({ length: count }, (_, i) => {
+        const id = first + i;
+        return {
+          description: `a request for item ${id}`,
+          providerStates: [{ name: 'an item exists', params: { id } }],
+          request: { method: 'GET', path: `/items/${id}` },
+          response: {
+            status: 200,
+            headers: { 'Content-Type': 'application/json' },
+            body: { id, name: `item ${id}` },
+          },
+        };
+      }),
+      metadata: { pactSpecification: { version: '3.0.0' } },
+    };
+    fs.writeFileSync(
+      path.join(dir, `bench-consumer-${file}-bench-provider.json`),
+      JSON.stringify(pact),
+    );
+  }
+
+  return dir;
+};
+
+const execute = (handle: number) =>
+  new Promise<number>((resolve, reject) => {
+    ffi.pactffiVerifierExecute(handle, (err: Error, res: number) =>
+      err ? reject(err) : resolve(res),
+    );
+  });
+
+const verify = async (
+  provider: Provider,
+  interactions: number,
+  latencyMs: number,
+  stateLatencyMs: number,
+) => {
+  let start = nowNs();
+  const dir = generatePacts(interactions);
+  const generateMs = elapsedMs(start);
+
+  provider.reset(latencyMs, stateLatencyMs);
+
+  start = nowNs();
+  const handle = ffi.pactffiVerifierNewForApplication('pact-js-bench', '1.0.0');
+  ffi.pactffiVerifierSetProviderInfo(
+    handle,
+    'bench-provider',
+    'http',
+    HOST,
+    provider.port,
+    '/',
+  );
+  ffi.pactffiVerifierSetProviderState(
+    handle,
+    `http://${HOST}:${provider.port}/_pactState`,
+    false,
+    true,
+  );
+  ffi.pactffiVerifierAddDirectorySource(handle, dir);
+  const setupMs = elapsedMs(start);
+
+  start = nowNs();
+  const result = await execute(handle);
+  const executeMs = elapsedMs(start);
+
+  start = nowNs();
+  const json = ffi.pactffiVerifierJson(handle);
+  ffi.pactffiVerifierShutdown(handle);
+  const resultsMs = elapsedMs(start);
+
+  fs.rmSync(dir, { recursive: true, force: true });
+
+  return {
+    interactions,
+    providerLatencyMs: latencyMs,
+    stateLatencyMs,
+    result,
+    requests: provider.requests,
+    stateChanges: provider.stateChanges,
+    phases: {
+      generateMs,
+      setupMs,
+      executeMs,
+      // executeMs split by where the time went, as seen by the provider
+      providerMs: provider.handlerMs,
+      stateChangeMs: provider.stateMs,
+      coreMs: executeMs - provider.handlerMs - provider.stateMs,
+      resultsMs,
+    },
+    resultJsonBytes: json?.length ?? 0,
+    interactionsPerSec: (interactions / executeMs) * 1000,
+  };
+};
+
+describe('verification throughput', () => {
+  let provider: Provider;
+
+  beforeAll(async () => {
+    provider = await startProvider();
+  });
+
+  afterAll(() => provider.close());
+
+  it(
+    'measures verification time by interaction count and latency',
+    async () => {
+      const results: unknown[] = [];
+
+      for (const interactions of INTERACTIONS) {
+        for (const latencyMs of PROVIDER_LATENCY_MS) {
+          for (const stateLatencyMs of STATE_LATENCY_MS) {
+            const slow = latencyMs > 0 || stateLatencyMs > 0;
+            if (slow && interactions > SLOW_MAX_INTERACTIONS) {
+              continue;
+            }
+            results.push(
+              await verify(provider, interactions, latencyMs, stateLatencyMs),
+            );
+          }
+        }
+      }
+
+      const file = writeResults('verifier', results);
+      console.log(`verifier results written to ${file}`);
+    },
+    4 * 60 * 60 * 1000,
+  );
+});
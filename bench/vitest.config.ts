@@ -0,0 +1,16 @@
+import { defineConfig } from 'vitest/config';
+
+// Benchmarks and harnesses need a locally built addon (see bench/README.md),
+// so they are kept out of the default `npm test` run. Harnesses are long
+// running tests that write their results to bench/results.
+export default defineConfig({
+  test: {
+    globals: true,
+    pool: 'forks',
+    include: ['bench/**/*.harness.ts'],
+    sequence: { concurrent: false },
+    benchmark: {
+      include: ['bench/**/*.bench.ts'],
+    },
+  },
+});
@@ -1,7 +1,50 @@
 {
     "variables": {
-        "is_alpine": "<!(grep -q Alpine /etc/os-release && echo true || echo false)"
+        "is_alpine": "<!(grep -q Alpine /etc/os-release && echo true || echo false)",
+        # Set PACT_BUILD_BENCH=true to also build the pact_ffi_bench baseline (see bench/README.md)
+        "build_bench": "<!(node -p \"process.env.PACT_BUILD_BENCH === 'true'\")"
     },
+    "conditions": [
+        [
+            "build_bench==\"true\"",
+            {
+                "targets": [
+                    {
+                        "target_name": "pact_ffi_bench",
+                        "type": "executable",
+                        "dependencies": ["pact"],
+                        "sources": [
+                            "native/bench/ffi_bench.cc"
+                        ],
+                        "includes": ["native/pact_ffi.gypi"],
+                        "include_dirs": [
+                            "<(module_root_dir)/native",
+                            "<(module_root_dir)/ffi",
+                        ],
+                        "cflags_cc": ["-Werror", "-O2"],
+                        "conditions": [
+                            [
+                                "OS==\"mac\"",
+                                {
+                                    "xcode_settings": {
+                                        "GCC_TREAT_WARNINGS_AS_ERRORS": "YES",
+                                        "CLANG_CXX_LIBRARY": "libc++",
+                                        "MACOSX_DEPLOYMENT_TARGET": "10.7"
+                                    },
+                                    "postbuilds": [
+                                        {
+                                            "postbuild_name": "modify install_name on osx",
+                                            "action": ["install_name_tool", "-change", "libpact_ffi.dylib", "@rpath/libpact_ffi.dylib", "${BUILT_PRODUCTS_DIR}/${EXECUTABLE_PATH}"]
+                                        }
+                                    ]
+                                }
+                            ]
+                        ]
+                    }
+                ]
+            }
+        ]
+    ],
     "targets": [
         {
             "target_name": "pact",
@@ -10,8 +53,23 @@
                 "native/ffi.cc",
                 "native/consumer.cc",
                 "native/provider.cc",
-                "native/plugin.cc"
+                "native/plugin.cc",
+                "native/logs.cc",
+                "native/stats.cc",
+                "native/watchdog.cc",
+                "native/trace.cc",
+                "native/ownership.cc",
+                "native/aggregator.cc",
+                "native/marshal.cc",
+                "native/json.cc",
+                "native/journal.cc",
+                "native/mapped_file.cc",
+                "native/import.cc",
+                "native/snapshot.cc",
+                "native/in_process.cc",
+                "native/matchers.cc"
             ],
+            "includes": ["native/pact_ffi.gypi"],
             "include_dirs": [
                 "<!(node -p \"require('node-addon-api').include_dir\")",
                 "<(module_root_dir)/native",
@@ -21,15 +79,17 @@
                 [
                     "OS=='win'",
                     {
-                        "libraries": [
-                            "<(module_root_dir)/ffi/windows-x86_64/pact_ffi.dll.lib"
-                        ],
                         "defines": [
                             "_HAS_EXCEPTIONS=1"
                         ],
                         "msvs_settings": {
                             "VCCLCompilerTool": {
                                 "ExceptionHandling": 1
+                            },
+                            # Load pact_ffi.dll on the first call into it rather than with the addon
+                            "VCLinkerTool": {
+                                "DelayLoadDLLs": ["pact_ffi.dll"],
+                                "AdditionalDependencies": ["delayimp.lib"]
                             }
                         },
                         "copies": [{
@@ -48,13 +108,6 @@
                             "CLANG_CXX_LIBRARY": "libc++",
                             "MACOSX_DEPLOYMENT_TARGET": "10.7"
                         },
-                        "link_settings": {
-                            "libraries": [
-                                "-lpact_ffi",
-                                "-L<(module_root_dir)/ffi",
-                                "-Wl,-rpath,@loader_path"
-                            ]
-                        },
                         "copies": [{
                             "files": ["<(module_root_dir)/ffi/macos-x86_64/libpact_ffi.dylib"],
                             "destination": "<(PRODUCT_DIR)"
@@ -71,13 +124,6 @@
                             "CLANG_CXX_LIBRARY": "libc++",
                             "MACOSX_DEPLOYMENT_TARGET": "10.7"
                         },
-                        "link_settings": {
-                            "libraries": [
-                                "-lpact_ffi",
-                                "-L<(module_root_dir)/ffi",
-                                "-Wl,-rpath,@loader_path"
-                            ]
-                        },
                         "copies": [{
                             "files": ["<(module_root_dir)/ffi/macos-aarch64/libpact_ffi.dylib"],
                             "destination": "<(PRODUCT_DIR)"
@@ -87,13 +133,6 @@
                 [
                     "OS==\"linux\" and target_arch ==\"x64\" and is_alpine ==\"true\"",
                     {
-                        "link_settings": {
-                            "libraries": [
-                                "-lpact_ffi_musl",
-                                "-L<(module_root_dir)/ffi/linux-musl-x86_64/",
-                                "-Wl,-rpath,'$$ORIGIN'"
-                            ]
-                        },
                         "copies": [{
                             "files": ["<(module_root_dir)/ffi/linux-musl-x86_64/libpact_ffi_musl.so"],
                             "destination": "<(PRODUCT_DIR)"
@@ -103,13 +142,6 @@
                 [
                     "OS==\"linux\" and target_arch ==\"arm64\" and is_alpine ==\"true\"",
                     {
-                        "link_settings": {
-                            "libraries": [
-                                "-lpact_ffi_musl",
-                                "-L<(module_root_dir)/ffi/linux-musl-aarch64/",
-                                "-Wl,-rpath,'$$ORIGIN'"
-                            ]
-                        },
                         "copies": [{
                             "files": ["<(module_root_dir)/ffi/linux-musl-aarch64/libpact_ffi_musl.so"],
                             "destination": "<(PRODUCT_DIR)"
@@ -119,13 +151,6 @@
                 [
                     "OS==\"linux\" and target_arch ==\"x64\" and is_alpine ==\"false\"",
                     {
-                        "link_settings": {
-                            "libraries": [
-                                "-lpact_ffi",
-                                "-L<(module_root_dir)/ffi/linux-x86_64/",
-                                "-Wl,-rpath,'$$ORIGIN'"
-                            ]
-                        },
                         "copies": [{
                             "files": ["<(module_root_dir)/ffi/linux-x86_64/libpact_ffi.so"],
                             "destination": "<(PRODUCT_DIR)"
@@ -135,13 +160,6 @@
                 [
                     "OS==\"linux\" and target_arch ==\"arm64\" and is_alpine ==\"false\"",
                     {
-                        "link_settings": {
-                            "libraries": [
-                                "-lpact_ffi",
-                                "-L<(module_root_dir)/ffi/linux-aarch64",
-                                "-Wl,-rpath,'$$ORIGIN'"
-                            ]
-                        },
                         "copies": [{
                             "files": ["<(module_root_dir)/ffi/linux-aarch64/libpact_ffi.so"],
                             "destination": "<(PRODUCT_DIR)"
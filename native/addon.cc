@@ -1,92 +1,240 @@
 #include <napi.h>
+#include "addon.h"
 #include "ffi.h"
 #include "consumer.h"
 #include "provider.h"
 #include "plugin.h"
+#include "logs.h"
+#include "aggregator.h"
+#include "import.h"
+#include "snapshot.h"
+#include "in_process.h"
+#include "matchers.h"
+#include "stats.h"
+#include "watchdog.h"
+#include "trace.h"
 
-Napi::Object Init(Napi::Env env, Napi::Object exports) {
-  exports.Set(Napi::String::New(env, "pactffiVersion"), Napi::Function::New(env, PactffiVersion));
-  exports.Set(Napi::String::New(env, "pactffiInit"), Napi::Function::New(env, PactffiInit));
-  exports.Set(Napi::String::New(env, "pactffiInitWithLogLevel"), Napi::Function::New(env, PactffiInitWithLogLevel));
-  exports.Set(Napi::String::New(env, "pactffiLogToFile"), Napi::Function::New(env, PactffiLogToFile));
-
-  // Consumer
-  exports.Set(Napi::String::New(env, "pactffiMockServerMatched"), Napi::Function::New(env, PactffiMockServerMatched));
-  exports.Set(Napi::String::New(env, "pactffiMockServerMismatches"), Napi::Function::New(env, PactffiMockServerMismatches));
-  exports.Set(Napi::String::New(env, "pactffiCreateMockServerForTransport"), Napi::Function::New(env, PactffiCreateMockServerForTransport));
-  exports.Set(Napi::String::New(env, "pactffiCleanupMockServer"), Napi::Function::New(env, PactffiCleanupMockServer));
-  exports.Set(Napi::String::New(env, "pactffiGetTlsCaCertificate"), Napi::Function::New(env, PactffiGetTlsCaCertificate));
-  exports.Set(Napi::String::New(env, "pactffiWritePactFile"), Napi::Function::New(env, PactffiWritePactFile));
-  exports.Set(Napi::String::New(env, "pactffiWritePactFileByPort"), Napi::Function::New(env, PactffiWritePactFileByPort));
-  exports.Set(Napi::String::New(env, "pactffiNewPact"), Napi::Function::New(env, PactffiNewPact));
-  exports.Set(Napi::String::New(env, "pactffiNewInteraction"), Napi::Function::New(env, PactffiNewInteraction));
-  exports.Set(Napi::String::New(env, "pactffiUponReceiving"), Napi::Function::New(env, PactffiUponReceiving));
-  exports.Set(Napi::String::New(env, "pactffiGiven"), Napi::Function::New(env, PactffiGiven));
-  exports.Set(Napi::String::New(env, "pactffiGivenWithParam"), Napi::Function::New(env, PactffiGivenWithParam));
-  exports.Set(Napi::String::New(env, "pactffiGivenWithParams"), Napi::Function::New(env, PactffiGivenWithParams));
-  exports.Set(Napi::String::New(env, "pactffiSetPending"), Napi::Function::New(env, PactffiSetPending));
-  exports.Set(Napi::String::New(env, "pactffiSetKey"), Napi::Function::New(env, PactffiSetKey));
-  exports.Set(Napi::String::New(env, "pactffiSetComment"), Napi::Function::New(env, PactffiSetComment));
-  exports.Set(Napi::String::New(env, "pactffiAddTextComment"), Napi::Function::New(env, PactffiAddTextComment));
-  exports.Set(Napi::String::New(env, "pactffiAddInteractionReference"), Napi::Function::New(env, PactffiAddInteractionReference));
-  exports.Set(Napi::String::New(env, "pactffiInteractionTestName"), Napi::Function::New(env, PactffiInteractionTestName));
-  exports.Set(Napi::String::New(env, "pactffiWithRequest"), Napi::Function::New(env, PactffiWithRequest));
-  exports.Set(Napi::String::New(env, "pactffiWithQueryParameter"), Napi::Function::New(env, PactffiWithQueryParameter));
-  exports.Set(Napi::String::New(env, "pactffiWithSpecification"), Napi::Function::New(env, PactffiWithSpecification));
-  exports.Set(Napi::String::New(env, "pactffiWithPactMetadata"), Napi::Function::New(env, PactffiWithPactMetadata));
-  exports.Set(Napi::String::New(env, "pactffiWithHeader"), Napi::Function::New(env, PactffiWithHeader));
-  exports.Set(Napi::String::New(env, "pactffiWithBody"), Napi::Function::New(env, PactffiWithBody));
-  exports.Set(Napi::String::New(env, "pactffiWithBinaryFile"), Napi::Function::New(env, PactffiWithBinaryFile));
-  exports.Set(Napi::String::New(env, "pactffiWithMatchingRules"), Napi::Function::New(env, PactffiWithMatchingRules));
-  exports.Set(Napi::String::New(env, "pactffiWithMultipartFile"), Napi::Function::New(env, PactffiWithMultipartFile));
-  exports.Set(Napi::String::New(env, "pactffiResponseStatus"), Napi::Function::New(env, PactffiResponseStatus));
-  exports.Set(Napi::String::New(env, "pactffiUsingPlugin"), Napi::Function::New(env, PactffiUsingPlugin));
-  exports.Set(Napi::String::New(env, "pactffiUsingPluginWithDelay"), Napi::Function::New(env, PactffiUsingPluginWithDelay));
-  exports.Set(Napi::String::New(env, "pactffiSetTestRunId"), Napi::Function::New(env, PactffiSetTestRunId));
-  exports.Set(Napi::String::New(env, "pactffiCleanupPlugins"), Napi::Function::New(env, PactffiCleanupPlugins));
-  exports.Set(Napi::String::New(env, "pactffiPluginInteractionContents"), Napi::Function::New(env, PactffiPluginInteractionContents));
-
-  // exports.Set(Napi::String::New(env, "pactffiNewMessagePact"), Napi::Function::New(env, PactffiNewMessagePact));
-  // exports.Set(Napi::String::New(env, "pactffiWriteMessagePactFile"), Napi::Function::New(env, PactffiWriteMessagePactFile));
-  // exports.Set(Napi::String::New(env, "pactffiWithMessagePactMetadata"), Napi::Function::New(env, PactffiWithMessagePactMetadata));
-  exports.Set(Napi::String::New(env, "pactffiNewAsyncMessage"), Napi::Function::New(env, PactffiNewAsyncMessage));
-  exports.Set(Napi::String::New(env, "pactffiNewSyncMessage"), Napi::Function::New(env, PactffiNewSyncMessage));
-  // exports.Set(Napi::String::New(env, "pactffiSyncMessageSetDescription"), Napi::Function::New(env, PactffiSyncMessageSetDescription));
-  // exports.Set(Napi::String::New(env, "pactffiNewMessage"), Napi::Function::New(env, PactffiNewMessage));
-  exports.Set(Napi::String::New(env, "pactffiMessageReify"), Napi::Function::New(env, PactffiMessageReify));
-  exports.Set(Napi::String::New(env, "pactffiMessageGiven"), Napi::Function::New(env, PactffiMessageGiven));
-  exports.Set(Napi::String::New(env, "pactffiMessageGivenWithParam"), Napi::Function::New(env, PactffiMessageGivenWithParam));
-  exports.Set(Napi::String::New(env, "pactffiMessageGivenWithParams"), Napi::Function::New(env, PactffiGivenWithParams));
-  exports.Set(Napi::String::New(env, "pactffiMessageWithBinaryContents"), Napi::Function::New(env, PactffiMessageWithBinaryContents));
-  exports.Set(Napi::String::New(env, "pactffiMessageWithContents"), Napi::Function::New(env, PactffiMessageWithContents));
-  exports.Set(Napi::String::New(env, "pactffiMessageWithMetadata"), Napi::Function::New(env, PactffiMessageWithMetadata));
-  exports.Set(Napi::String::New(env, "pactffiMessageExpectsToReceive"), Napi::Function::New(env, PactffiMessageExpectsToReceive));
-  exports.Set(Napi::String::New(env, "pactffiGetAsyncMessageRequestContents"), Napi::Function::New(env, PactffiGetAsyncMessageRequestContents));
-  exports.Set(Napi::String::New(env, "pactffiGetSyncMessageRequestContents"), Napi::Function::New(env, PactffiGetSyncMessageRequestContents));
-  exports.Set(Napi::String::New(env, "pactffiGetSyncMessageResponseContents"), Napi::Function::New(env, PactffiGetSyncMessageResponseContents));
-
-  // Provider
-  exports.Set(Napi::String::New(env, "pactffiVerifierNewForApplication"), Napi::Function::New(env, PactffiVerifierNewForApplication));
-  exports.Set(Napi::String::New(env, "pactffiVerifierSetVerificationOptions"), Napi::Function::New(env, PactffiVerifierSetVerificationOptions));
-  exports.Set(Napi::String::New(env, "pactffiVerifierSetPublishOptions"), Napi::Function::New(env, PactffiVerifierSetPublishOptions));
-  exports.Set(Napi::String::New(env, "pactffiVerifierExecute"), Napi::Function::New(env, PactffiVerifierExecute));
-  exports.Set(Napi::String::New(env, "pactffiVerifierShutdown"), Napi::Function::New(env, PactffiVerifierShutdown));
-  exports.Set(Napi::String::New(env, "pactffiVerifierSetProviderInfo"), Napi::Function::New(env, PactffiVerifierSetProviderInfo));
-  exports.Set(Napi::String::New(env, "pactffiVerifierSetFilterInfo"), Napi::Function::New(env, PactffiVerifierSetFilterInfo));
-  exports.Set(Napi::String::New(env, "pactffiVerifierSetProviderState"), Napi::Function::New(env, PactffiVerifierSetProviderState));
-  exports.Set(Napi::String::New(env, "pactffiVerifierSetConsumerFilters"), Napi::Function::New(env, PactffiVerifierSetConsumerFilters));
-  exports.Set(Napi::String::New(env, "pactffiVerifierSetFailIfNoPactsFound"), Napi::Function::New(env, PactffiVerifierSetFailIfNoPactsFound));
-  exports.Set(Napi::String::New(env, "pactffiVerifierAddCustomHeader"), Napi::Function::New(env, PactffiVerifierAddCustomHeader));
-  exports.Set(Napi::String::New(env, "pactffiVerifierAddFileSource"), Napi::Function::New(env, PactffiVerifierAddFileSource));
-  exports.Set(Napi::String::New(env, "pactffiVerifierAddDirectorySource"), Napi::Function::New(env, PactffiVerifierAddDirectorySource));
-  exports.Set(Napi::String::New(env, "pactffiVerifierUrlSource"), Napi::Function::New(env, PactffiVerifierUrlSource));
-  exports.Set(Napi::String::New(env, "pactffiVerifierBrokerSourceWithSelectors"), Napi::Function::New(env, PactffiVerifierBrokerSourceWithSelectors));
-  exports.Set(Napi::String::New(env, "pactffiVerifierAddProviderTransport"), Napi::Function::New(env, PactffiVerifierAddProviderTransport));
-  exports.Set(Napi::String::New(env, "pactffiVerifierSetNoPactsIsError"), Napi::Function::New(env, PactffiVerifierSetNoPactsIsError));
-  exports.Set(Napi::String::New(env, "pactffiVerifierSetFollowRedirects"), Napi::Function::New(env, PactffiVerifierSetFollowRedirects));
-  exports.Set(Napi::String::New(env, "pactffiVerifierJson"), Napi::Function::New(env, PactffiVerifierJson));
-
-  return exports;
+struct ExportEntry {
+  const char* name;
+  Napi::Value (*callback)(const Napi::CallbackInfo&);
+  ExportSubject subject = SUBJECT_NONE;
+};
+
+// Registered when the addon loads: version, logging and the diagnostics every caller may need
+static const ExportEntry coreExports[] = {
+  {"pactffiVersion", PactffiVersion},
+  {"pactffiInit", PactffiInit},
+  {"pactffiInitWithLogLevel", PactffiInitWithLogLevel},
+  {"pactffiLogToFile", PactffiLogToFile},
+  {"pactffiLogToStdout", PactffiLogToStdout},
+  {"pactffiLogToStderr", PactffiLogToStderr},
+  {"pactffiLogToBuffer", PactffiLogToBuffer},
+  {"pactffiLogToSinks", PactffiLogToSinks},
+  {"pactffiFetchLogBuffer", PactffiFetchLogBuffer},
+  {"pactffiEnableStats", PactffiEnableStats},
+  {"pactffiStats", PactffiStats},
+  {"pactffiAllocatorStats", PactffiAllocatorStats},
+  {"pactffiEnableWatchdog", PactffiEnableWatchdog},
+  {"pactffiWatchdogOffenders", PactffiWatchdogOffenders},
+  {"pactffiEnableTrace", PactffiEnableTrace},
+  {"pactffiWriteTrace", PactffiWriteTrace},
+};
+
+// The rest are only registered when first used (see `pactffiLoadExportGroup`), so a process that
+// only verifies doesn't create the consumer's function objects, and vice versa
+static const ExportEntry consumerExports[] = {
+  {"pactffiEnableTestLogs", PactffiEnableTestLogs},
+  {"pactffiFetchTestLogs", PactffiFetchTestLogs},
+  {"pactffiDiscardTestLogs", PactffiDiscardTestLogs},
+  {"pactffiMockServerMatched", PactffiMockServerMatched, SUBJECT_PORT},
+  {"pactffiMockServerMismatches", PactffiMockServerMismatches, SUBJECT_PORT},
+  {"pactffiCreateMockServerForTransport", PactffiCreateMockServerForTransport, SUBJECT_PACT},
+  {"pactffiCleanupMockServer", PactffiCleanupMockServer, SUBJECT_PORT},
+  {"pactffiGetTlsCaCertificate", PactffiGetTlsCaCertificate},
+  {"pactffiWritePactFile", PactffiWritePactFile, SUBJECT_PACT},
+  {"pactffiWritePactFileByPort", PactffiWritePactFileByPort, SUBJECT_PORT},
+  {"pactffiNewPact", PactffiNewPact},
+  {"pactffiFreePactHandle", PactffiFreePactHandle, SUBJECT_PACT},
+  {"pactffiAcquireSharedPact", PactffiAcquireSharedPact},
+  {"pactffiReleaseSharedPact", PactffiReleaseSharedPact, SUBJECT_PACT},
+  {"pactffiImportPact", PactffiImportPact},
+  {"pactffiEnableJournal", PactffiEnableJournal, SUBJECT_PACT},
+  {"pactffiSnapshotPact", PactffiSnapshotPact, SUBJECT_PACT},
+  {"pactffiRestorePact", PactffiRestorePact},
+  {"pactffiInProcessPort", PactffiInProcessPort, SUBJECT_PACT},
+  {"pactffiInProcessMatched", PactffiInProcessMatched, SUBJECT_PACT},
+  {"pactffiInProcessMismatches", PactffiInProcessMismatches, SUBJECT_PACT},
+  {"pactffiMatchValues", PactffiMatchValues},
+  {"pactffiNewInteraction", PactffiNewInteraction, SUBJECT_PACT},
+  {"pactffiCloneInteraction", PactffiCloneInteraction, SUBJECT_INTERACTION},
+  {"pactffiUponReceiving", PactffiUponReceiving, SUBJECT_INTERACTION},
+  {"pactffiGiven", PactffiGiven, SUBJECT_INTERACTION},
+  {"pactffiGivenWithParam", PactffiGivenWithParam, SUBJECT_INTERACTION},
+  {"pactffiGivenWithParams", PactffiGivenWithParams, SUBJECT_INTERACTION},
+  {"pactffiSetPending", PactffiSetPending, SUBJECT_INTERACTION},
+  {"pactffiSetKey", PactffiSetKey, SUBJECT_INTERACTION},
+  {"pactffiSetComment", PactffiSetComment, SUBJECT_INTERACTION},
+  {"pactffiAddTextComment", PactffiAddTextComment, SUBJECT_INTERACTION},
+  {"pactffiAddInteractionReference", PactffiAddInteractionReference, SUBJECT_INTERACTION},
+  {"pactffiInteractionTestName", PactffiInteractionTestName, SUBJECT_INTERACTION},
+  {"pactffiWithRequest", PactffiWithRequest, SUBJECT_INTERACTION},
+  {"pactffiWithQueryParameter", PactffiWithQueryParameter, SUBJECT_INTERACTION},
+  {"pactffiWithQueryParameters", PactffiWithQueryParameters, SUBJECT_INTERACTION},
+  {"pactffiWithSpecification", PactffiWithSpecification, SUBJECT_PACT},
+  {"pactffiWithPactMetadata", PactffiWithPactMetadata, SUBJECT_PACT},
+  {"pactffiWithHeader", PactffiWithHeader, SUBJECT_INTERACTION},
+  {"pactffiWithHeaders", PactffiWithHeaders, SUBJECT_INTERACTION},
+  {"pactffiWithBody", PactffiWithBody, SUBJECT_INTERACTION},
+  {"pactffiWithBinaryFile", PactffiWithBinaryFile, SUBJECT_INTERACTION},
+  {"pactffiWithBinaryFilePath", PactffiWithBinaryFilePath, SUBJECT_INTERACTION},
+  {"pactffiWithMatchingRules", PactffiWithMatchingRules, SUBJECT_INTERACTION},
+  {"pactffiWithMultipartFile", PactffiWithMultipartFile, SUBJECT_INTERACTION},
+  {"pactffiWithMultipartParts", PactffiWithMultipartParts, SUBJECT_INTERACTION},
+  {"pactffiResponseStatus", PactffiResponseStatus, SUBJECT_INTERACTION},
+  {"pactffiSetTestRunId", PactffiSetTestRunId},
+
+  // {"pactffiNewMessagePact", PactffiNewMessagePact, SUBJECT_PACT},
+  // {"pactffiWriteMessagePactFile", PactffiWriteMessagePactFile, SUBJECT_PACT},
+  // {"pactffiWithMessagePactMetadata", PactffiWithMessagePactMetadata, SUBJECT_PACT},
+  {"pactffiNewAsyncMessage", PactffiNewAsyncMessage, SUBJECT_PACT},
+  {"pactffiNewSyncMessage", PactffiNewSyncMessage, SUBJECT_PACT},
+  // {"pactffiSyncMessageSetDescription", PactffiSyncMessageSetDescription, SUBJECT_INTERACTION},
+  // {"pactffiNewMessage", PactffiNewMessage, SUBJECT_PACT},
+  {"pactffiMessageReify", PactffiMessageReify, SUBJECT_MESSAGE},
+  {"pactffiMessageGiven", PactffiMessageGiven, SUBJECT_MESSAGE},
+  {"pactffiMessageGivenWithParam", PactffiMessageGivenWithParam, SUBJECT_MESSAGE},
+  {"pactffiMessageGivenWithParams", PactffiGivenWithParams, SUBJECT_MESSAGE},
+  {"pactffiMessageWithBinaryContents", PactffiMessageWithBinaryContents, SUBJECT_MESSAGE},
+  {"pactffiMessageWithContents", PactffiMessageWithContents, SUBJECT_MESSAGE},
+  {"pactffiMessageWithMetadata", PactffiMessageWithMetadata, SUBJECT_MESSAGE},
+  {"pactffiMessageExpectsToReceive", PactffiMessageExpectsToReceive, SUBJECT_MESSAGE},
+  {"pactffiGetAsyncMessageRequestContents", PactffiGetAsyncMessageRequestContents, SUBJECT_PACT},
+  {"pactffiGetSyncMessageRequestContents", PactffiGetSyncMessageRequestContents, SUBJECT_PACT},
+  {"pactffiGetSyncMessageResponseContents", PactffiGetSyncMessageResponseContents, SUBJECT_PACT},
+};
+
+static const ExportEntry providerExports[] = {
+  {"pactffiVerifierNewForApplication", PactffiVerifierNewForApplication},
+  {"pactffiVerifierSetVerificationOptions", PactffiVerifierSetVerificationOptions, SUBJECT_VERIFIER},
+  {"pactffiVerifierSetPublishOptions", PactffiVerifierSetPublishOptions, SUBJECT_VERIFIER},
+  {"pactffiVerifierExecute", PactffiVerifierExecute, SUBJECT_VERIFIER},
+  {"pactffiVerifierShutdown", PactffiVerifierShutdown, SUBJECT_VERIFIER},
+  {"pactffiVerifierSetProviderInfo", PactffiVerifierSetProviderInfo, SUBJECT_VERIFIER},
+  {"pactffiVerifierSetFilterInfo", PactffiVerifierSetFilterInfo, SUBJECT_VERIFIER},
+  {"pactffiVerifierSetProviderState", PactffiVerifierSetProviderState, SUBJECT_VERIFIER},
+  {"pactffiVerifierSetConsumerFilters", PactffiVerifierSetConsumerFilters, SUBJECT_VERIFIER},
+  {"pactffiVerifierSetFailIfNoPactsFound", PactffiVerifierSetFailIfNoPactsFound, SUBJECT_VERIFIER},
+  {"pactffiVerifierAddCustomHeader", PactffiVerifierAddCustomHeader, SUBJECT_VERIFIER},
+  {"pactffiVerifierAddFileSource", PactffiVerifierAddFileSource, SUBJECT_VERIFIER},
+  {"pactffiVerifierAddDirectorySource", PactffiVerifierAddDirectorySource, SUBJECT_VERIFIER},
+  {"pactffiVerifierUrlSource", PactffiVerifierUrlSource, SUBJECT_VERIFIER},
+  {"pactffiVerifierBrokerSourceWithSelectors", PactffiVerifierBrokerSourceWithSelectors, SUBJECT_VERIFIER},
+  {"pactffiVerifierAddProviderTransport", PactffiVerifierAddProviderTransport, SUBJECT_VERIFIER},
+  {"pactffiVerifierSetNoPactsIsError", PactffiVerifierSetNoPactsIsError, SUBJECT_VERIFIER},
+  {"pactffiVerifierSetFollowRedirects", PactffiVerifierSetFollowRedirects, SUBJECT_VERIFIER},
+  {"pactffiVerifierJson", PactffiVerifierJson, SUBJECT_VERIFIER},
+};
+
+static const ExportEntry pluginExports[] = {
+  {"pactffiUsingPlugin", PactffiUsingPlugin, SUBJECT_PACT},
+  {"pactffiUsingPluginWithDelay", PactffiUsingPluginWithDelay, SUBJECT_PACT},
+  {"pactffiCleanupPlugins", PactffiCleanupPlugins, SUBJECT_PACT},
+  {"pactffiPluginInteractionContents", PactffiPluginInteractionContents, SUBJECT_INTERACTION},
+};
+
+struct ExportGroup {
+  const char* name;
+  const ExportEntry* entries;
+  size_t size;
+};
+
+#define EXPORT_GROUP(name, entries) {name, entries, sizeof(entries) / sizeof(entries[0])}
+
+static const ExportGroup deferredGroups[] = {
+  EXPORT_GROUP("consumer", consumerExports),
+  EXPORT_GROUP("provider", providerExports),
+  EXPORT_GROUP("plugin", pluginExports),
+};
+
+static void RegisterExports(Napi::Env env, Napi::Object exports, const ExportEntry* entries, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    ExportFunction(env, exports, entries[i].name, entries[i].callback, entries[i].subject);
+  }
+}
+
+/*
+ * Lists the names in each deferred export group, so the JS side can stand in for them until the
+ * group is loaded.
+ *
+ * C interface:
+ *
+ *    None, binding only
+ */
+static Napi::Value PactffiExportGroups(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object groups = Napi::Object::New(env);
+
+  for (const ExportGroup& group : deferredGroups) {
+    Napi::Array names = Napi::Array::New(env, group.size);
+    for (size_t i = 0; i < group.size; i++) {
+      names.Set(i, Napi::String::New(env, group.entries[i].name));
+    }
+    groups.Set(group.name, names);
+  }
+
+  return groups;
+}
+
+/*
+ * Registers a deferred export group (see `pactffiExportGroups`) on the addon's exports. Loading a
+ * group that is already loaded does nothing.
+ *
+ * C interface:
+ *
+ *    None, binding only
+ */
+static Napi::Value PactffiLoadExportGroup(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiLoadExportGroup received < 1 argument");
+  }
+
+  if (!info[0].IsString()) {
+    throw Napi::Error::New(env, "PactffiLoadExportGroup(arg 0) expected a string");
+  }
+
+  std::string name = info[0].As<Napi::String>().Utf8Value();
+  PactAddon* addon = PactAddon::From(env);
+
+  for (const ExportGroup& group : deferredGroups) {
+    if (name == group.name) {
+      if (addon->loadedGroups.insert(name).second) {
+        RegisterExports(env, addon->exports.Value(), group.entries, group.size);
+      }
+      return env.Undefined();
+    }
+  }
+
+  throw Napi::Error::New(env, "PactffiLoadExportGroup(arg 0) is not an export group");
+}
+
+PactAddon::PactAddon(Napi::Env env, Napi::Object exports) {
+  this->exports = Napi::Persistent(exports);
+
+  RegisterExports(env, exports, coreExports, sizeof(coreExports) / sizeof(coreExports[0]));
+  ExportFunction(env, exports, "pactffiExportGroups", PactffiExportGroups);
+  ExportFunction(env, exports, "pactffiLoadExportGroup", PactffiLoadExportGroup);
+}
+
+// Runs when the environment (e.g. a worker thread) is torn down
+PactAddon::~PactAddon() {
+  for (auto& verifier : verifiers.handles) {
+    // The worker thread may still be using it, so leak rather than free it from under it
+    if (verifiers.executing.count(verifier.first) == 0) {
+      pactffi_verifier_shutdown(verifier.second);
+    }
+  }
 }
 
-NODE_API_MODULE(pact, Init)
+NODE_API_ADDON(PactAddon)
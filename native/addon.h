@@ -0,0 +1,55 @@
+#pragma once
+
+#include <napi.h>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "pact-cpp.h"
+
+// Per environment state. Each main thread or worker thread that loads the addon gets its own
+// PactAddon, so handle tables and test log attribution in one worker never see another's. It is
+// only touched from its environment's JS thread, so needs no locking, and is destroyed when the
+// environment is torn down.
+
+struct VerifierTable {
+  std::map<int, VerifierHandle*> handles;
+  // Handles are erased on shutdown, so ids come from a counter rather than the map's size
+  int nextId = 0;
+  // Verifiers with a VerificationWorker in flight, which must not be shut down under it
+  std::set<int> executing;
+};
+
+struct TestLogBuffer {
+  std::string contents;
+  std::vector<int32_t> ports;
+};
+
+struct MockServerLogs {
+  std::string owner;
+  size_t offset;
+};
+
+struct TestLogsState {
+  bool enabled = false;
+  std::string activeTestRunId;
+  std::unordered_map<std::string, TestLogBuffer> testLogs;
+  std::unordered_map<int32_t, MockServerLogs> mockServerLogs;
+};
+
+class PactAddon : public Napi::Addon<PactAddon> {
+  public:
+    PactAddon(Napi::Env env, Napi::Object exports);
+    ~PactAddon();
+
+    static PactAddon* From(Napi::Env env) { return env.GetInstanceData<PactAddon>(); }
+
+    VerifierTable verifiers;
+    TestLogsState testLogs;
+    // FFI bytes held by mock servers started in this environment, by port (see ownership.h)
+    std::unordered_map<int32_t, size_t> mockServerExternalBytes;
+    // The addon's exports, which deferred export groups are registered on when first loaded
+    Napi::ObjectReference exports;
+    std::set<std::string> loadedGroups;
+};
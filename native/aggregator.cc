@@ -0,0 +1,238 @@
+#include <napi.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "pact-cpp.h"
+#include "aggregator.h"
+#include "in_process.h"
+#include "journal.h"
+
+using namespace Napi;
+
+// Defined in consumer.cc
+PactSpecification integerToSpecification(Napi::Env &env, uint32_t number);
+
+// One pact per consumer/provider pair, shared by every environment in the process. Tests for the
+// same pair running in different worker threads each get a pact of their own, which records its
+// interactions (see journal.h), to build and start mock servers from, so one worker's mock server
+// neither serves nor expects another's interactions, and doesn't stop the others adding to theirs.
+// When a worker writes, its interactions are replayed onto the shared pact, which is written once,
+// by whichever worker releases it last, instead of each worker merging into the file.
+//
+// `sharedPactsMutex` only guards the registry and reference counts. Folding a worker's pact in and
+// writing the file happen under the shared pact's own mutex, so a slow write doesn't hold up
+// workers acquiring other pacts. A release folds in before dropping its reference, under that
+// mutex, so the last release finds every other worker's interactions already there.
+
+struct SharedPact {
+  std::mutex mutex;
+  std::string key;
+  // The pact the workers' interactions are folded into, and which is written
+  PactHandle handle;
+  uint32_t specification;
+  size_t references = 0;
+  // Set by the first release that asks for the pact to be written; the last release writes it
+  bool write = false;
+  std::string dir;
+  bool overwrite = false;
+  // The result of `pactffi_pact_handle_write_file`, once the last release has written the pact
+  int32_t written = 0;
+};
+
+static std::mutex sharedPactsMutex;
+static std::map<std::string, std::shared_ptr<SharedPact>> sharedPactsByKey;
+// By the handle of each worker's own pact
+static std::map<PactHandle, std::shared_ptr<SharedPact>> sharedPactsByHandle;
+
+static std::string sharedPactKey(const std::string& consumer, const std::string& provider) {
+  std::string key(consumer);
+  key.push_back('\0');
+  key.append(provider);
+  return key;
+}
+
+static PactHandle newPact(const std::string& consumer, const std::string& provider, PactSpecification specification) {
+  PactHandle pact = pactffi_new_pact(consumer.c_str(), provider.c_str());
+  if (!pactffi_with_specification(pact, specification)) {
+    pactffi_free_pact_handle(pact);
+    return 0;
+  }
+  return pact;
+}
+
+/**
+ * Returns a new pact for a worker thread's tests for a consumer/provider pair, whose interactions
+ * are added to the pact shared by every worker for the pair when it is released. Each acquire must
+ * be matched by a `pactffiReleaseSharedPact`.
+ *
+ * * `consumer` - the consumer name.
+ * * `provider` - the provider name.
+ * * `specification` - the specification version (as for `pactffiWithSpecification`). Must match
+ *   the version the shared pact was created with.
+ *
+ * The returned pact is used like one from `pactffiNewPact`, but records its interactions (as with
+ * `pactffiEnableJournal`), and can only have HTTP interactions without plugin contents.
+ */
+Napi::Value PactffiAcquireSharedPact(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3) {
+    throw Napi::Error::New(env, "PactffiAcquireSharedPact received < 3 arguments");
+  }
+
+  if (!info[0].IsString()) {
+    throw Napi::Error::New(env, "PactffiAcquireSharedPact(arg 0) expected a string");
+  }
+
+  if (!info[1].IsString()) {
+    throw Napi::Error::New(env, "PactffiAcquireSharedPact(arg 1) expected a string");
+  }
+
+  if (!info[2].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiAcquireSharedPact(arg 2) expected a number");
+  }
+
+  std::string consumer = info[0].As<Napi::String>().Utf8Value();
+  std::string provider = info[1].As<Napi::String>().Utf8Value();
+  uint32_t specificationNumber = info[2].As<Napi::Number>().Uint32Value();
+  PactSpecification specification = integerToSpecification(env, specificationNumber);
+
+  std::string key = sharedPactKey(consumer, provider);
+  std::lock_guard<std::mutex> lock(sharedPactsMutex);
+
+  std::shared_ptr<SharedPact> shared;
+  auto existing = sharedPactsByKey.find(key);
+  if (existing != sharedPactsByKey.end()) {
+    if (existing->second->specification != specificationNumber) {
+      throw Napi::Error::New(env, "PactffiAcquireSharedPact(arg 2) does not match the specification the shared pact was created with");
+    }
+    shared = existing->second;
+  } else {
+    shared = std::make_shared<SharedPact>();
+    shared->key = key;
+    shared->handle = newPact(consumer, provider, specification);
+    shared->specification = specificationNumber;
+    if (shared->handle == 0) {
+      throw Napi::Error::New(env, "PactffiAcquireSharedPact was unable to set the specification version");
+    }
+    sharedPactsByKey[key] = shared;
+  }
+
+  PactHandle pact = newPact(consumer, provider, specification);
+  if (pact == 0) {
+    if (shared->references == 0) {
+      pactffi_free_pact_handle(shared->handle);
+      sharedPactsByKey.erase(key);
+    }
+    throw Napi::Error::New(env, "PactffiAcquireSharedPact was unable to set the specification version");
+  }
+  JournalPact(pact, consumer.c_str(), provider.c_str());
+  JournalPactSpecification(pact, specification);
+  JournalEnable(pact);
+
+  shared->references += 1;
+  sharedPactsByHandle[pact] = shared;
+
+  return Number::New(env, pact);
+}
+
+/**
+ * Frees a pact from `pactffiAcquireSharedPact`, first adding its interactions to the shared pact
+ * if asked to write it. When the last pact for the pair is released, the shared pact is written
+ * (if any release asked for it to be) and freed.
+ *
+ * * `handle` - the handle returned by `pactffiAcquireSharedPact`.
+ * * `dir` - the directory to write the pact to, or an empty string to release without asking
+ *   for the pact to be written (the pact's interactions are dropped). The last directory given
+ *   wins.
+ * * `overwrite` - overwrite rather than merge with an existing pact file.
+ *
+ * Returns the result of `pactffi_pact_handle_write_file` from the last release, if any release
+ * asked for the pact to be written, whether or not this one did: the releases before it return 0
+ * having written nothing, so the caller of the last one is the only one that can report a failed
+ * write. Returns 3 if the handle is not from `pactffiAcquireSharedPact`. Throws if the pact's
+ * interactions can't be added to the shared pact, once the pact has been released (and the shared
+ * pact written, if this was the last release).
+ */
+Napi::Value PactffiReleaseSharedPact(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3) {
+    throw Napi::Error::New(env, "PactffiReleaseSharedPact received < 3 arguments");
+  }
+
+  if (!info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiReleaseSharedPact(arg 0) expected a PactHandle (uint16_t)");
+  }
+
+  if (!info[1].IsString()) {
+    throw Napi::Error::New(env, "PactffiReleaseSharedPact(arg 1) expected a string");
+  }
+
+  if (!info[2].IsBoolean()) {
+    throw Napi::Error::New(env, "PactffiReleaseSharedPact(arg 2) expected a boolean");
+  }
+
+  PactHandle handle = info[0].As<Napi::Number>().Uint32Value();
+  std::string dir = info[1].As<Napi::String>().Utf8Value();
+  bool overwrite = info[2].As<Napi::Boolean>().Value();
+
+  std::shared_ptr<SharedPact> shared;
+  {
+    std::lock_guard<std::mutex> lock(sharedPactsMutex);
+
+    auto it = sharedPactsByHandle.find(handle);
+    if (it == sharedPactsByHandle.end()) {
+      return Number::New(env, 3);
+    }
+    shared = it->second;
+    sharedPactsByHandle.erase(it);
+  }
+
+  std::lock_guard<std::mutex> pactLock(shared->mutex);
+  JournalReplayResult folded = JOURNAL_REPLAYED;
+  if (!dir.empty()) {
+    folded = JournalReplayPact(handle, shared->handle);
+    if (folded == JOURNAL_REPLAYED) {
+      shared->write = true;
+      shared->dir = dir;
+      shared->overwrite = overwrite;
+    }
+  }
+  pactffi_free_pact_handle(handle);
+  InProcessFreePact(env, handle);
+  JournalFreePact(handle);
+
+  bool last;
+  {
+    std::lock_guard<std::mutex> lock(sharedPactsMutex);
+    shared->references -= 1;
+    last = shared->references == 0;
+    // Unregistered before writing, so a worker that starts on this pair afterwards gets a new
+    // shared pact (which merges into the file as usual) rather than one that is about to be freed
+    if (last) {
+      sharedPactsByKey.erase(shared->key);
+    }
+  }
+
+  if (last) {
+    if (shared->write) {
+      shared->written = pactffi_pact_handle_write_file(shared->handle, shared->dir.c_str(), shared->overwrite);
+    }
+    pactffi_free_pact_handle(shared->handle);
+  }
+  int32_t res = last ? shared->written : 0;
+
+  if (folded != JOURNAL_REPLAYED) {
+    std::string message = folded == JOURNAL_UNSUPPORTED
+      ? "PactffiReleaseSharedPact(arg 0) has messages or plugin contents, which can't be added to the shared pact"
+      : "PactffiReleaseSharedPact was unable to add the pact's interactions to the shared pact";
+    if (res != 0) {
+      message += ", and the shared pact could not be written (error " + std::to_string(res) + ")";
+    }
+    throw Napi::Error::New(env, message);
+  }
+
+  return Number::New(env, res);
+}
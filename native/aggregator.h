@@ -0,0 +1,4 @@
+#include <napi.h>
+
+Napi::Value PactffiAcquireSharedPact(const Napi::CallbackInfo& info);
+Napi::Value PactffiReleaseSharedPact(const Napi::CallbackInfo& info);
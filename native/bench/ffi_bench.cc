@@ -0,0 +1,249 @@
+// Baseline for the addon microbenchmarks (bench/native.bench.ts): the cost of the pact_ffi calls
+// each export wraps, made directly from C++ with no N-API marshalling. The difference between the
+// two is what the binding layer costs.
+//
+// Built by `npm run bench:build` (PACT_BUILD_BENCH=true) and run by `npm run bench:ffi`. Writes
+// JSON to stdout.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "pact-cpp.h"
+
+struct BenchResult {
+  std::string name;
+  std::string size;
+  size_t samples;
+  size_t batch;
+  double meanNs;
+  double p50Ns;
+  double p99Ns;
+  double opsPerSec;
+};
+
+static std::vector<BenchResult> results;
+
+static double percentile(const std::vector<double>& sorted, double p) {
+  size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// Runs `op` `batch` times per sample, with a fresh `setup` (untimed) for each sample. Percentiles
+// are over the per-sample mean, so a batch hides timer resolution for the very cheap calls.
+template <typename State, typename Setup, typename Op, typename Teardown>
+static void measure(const char* name, const char* size, size_t samples, size_t batch, Setup setup, Op op, Teardown teardown) {
+  std::vector<double> perOp;
+  perOp.reserve(samples);
+
+  // Warm up caches, the allocator and any lazy initialisation in the core
+  {
+    State state = setup();
+    for (size_t i = 0; i < std::min<size_t>(batch, 100); i++) {
+      op(state, i);
+    }
+    teardown(state);
+  }
+
+  for (size_t s = 0; s < samples; s++) {
+    State state = setup();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < batch; i++) {
+      op(state, i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    teardown(state);
+    perOp.push_back((double)elapsed / batch);
+  }
+
+  std::sort(perOp.begin(), perOp.end());
+  double total = 0;
+  for (double ns : perOp) {
+    total += ns;
+  }
+  double mean = total / perOp.size();
+
+  results.push_back(BenchResult{name, size, samples, batch, mean, percentile(perOp, 0.5), percentile(perOp, 0.99), 1e9 / mean});
+}
+
+struct NoState {};
+struct InteractionState {
+  PactHandle pact;
+  InteractionHandle interaction;
+};
+struct MockServerState {
+  PactHandle pact;
+  int32_t port;
+};
+
+static NoState noSetup() { return NoState{}; }
+static void noTeardown(NoState&) {}
+
+static InteractionState newInteraction() {
+  PactHandle pact = pactffi_new_pact("bench-consumer", "bench-provider");
+  pactffi_with_specification(pact, PactSpecification::PactSpecification_V4);
+  return InteractionState{pact, pactffi_new_interaction(pact, "a benchmark interaction")};
+}
+
+static void freeInteraction(InteractionState& state) {
+  pactffi_free_pact_handle(state.pact);
+}
+
+static std::string jsonBody(size_t bytes) {
+  std::string body = "{\"items\":[";
+  for (size_t i = 0; body.size() < bytes; i++) {
+    if (i > 0) {
+      body += ",";
+    }
+    body += "{\"id\":" + std::to_string(i) + ",\"name\":\"item " + std::to_string(i) + "\"}";
+  }
+  return body + "]}";
+}
+
+static void printJsonString(const std::string& value) {
+  putchar('"');
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      putchar('\\');
+    }
+    putchar(c);
+  }
+  putchar('"');
+}
+
+int main() {
+  const std::string smallBody = jsonBody(64);
+  const std::string largeBody = jsonBody(1 << 20);
+  const std::vector<uint8_t> smallBinary(64, 0xab);
+  const std::vector<uint8_t> largeBinary(1 << 20, 0xab);
+
+  // Consumer DSL
+
+  measure<NoState>("pactffi_version", "small", 200, 10000, noSetup,
+    [](NoState&, size_t) { pactffi_version(); }, noTeardown);
+
+  measure<NoState>("pactffi_new_pact", "small", 100, 100, noSetup,
+    [](NoState&, size_t) { pactffi_free_pact_handle(pactffi_new_pact("bench-consumer", "bench-provider")); }, noTeardown);
+
+  measure<InteractionState>("pactffi_new_interaction", "small", 100, 100, newInteraction,
+    [](InteractionState& state, size_t) { pactffi_new_interaction(state.pact, "another interaction"); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_upon_receiving", "small", 100, 1000, newInteraction,
+    [](InteractionState& state, size_t) { pactffi_upon_receiving(state.interaction, "a request for an item"); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_given", "small", 100, 1000, newInteraction,
+    [](InteractionState& state, size_t) { pactffi_given(state.interaction, "an item exists"); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_given_with_param", "small", 100, 1000, newInteraction,
+    [](InteractionState& state, size_t) { pactffi_given_with_param(state.interaction, "an item exists", "id", "10"); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_with_request", "small", 100, 1000, newInteraction,
+    [](InteractionState& state, size_t) { pactffi_with_request(state.interaction, "GET", "/items/10"); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_with_query_parameter_v2", "small", 100, 1000, newInteraction,
+    [](InteractionState& state, size_t i) { pactffi_with_query_parameter_v2(state.interaction, "page", i, "1"); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_with_header_v2", "small", 100, 1000, newInteraction,
+    [](InteractionState& state, size_t) { pactffi_with_header_v2(state.interaction, InteractionPart::InteractionPart_Request, "Accept", 0, "application/json"); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_response_status_v2", "small", 100, 1000, newInteraction,
+    [](InteractionState& state, size_t) { pactffi_response_status_v2(state.interaction, "200"); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_with_body", "small", 100, 1000, newInteraction,
+    [&](InteractionState& state, size_t) { pactffi_with_body(state.interaction, InteractionPart::InteractionPart_Response, "application/json", smallBody.c_str()); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_with_body", "large", 20, 5, newInteraction,
+    [&](InteractionState& state, size_t) { pactffi_with_body(state.interaction, InteractionPart::InteractionPart_Response, "application/json", largeBody.c_str()); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_with_binary_file", "small", 100, 1000, newInteraction,
+    [&](InteractionState& state, size_t) { pactffi_with_binary_file(state.interaction, InteractionPart::InteractionPart_Response, "application/octet-stream", smallBinary.data(), smallBinary.size()); }, freeInteraction);
+
+  measure<InteractionState>("pactffi_with_binary_file", "large", 20, 5, newInteraction,
+    [&](InteractionState& state, size_t) { pactffi_with_binary_file(state.interaction, InteractionPart::InteractionPart_Response, "application/octet-stream", largeBinary.data(), largeBinary.size()); }, freeInteraction);
+
+  // Messages
+
+  measure<InteractionState>("pactffi_message_with_contents", "small", 100, 1000,
+    []() {
+      PactHandle pact = pactffi_new_pact("bench-consumer", "bench-provider");
+      return InteractionState{pact, pactffi_new_async_message(pact, "an item event")};
+    },
+    [&](InteractionState& state, size_t) { pactffi_message_with_contents(state.interaction, "application/json", (const uint8_t*)smallBody.c_str(), smallBody.size()); },
+    freeInteraction);
+
+  measure<InteractionState>("pactffi_message_reify", "small", 100, 100,
+    [&]() {
+      PactHandle pact = pactffi_new_pact("bench-consumer", "bench-provider");
+      MessageHandle message = pactffi_new_async_message(pact, "an item event");
+      pactffi_message_with_contents(message, "application/json", (const uint8_t*)smallBody.c_str(), smallBody.size());
+      return InteractionState{pact, message};
+    },
+    [](InteractionState& state, size_t) { pactffi_string_delete((char*)pactffi_message_reify(state.interaction)); },
+    freeInteraction);
+
+  // Mock servers. These bind a socket, so there are far fewer samples
+
+  measure<InteractionState>("pactffi_create_mock_server_for_transport", "small", 30, 1, newInteraction,
+    [](InteractionState& state, size_t) {
+      int32_t port = pactffi_create_mock_server_for_transport(state.pact, "127.0.0.1", 0, "http", NULL);
+      if (port > 0) {
+        pactffi_cleanup_mock_server(port);
+      }
+    },
+    freeInteraction);
+
+  auto startMockServer = []() {
+    InteractionState interaction = newInteraction();
+    pactffi_with_request(interaction.interaction, "GET", "/items/10");
+    pactffi_response_status_v2(interaction.interaction, "200");
+    return MockServerState{interaction.pact, pactffi_create_mock_server_for_transport(interaction.pact, "127.0.0.1", 0, "http", NULL)};
+  };
+  auto stopMockServer = [](MockServerState& state) {
+    if (state.port > 0) {
+      pactffi_cleanup_mock_server(state.port);
+    }
+    pactffi_free_pact_handle(state.pact);
+  };
+
+  measure<MockServerState>("pactffi_mock_server_matched", "small", 20, 1000, startMockServer,
+    [](MockServerState& state, size_t) { pactffi_mock_server_matched(state.port); }, stopMockServer);
+
+  // The mismatches are owned by the mock server, so they aren't freed here
+  measure<MockServerState>("pactffi_mock_server_mismatches", "small", 20, 1000, startMockServer,
+    [](MockServerState& state, size_t) { pactffi_mock_server_mismatches(state.port); }, stopMockServer);
+
+  // Verifier
+
+  measure<NoState>("pactffi_verifier_new_for_application", "small", 100, 100, noSetup,
+    [](NoState&, size_t) { pactffi_verifier_shutdown(pactffi_verifier_new_for_application("pact-js-bench", "1.0.0")); }, noTeardown);
+
+  struct VerifierState {
+    VerifierHandle* handle;
+  };
+  auto newVerifier = []() { return VerifierState{pactffi_verifier_new_for_application("pact-js-bench", "1.0.0")}; };
+  auto shutdownVerifier = [](VerifierState& state) { pactffi_verifier_shutdown(state.handle); };
+
+  measure<VerifierState>("pactffi_verifier_set_provider_info", "small", 100, 1000, newVerifier,
+    [](VerifierState& state, size_t) { pactffi_verifier_set_provider_info(state.handle, "bench-provider", "http", "127.0.0.1", 8080, "/"); }, shutdownVerifier);
+
+  measure<VerifierState>("pactffi_verifier_add_custom_header", "small", 100, 1000, newVerifier,
+    [](VerifierState& state, size_t) { pactffi_verifier_add_custom_header(state.handle, "Authorization", "Bearer 1234"); }, shutdownVerifier);
+
+  printf("{\"pactFfiVersion\":");
+  printJsonString(pactffi_version());
+  printf(",\"results\":[");
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult& result = results[i];
+    printf("%s{\"name\":", i > 0 ? "," : "");
+    printJsonString(result.name);
+    printf(",\"size\":");
+    printJsonString(result.size);
+    printf(",\"samples\":%zu,\"batch\":%zu,\"meanNs\":%.1f,\"p50Ns\":%.1f,\"p99Ns\":%.1f,\"opsPerSec\":%.1f}",
+      result.samples, result.batch, result.meanNs, result.p50Ns, result.p99Ns, result.opsPerSec);
+  }
+  printf("]}\n");
+
+  return 0;
+}
@@ -1,5 +1,18 @@
 #include <napi.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <random>
 #include "pact-cpp.h"
+#include "logs.h"
+#include "ownership.h"
+#include "trace.h"
+#include "marshal.h"
+#include "json.h"
+#include "journal.h"
+#include "in_process.h"
+#include "mapped_file.h"
+#include "typed_export.h"
 
 
 using namespace Napi;
@@ -88,11 +101,12 @@ Napi::Value PactffiFetchLogBuffer(const Napi::CallbackInfo& info) {
     throw Napi::Error::New(env, "PactffiFetchLogBuffer(log_id) expected a string");
   }
 
-  std::string log_id = info[0].As<Napi::String>().Utf8Value();
+  Utf8Arg log_id(info[0]);
 
-  const char* buffer = pactffi_fetch_log_buffer(log_id.c_str());
+  // An empty identifier selects the global buffer
+  FfiString buffer(pactffi_fetch_log_buffer(log_id.empty() ? NULL : log_id.c_str()));
 
-  return Napi::String::New(env, buffer);
+  return buffer.ToValue(env);
 }
 
 /**
@@ -131,23 +145,7 @@ Napi::Value PactffiStringDelete(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_mock_server_matched(int32_t mock_server_port);
  */
-Napi::Value PactffiMockServerMatched(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiMockServerMatched received < 1 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiMockServerMatched(port) expected a number");
-  }
-
-  int32_t port = info[0].As<Napi::Number>().Int32Value();
-
-  bool res = pactffi_mock_server_matched(port);
-
-  return Napi::Boolean::New(env, res);
-}
+TYPED_EXPORT(PactffiMockServerMatched, pactffi_mock_server_matched)
 
 /**
  * External interface to get all the mismatches from a mock server. The port number of the mock
@@ -179,9 +177,17 @@ Napi::Value PactffiMockServerMismatches(const Napi::CallbackInfo& info) {
   }
 
   int32_t port = info[0].As<Napi::Number>().Int32Value();
+  // Owned by the mock server until it is cleaned up, and a new copy is kept on every call
   char* res = pactffi_mock_server_mismatches(port);
 
-  return Napi::String::New(env, res);
+  if (res == NULL) {
+    throw Napi::Error::New(env, "PactffiMockServerMismatches(port) found no mock server on that port");
+  }
+
+  Napi::String mismatches = Napi::String::New(env, res);
+  ExternalMemoryRetainForMockServer(env, port, strlen(res) + 1);
+
+  return mismatches;
 }
 
 /**
@@ -239,7 +245,7 @@ Napi::Value PactffiCreateMockServerForTransport(const Napi::CallbackInfo& info)
   }
 
   if (!info[2].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiCleanupMockServer(arg 2) expected a number");
+    throw Napi::Error::New(env, "PactffiCreateMockServerForTransport(arg 2) expected a number");
   }
 
   if (!info[3].IsString()) {
@@ -251,12 +257,17 @@ Napi::Value PactffiCreateMockServerForTransport(const Napi::CallbackInfo& info)
   }
 
   PactHandle pact = info[0].As<Napi::Number>().Int32Value();
-  std::string addr = info[1].As<Napi::String>().Utf8Value();
+  Utf8Arg addr(info[1]);
   uint32_t port = info[2].As<Napi::Number>().Int32Value();
-  std::string transport = info[3].As<Napi::String>().Utf8Value();
-  std::string config = info[4].As<Napi::String>().Utf8Value();
+  Utf8Arg transport(info[3]);
+  Utf8Arg config(info[4]);
 
-  uint32_t result = pactffi_create_mock_server_for_transport(pact, addr.c_str(), port, transport.c_str(), config.c_str());
+  int32_t result = pactffi_create_mock_server_for_transport(pact, addr.c_str(), port, transport.c_str(), config.c_str());
+
+  if (result > 0) {
+    TestLogsTrackMockServer(env, result);
+    TraceInstant("mock server started", "mock-server", "port", result);
+  }
 
   return Number::New(env, result);
 }
@@ -274,16 +285,9 @@ Napi::Value PactffiCreateMockServerForTransport(const Napi::CallbackInfo& info)
 Napi::Value PactffiGetTlsCaCertificate(const Napi::CallbackInfo& info) {
    Napi::Env env = info.Env();
 
-  char* res = pactffi_get_tls_ca_certificate();
-
-  if (res == NULL) {
-    return env.Null();
-  }
-
-  Napi::String cert = Napi::String::New(env, res);
-  pactffi_string_delete(res);
+  FfiString cert(pactffi_get_tls_ca_certificate());
 
-  return cert;
+  return cert.ToValue(env);
 }
 
 /**
@@ -308,7 +312,12 @@ Napi::Value PactffiCleanupMockServer(const Napi::CallbackInfo& info) {
 
   uint32_t port = info[0].As<Napi::Number>().Int32Value();
 
+  TestLogsReleaseMockServer(env, port);
   bool res = pactffi_cleanup_mock_server(port);
+  if (res) {
+    ExternalMemoryReleaseMockServer(env, port);
+  }
+  TraceInstant("mock server cleaned up", "mock-server", "port", port);
 
   return Napi::Boolean::New(env, res);
 }
@@ -342,33 +351,7 @@ Napi::Value PactffiCleanupMockServer(const Napi::CallbackInfo& info) {
  *
  *     int32_t pactffi_pact_handle_write_file(PactHandle pact, const char *directory, bool overwrite);
  */
-Napi::Value PactffiWritePactFile(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 3) {
-    throw Napi::Error::New(env, "PactffiWritePactFile received < 3 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWritePactFile(arg 0) expected a PactHandle (uint16_t");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiWritePactFile(arg 1) expected a string");
-  }
-
-  if (!info[2].IsBoolean()) {
-    throw Napi::Error::New(env, "PactffiWritePactFile(arg 2) expected a boolean");
-  }
-
-  PactHandle pact = info[0].As<Napi::Number>().Int32Value();
-  std::string dir = info[1].As<Napi::String>().Utf8Value();
-  bool overwrite = info[2].As<Napi::Boolean>().Value();
-
-  int32_t res = pactffi_pact_handle_write_file(pact, dir.c_str(), overwrite);
-
-  return Number::New(env, res);
-}
+TYPED_EXPORT(PactffiWritePactFile, pactffi_pact_handle_write_file)
 
 /**
  * External interface to trigger a mock server to write out its pact file. This function should
@@ -395,33 +378,7 @@ Napi::Value PactffiWritePactFile(const Napi::CallbackInfo& info) {
  *
  *    int32_t pactffi_write_pact_file(int32_t mock_server_port, const char *directory, bool overwrite);
  */
-Napi::Value PactffiWritePactFileByPort(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 3) {
-    throw Napi::Error::New(env, "PactffiWritePactFileByPort received < 3 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWritePactFileByPort(arg 0) expected a number");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiWritePactFileByPort(arg 1) expected a string");
-  }
-
-  if (!info[2].IsBoolean()) {
-    throw Napi::Error::New(env, "PactffiWritePactFileByPort(arg 2) expected a boolean");
-  }
-
-  int32_t port = info[0].As<Napi::Number>().Int32Value();
-  std::string dir = info[1].As<Napi::String>().Utf8Value();
-  bool overwrite = info[2].As<Napi::Boolean>().Value();
-
-  int32_t res = pactffi_write_pact_file(port, dir.c_str(), overwrite);
-
-  return Number::New(env, res);
-}
+TYPED_EXPORT(PactffiWritePactFileByPort, pactffi_write_pact_file)
 
 /**
  * Creates a new Pact model and returns a handle to it.
@@ -437,26 +394,34 @@ Napi::Value PactffiWritePactFileByPort(const Napi::CallbackInfo& info) {
  *    PactHandle pactffi_new_pact(const char *consumer_name, const char *provider_name);
  */
 Napi::Value PactffiNewPact(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiNewPact received < 2 arguments");
-  }
-
-  if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiNewPact(arg 0) expected a string");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiNewPact(arg 1) expected a string");
-  }
-
-  std::string consumer = info[0].As<Napi::String>().Utf8Value();
-  std::string provider = info[1].As<Napi::String>().Utf8Value();
-
-  PactHandle pact = pactffi_new_pact(consumer.c_str(), provider.c_str());
+  Napi::Value pact = CallTyped(info, "PactffiNewPact", pactffi_new_pact);
+  Utf8Arg consumer(info[0]);
+  Utf8Arg provider(info[1]);
+  JournalPact(pact.As<Napi::Number>().Uint32Value(), consumer.c_str(), provider.c_str());
+  return pact;
+}
 
-  return Number::New(env, pact);
+/**
+ * Delete a Pact handle and free the resources used by it. Interactions and messages created from
+ * the pact belong to it, and their handles are invalid once it is freed. Mock servers started from
+ * the pact keep their own copy of it, so they are unaffected.
+ *
+ * # Error Handling
+ *
+ * On failure, this function will return a positive integer value.
+ *
+ * * `1` - The handle is not valid or does not refer to a valid Pact. Could be that it was
+ * previously deleted.
+ *
+ * C interface:
+ *
+ *    unsigned int pactffi_free_pact_handle(PactHandle pact);
+ */
+Napi::Value PactffiFreePactHandle(const Napi::CallbackInfo& info) {
+  Napi::Value result = CallTyped(info, "PactffiFreePactHandle", pactffi_free_pact_handle);
+  InProcessFreePact(info.Env(), info[0].As<Napi::Number>().Uint32Value());
+  JournalFreePact(info[0].As<Napi::Number>().Uint32Value());
+  return result;
 }
 
 /**
@@ -471,26 +436,10 @@ Napi::Value PactffiNewPact(const Napi::CallbackInfo& info) {
  *    InteractionHandle pactffi_new_interaction(PactHandle pact, const char *description);
  */
 Napi::Value PactffiNewInteraction(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiNewInteraction received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiNewInteraction(arg 0) expected a PactHandle (uint16_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiNewInteraction(arg 1) expected a string");
-  }
-
-  PactHandle pact = info[0].As<Napi::Number>().Uint32Value();
-  std::string description = info[1].As<Napi::String>().Utf8Value();
-
-  InteractionHandle handle = pactffi_new_interaction(pact, description.c_str());
-
-  return Number::New(env, handle);
+  Napi::Value interaction = CallTyped(info, "PactffiNewInteraction", pactffi_new_interaction);
+  Utf8Arg description(info[1]);
+  JournalInteraction(info[0].As<Napi::Number>().Uint32Value(), interaction.As<Napi::Number>().Uint32Value(), description.c_str());
+  return interaction;
 }
 
 /**
@@ -503,28 +452,7 @@ Napi::Value PactffiNewInteraction(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_upon_receiving(InteractionHandle interaction, const char *description);
  */
-Napi::Value PactffiUponReceiving(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiUponReceiving received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiUponReceiving(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiUponReceiving(arg 1) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string description = info[1].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_upon_receiving(interaction, description.c_str());
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiUponReceiving, pactffi_upon_receiving, JOURNAL_UPON_RECEIVING)
 
 /**
  * Adds a provider state to the Interaction. Returns false if the interaction or Pact can't be
@@ -536,28 +464,7 @@ Napi::Value PactffiUponReceiving(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_given(InteractionHandle interaction, const char *description);
  */
-Napi::Value PactffiGiven(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiGiven received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiGiven(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiGiven(arg 1) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string description = info[1].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_given(interaction, description.c_str());
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiGiven, pactffi_given, JOURNAL_GIVEN)
 
 /**
  * Write the `description` field on the `SynchronousMessage`.
@@ -617,38 +524,7 @@ Napi::Value PactffiGiven(const Napi::CallbackInfo& info) {
  *                               const char *name,
  *                               const char *value);
  */
-Napi::Value PactffiGivenWithParam(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 4) {
-    throw Napi::Error::New(env, "PactffiGivenWithParam received < 4 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiGivenWithParam(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiGivenWithParam(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiGivenWithParam(arg 2) expected a string");
-  }
-
-  if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "PactffiGivenWithParam(arg 3) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string description = info[1].As<Napi::String>().Utf8Value();
-  std::string name = info[2].As<Napi::String>().Utf8Value();
-  std::string value = info[3].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_given_with_param(interaction, description.c_str(), name.c_str(), value.c_str());
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiGivenWithParam, pactffi_given_with_param, JOURNAL_GIVEN_WITH_PARAM)
 
 /**
  * Adds a provider state to the Interaction with a set of parameter key and value pairs in JSON
@@ -693,14 +569,15 @@ Napi::Value PactffiGivenWithParams(const Napi::CallbackInfo& info) {
   }
 
   InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string description = info[1].As<Napi::String>().Utf8Value();
-  std::string params = info[2].As<Napi::String>().Utf8Value();
+  Utf8Arg description(info[1]);
+  Utf8Arg params(info[2]);
 
   int res = pactffi_given_with_params(interaction, description.c_str(), params.c_str());
 
   if (res > 0) {
     return Napi::Boolean::New(env, false);
   }
+  JournalRecord(JOURNAL_GIVEN_WITH_PARAMS, interaction, description.c_str(), params.c_str());
   return Napi::Boolean::New(env, true);
 }
 
@@ -711,28 +588,7 @@ Napi::Value PactffiGivenWithParams(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_set_pending(InteractionHandle interaction, bool pending);
  */
-Napi::Value PactffiSetPending(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiSetPending received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiSetPending(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsBoolean()) {
-    throw Napi::Error::New(env, "PactffiSetPending(arg 1) expected a boolean");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  bool pending = info[1].As<Napi::Boolean>().Value();
-
-  bool res = pactffi_set_pending(interaction, pending);
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiSetPending, pactffi_set_pending, JOURNAL_SET_PENDING)
 
 /**
  * Sets metadata comment key/value pair for an interaction.
@@ -741,33 +597,7 @@ Napi::Value PactffiSetPending(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_set_comment(InteractionHandle interaction, const char *key, const char *value);
  */
-Napi::Value PactffiSetComment(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 3) {
-    throw Napi::Error::New(env, "PactffiSetComment received < 3 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiSetComment(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiSetComment(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiSetComment(arg 2) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string key = info[1].As<Napi::String>().Utf8Value();
-  std::string value = info[2].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_set_comment(interaction, key.c_str(), value.c_str());
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiSetComment, pactffi_set_comment, JOURNAL_SET_COMMENT)
 
 /**
  * Sets the unique key for an interaction.
@@ -776,28 +606,7 @@ Napi::Value PactffiSetComment(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_set_key(InteractionHandle interaction, const char *value);
  */
-Napi::Value PactffiSetKey(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiSetKey received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiSetKey(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiSetKey(arg 1) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string value = info[1].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_set_key(interaction, value.c_str());
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiSetKey, pactffi_set_key, JOURNAL_SET_KEY)
 
 /**
  * Adds a plain text comment to interaction metadata.
@@ -806,28 +615,7 @@ Napi::Value PactffiSetKey(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_add_text_comment(InteractionHandle interaction, const char *comment);
  */
-Napi::Value PactffiAddTextComment(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiAddTextComment received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiAddTextComment(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiAddTextComment(arg 1) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string comment = info[1].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_add_text_comment(interaction, comment.c_str());
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiAddTextComment, pactffi_add_text_comment, JOURNAL_ADD_TEXT_COMMENT)
 
 /**
  * Adds an external reference to an interaction.
@@ -836,38 +624,7 @@ Napi::Value PactffiAddTextComment(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_add_interaction_reference(InteractionHandle interaction, const char *group, const char *name, const char *value);
  */
-Napi::Value PactffiAddInteractionReference(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 4) {
-    throw Napi::Error::New(env, "PactffiAddInteractionReference received < 4 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiAddInteractionReference(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiAddInteractionReference(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiAddInteractionReference(arg 2) expected a string");
-  }
-
-  if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "PactffiAddInteractionReference(arg 3) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string group = info[1].As<Napi::String>().Utf8Value();
-  std::string name = info[2].As<Napi::String>().Utf8Value();
-  std::string value = info[3].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_add_interaction_reference(interaction, group.c_str(), name.c_str(), value.c_str());
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiAddInteractionReference, pactffi_add_interaction_reference, JOURNAL_ADD_INTERACTION_REFERENCE)
 
 /**
  * Sets test name metadata for an interaction.
@@ -876,28 +633,7 @@ Napi::Value PactffiAddInteractionReference(const Napi::CallbackInfo& info) {
  *
  *    unsigned int pactffi_interaction_test_name(InteractionHandle interaction, const char *test_name);
  */
-Napi::Value PactffiInteractionTestName(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiInteractionTestName received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiInteractionTestName(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiInteractionTestName(arg 1) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string testName = info[1].As<Napi::String>().Utf8Value();
-
-  unsigned int res = pactffi_interaction_test_name(interaction, testName.c_str());
-
-  return Napi::Number::New(env, res);
-}
+JOURNALED_EXPORT(PactffiInteractionTestName, pactffi_interaction_test_name, JOURNAL_INTERACTION_TEST_NAME)
 
 /**
  * Configures the request for the Interaction. Returns false if the interaction or Pact can't be
@@ -910,33 +646,7 @@ Napi::Value PactffiInteractionTestName(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_with_request(InteractionHandle interaction, const char *method, const char *path);
  */
-Napi::Value PactffiWithRequest(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 3) {
-    throw Napi::Error::New(env, "PactffiWithRequest received < 3 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithRequest(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithRequest(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithRequest(arg 2) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string method = info[1].As<Napi::String>().Utf8Value();
-  std::string path = info[2].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_with_request(interaction, method.c_str(), path.c_str());
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiWithRequest, pactffi_with_request, JOURNAL_WITH_REQUEST)
 
 /**
  * Configures a query parameter for the Interaction. Returns false if the interaction or Pact can't be
@@ -950,38 +660,7 @@ Napi::Value PactffiWithRequest(const Napi::CallbackInfo& info) {
  *
  *    bool pactffi_with_query_parameter(InteractionHandle interaction, const char *name, size_t index, const char *value);
  */
-Napi::Value PactffiWithQueryParameter(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 4) {
-    throw Napi::Error::New(env, "PactffiWithQueryParameter received < 4 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithQueryParameter(arg 0) expected a InteractionHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithQueryParameter(arg 1) expected a string");
-  }
-
-  if (!info[2].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithQueryParameter(arg 2) expected a number");
-  }
-
-  if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithQueryParameter(arg 3) expected a string");
-  }
-
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string name = info[1].As<Napi::String>().Utf8Value();
-  size_t index = info[2].As<Napi::Number>().Uint32Value();
-  std::string value = info[3].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_with_query_parameter(interaction, name.c_str(), index, value.c_str());
-
-  return Napi::Boolean::New(env, res);
-}
+JOURNALED_EXPORT(PactffiWithQueryParameter, pactffi_with_query_parameter, JOURNAL_WITH_QUERY_PARAMETER)
 
 /**
  * Sets the specification version for a given Pact model. Returns false if the interaction or Pact can't be
@@ -995,27 +674,13 @@ Napi::Value PactffiWithQueryParameter(const Napi::CallbackInfo& info) {
  *    bool pactffi_with_specification(PactHandle pact, PactSpecification version);
  */
 Napi::Value PactffiWithSpecification(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiWithSpecification received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithSpecification(arg 0) expected a PactHandle (uint16_t)");
-  }
-
-  if (!info[1].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithSpecification(arg 1) expected a number");
+  Napi::Env env = info.Env();
+  Napi::Value result = CallTyped(info, "PactffiWithSpecification", pactffi_with_specification);
+  if (result.As<Napi::Boolean>().Value()) {
+    PactSpecification specification = integerToSpecification(env, info[1].As<Napi::Number>().Uint32Value());
+    JournalPactSpecification(info[0].As<Napi::Number>().Uint32Value(), specification);
   }
-
-  PactHandle pact = info[0].As<Napi::Number>().Uint32Value();
-  uint32_t specificationNumber = info[1].As<Napi::Number>().Uint32Value();
-  PactSpecification specification = integerToSpecification(env, specificationNumber);
-
-  bool res = pactffi_with_specification(pact, specification);
-
-  return Napi::Boolean::New(env, res);
+  return result;
 }
 
 /**
@@ -1032,36 +697,14 @@ Napi::Value PactffiWithSpecification(const Napi::CallbackInfo& info) {
  *    bool pactffi_with_pact_metadata(PactHandle pact, const char *namespace_, const char *name, const char *value);
  */
 Napi::Value PactffiWithPactMetadata(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 4) {
-    throw Napi::Error::New(env, "PactffiWithPactMetadata received < 4 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithPactMetadata(arg 0) expected a PactHandle (uint16_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithPactMetadata(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithPactMetadata(arg 2) expected a string");
-  }
-
-  if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithPactMetadata(arg 3) expected a string");
-  }
-
-  PactHandle pact = info[0].As<Napi::Number>().Uint32Value();
-  std::string ns = info[1].As<Napi::String>().Utf8Value();
-  std::string name = info[2].As<Napi::String>().Utf8Value();
-  std::string value = info[3].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_with_pact_metadata(pact, ns.c_str(), name.c_str(), value.c_str());
-
-  return Napi::Boolean::New(env, res);
+  Napi::Value result = CallTyped(info, "PactffiWithPactMetadata", pactffi_with_pact_metadata);
+  if (result.As<Napi::Boolean>().Value()) {
+    Utf8Arg ns(info[1]);
+    Utf8Arg name(info[2]);
+    Utf8Arg value(info[3]);
+    JournalPactMetadata(info[0].As<Napi::Number>().Uint32Value(), ns.c_str(), name.c_str(), value.c_str());
+  }
+  return result;
 }
 
 /**
@@ -1108,43 +751,198 @@ Napi::Value PactffiWithPactMetadata(const Napi::CallbackInfo& info) {
  *                                size_t index,
  *                                const char *value);
  */
-Napi::Value PactffiWithHeader(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
+JOURNALED_EXPORT(PactffiWithHeader, pactffi_with_header_v2, JOURNAL_WITH_HEADER)
 
-  if (info.Length() < 5) {
-    throw Napi::Error::New(env, "PactffiWithHeader received < 5 arguments");
+// A value accepted for a key by the batch setters below: a string, or a matcher object
+// serialised to JSON as for bodies
+static bool IsEntryValue(const Napi::Value& value) {
+  return value.IsString() || (value.IsObject() && !value.IsArray() && !value.IsBuffer());
+}
+
+template <typename Setter>
+static bool SetEntry(Setter& set, const char* name, size_t index, const Napi::Value& value) {
+  if (value.IsString()) {
+    Utf8Arg arg(value);
+    return set(name, index, arg.c_str());
+  }
+  JsonArg arg(value);
+  return set(name, index, arg.c_str());
+}
+
+// Checks every entry of `entries` is a value or a non empty array of values
+static void CheckEntries(Napi::Env env, const char* name, size_t argIndex, Napi::Object entries) {
+  Napi::Array keys = entries.GetPropertyNames();
+
+  for (uint32_t i = 0; i < keys.Length(); i++) {
+    Napi::HandleScope scope(env);
+    Napi::Value key = keys.Get(i);
+    Napi::Value value = entries.Get(key);
+
+    bool valid = IsEntryValue(value);
+    if (value.IsArray()) {
+      Napi::Array values = value.As<Napi::Array>();
+      valid = values.Length() > 0;
+      for (uint32_t j = 0; valid && j < values.Length(); j++) {
+        valid = IsEntryValue(values.Get(j));
+      }
+    }
+
+    if (!valid) {
+      throw Napi::Error::New(env, std::string(name) + "(arg " + std::to_string(argIndex) + ") expected '" +
+        key.As<Napi::String>().Utf8Value() + "' to be a string, a matcher object or an array of them");
+    }
+  }
+}
+
+// Calls `set(name, index, value)` for every entry of `entries`, where an array value sets one
+// index per element, and returns an object of whether each key's calls all succeeded. Every
+// entry is checked before any is set, so a bad one fails the call without a partial update.
+template <typename Setter>
+static Napi::Object SetEntries(Napi::Env env, const char* name, size_t argIndex, Napi::Object entries, Setter set) {
+  CheckEntries(env, name, argIndex, entries);
+
+  Napi::Array keys = entries.GetPropertyNames();
+  Napi::Object results = Napi::Object::New(env);
+  for (uint32_t i = 0; i < keys.Length(); i++) {
+    Napi::HandleScope scope(env);
+    Napi::Value key = keys.Get(i);
+    Napi::Value value = entries.Get(key);
+    Utf8Arg keyName(key);
+
+    bool ok = true;
+    if (value.IsArray()) {
+      Napi::Array values = value.As<Napi::Array>();
+      for (uint32_t j = 0; j < values.Length(); j++) {
+        ok = SetEntry(set, keyName.c_str(), j, values.Get(j)) && ok;
+      }
+    } else {
+      ok = SetEntry(set, keyName.c_str(), 0, value);
+    }
+
+    results.Set(key, Napi::Boolean::New(env, ok));
+  }
+
+  return results;
+}
+
+static Napi::Object SetHeaders(Napi::Env env, const char* name, size_t argIndex, InteractionHandle interaction, InteractionPart part, Napi::Object headers) {
+  return SetEntries(env, name, argIndex, headers,
+    [interaction, part](const char* name, size_t index, const char* value) {
+      bool ok = pactffi_with_header_v2(interaction, part, name, index, value);
+      if (ok) {
+        JournalRecord(JOURNAL_WITH_HEADER, interaction, part, name, index, value);
+      }
+      return ok;
+    });
+}
+
+static Napi::Object SetQueryParameters(Napi::Env env, const char* name, size_t argIndex, InteractionHandle interaction, Napi::Object parameters) {
+  return SetEntries(env, name, argIndex, parameters,
+    [interaction](const char* name, size_t index, const char* value) {
+      bool ok = pactffi_with_query_parameter_v2(interaction, name, index, value);
+      if (ok) {
+        JournalRecord(JOURNAL_WITH_QUERY_PARAMETER_V2, interaction, name, index, value);
+      }
+      return ok;
+    });
+}
+
+/**
+ * Configures all the headers of one part of the Interaction in one call. Each key of `headers`
+ * is a header name, and its value is either a string, a matcher object (as JSON for
+ * pactffi_with_header_v2, above), or an array of them for a header with multiple values. Returns
+ * an object with, for each header, false if any of its values could not be set.
+ *
+ * Equivalent to calling pactffi_with_header_v2 for each value, with the index of the value in
+ * its array (or 0).
+ *
+ * C interface:
+ *
+ *    bool pactffi_with_header_v2(InteractionHandle interaction,
+ *                                enum InteractionPart part,
+ *                                const char *name,
+ *                                size_t index,
+ *                                const char *value);
+ */
+Napi::Value PactffiWithHeaders(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3) {
+    throw Napi::Error::New(env, "PactffiWithHeaders received < 3 arguments");
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithHeader(arg 0) expected a PactHandle (uint16_t)");
+    throw Napi::Error::New(env, "PactffiWithHeaders(arg 0) expected a number");
   }
 
   if (!info[1].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithHeader(arg 1) expected an InteractionPart (uint32_t)");
+    throw Napi::Error::New(env, "PactffiWithHeaders(arg 1) expected a number");
   }
 
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithHeader(arg 2) expected a string");
+  if (!info[2].IsObject() || info[2].IsArray()) {
+    throw Napi::Error::New(env, "PactffiWithHeaders(arg 2) expected an object");
   }
 
-  if (!info[3].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithHeader(arg 3) expected a number");
+  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
+  InteractionPart part = integerToInteractionPart(env, info[1].As<Napi::Number>().Uint32Value());
+
+  return SetHeaders(env, "PactffiWithHeaders", 2, interaction, part, info[2].As<Napi::Object>());
+}
+
+/**
+ * Configures all the query parameters of the Interaction in one call. Each key of `parameters`
+ * is a parameter name, and its value is either a string, a matcher object, or an array of them
+ * for a parameter with multiple values. Returns an object with, for each parameter, false if any
+ * of its values could not be set.
+ *
+ * Equivalent to calling pactffi_with_query_parameter_v2 for each value, with the index of the
+ * value in its array (or 0).
+ *
+ * C interface:
+ *
+ *    bool pactffi_with_query_parameter_v2(InteractionHandle interaction, const char *name, size_t index, const char *value);
+ */
+Napi::Value PactffiWithQueryParameters(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    throw Napi::Error::New(env, "PactffiWithQueryParameters received < 2 arguments");
   }
 
-  if (!info[4].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithHeader(arg 4) expected a string");
+  if (!info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiWithQueryParameters(arg 0) expected a number");
+  }
+
+  if (!info[1].IsObject() || info[1].IsArray()) {
+    throw Napi::Error::New(env, "PactffiWithQueryParameters(arg 1) expected an object");
   }
 
   InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  uint32_t partNumber = info[1].As<Napi::Number>().Uint32Value();
-  InteractionPart part = integerToInteractionPart(env, partNumber);
-  std::string name = info[2].As<Napi::String>().Utf8Value();
-  size_t index = info[3].As<Napi::Number>().Uint32Value();
-  std::string value = info[4].As<Napi::String>().Utf8Value();
 
-  bool res = pactffi_with_header_v2(interaction, part, name.c_str(), index, value.c_str());
+  return SetQueryParameters(env, "PactffiWithQueryParameters", 1, interaction, info[1].As<Napi::Object>());
+}
 
-  return Napi::Boolean::New(env, res);
+static bool IsBodyValue(const Napi::Value& body) {
+  return body.IsString() || (body.IsObject() && !body.IsBuffer());
+}
+
+// Sets a body given as a string, or as an object to serialise
+static bool SetBody(InteractionHandle interaction, InteractionPart part, const char* contentType, const Napi::Value& body) {
+  bool res;
+  if (body.IsString()) {
+    Utf8Arg text(body);
+    res = pactffi_with_body(interaction, part, contentType, text.c_str());
+    if (res) {
+      JournalRecord(JOURNAL_WITH_BODY, interaction, part, contentType, text.c_str());
+    }
+  } else {
+    JsonArg json(body);
+    res = pactffi_with_body(interaction, part, contentType, json.c_str());
+    if (res) {
+      JournalRecord(JOURNAL_WITH_BODY, interaction, part, contentType, json.c_str());
+    }
+  }
+  return res;
 }
 
 /**
@@ -1156,6 +954,9 @@ Napi::Value PactffiWithHeader(const Napi::CallbackInfo& info) {
  *   header is already set.
  * * `body` - The body contents. For JSON payloads, matching rules can be embedded in the body.
  *
+ * The body may also be given as a JS object or array, which is serialised to JSON here (see
+ * json.h) rather than with JSON.stringify, keeping any embedded matchers as they are.
+ *
  * C interface:
  *
  * bool pactffi_with_body(InteractionHandle interaction,
@@ -1164,37 +965,33 @@ Napi::Value PactffiWithHeader(const Napi::CallbackInfo& info) {
  *                        const char *body);
  */
 Napi::Value PactffiWithBody(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
+  Napi::Env env = info.Env();
 
   if (info.Length() < 4) {
     throw Napi::Error::New(env, "PactffiWithBody received < 4 arguments");
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithBody(arg 0) expected a PactHandle (uint16_t)");
+    throw Napi::Error::New(env, "PactffiWithBody(arg 0) expected a number");
   }
 
   if (!info[1].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithBody(arg 1) expected an InteractionPart (uint32_t)");
+    throw Napi::Error::New(env, "PactffiWithBody(arg 1) expected a number");
   }
 
   if (!info[2].IsString()) {
     throw Napi::Error::New(env, "PactffiWithBody(arg 2) expected a string");
   }
 
-  if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithBody(arg 3) expected a string");
+  if (!IsBodyValue(info[3])) {
+    throw Napi::Error::New(env, "PactffiWithBody(arg 3) expected a string or an object");
   }
 
   InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  uint32_t partNumber = info[1].As<Napi::Number>().Uint32Value();
-  InteractionPart part = integerToInteractionPart(env, partNumber);
-  std::string contentType = info[2].As<Napi::String>().Utf8Value();
-  std::string body = info[3].As<Napi::String>().Utf8Value();
-
-  bool res = pactffi_with_body(interaction, part, contentType.c_str(), body.c_str());
+  InteractionPart part = integerToInteractionPart(env, info[1].As<Napi::Number>().Uint32Value());
+  Utf8Arg contentType(info[2]);
 
-  return Napi::Boolean::New(env, res);
+  return Napi::Boolean::New(env, SetBody(interaction, part, contentType.c_str(), info[3]));
 }
 
 /**
@@ -1247,58 +1044,98 @@ Napi::Value PactffiWithBinaryFile(const Napi::CallbackInfo& info) {
   uint32_t partNumber = info[1].As<Napi::Number>().Uint32Value();
   InteractionPart part = integerToInteractionPart(env, partNumber);
 
-  std::string contentType = info[2].As<Napi::String>().Utf8Value();
+  Utf8Arg contentType(info[2]);
   Napi::Buffer<uint8_t> buffer = info[3].As<Napi::Buffer<uint8_t>>();
-  size_t size = info[4].As<Napi::Number>().Uint32Value();
-  
+  int64_t requested = info[4].As<Napi::Number>().Int64Value();
+  if (requested < 0 || static_cast<uint64_t>(requested) > buffer.Length()) {
+    throw Napi::Error::New(env, "PactffiWithBinaryFile(arg 4) expected a size no larger than the Buffer");
+  }
+  size_t size = static_cast<size_t>(requested);
+
   bool res = pactffi_with_binary_file(interaction, part, contentType.c_str(), buffer.Data(), size);
+  if (res) {
+    JournalRecord(JOURNAL_WITH_BINARY_FILE, interaction, part, contentType.c_str(), JournalBytes{buffer.Data(), size});
+  }
 
   return Napi::Boolean::New(env, res);
 }
 
 /**
- * Add matching rules to the interaction. Matching rules are used to specify how the request
- * or response should be matched. This is useful for specifying that certain parts of the request 
- * or response are flexible, such as the date or time.
+ * Adds the contents of a file as a binary body, as `pactffiWithBinaryFile` does with a Buffer. The
+ * file is memory mapped and handed to the FFI as it is, rather than being read into a Buffer
+ * first, so it is held in memory once (by the pact) instead of twice, and sizes are 64 bit
+ * throughout. The mapping is released before this returns.
  *
  * * `interaction` - Interaction handle to set the body for.
  * * `part` - Request or response part.
- * * `rules` - JSON string of the matching rules to add to the interaction.
+ * * `content_type` - Expected content type.
+ * * `path` - the file to use as the body.
  *
- * C interface:
+ * Throws if the file can't be opened or mapped. Copies of the interaction read the file again,
+ * by its absolute path, rather than keeping a copy of it; snapshots keep a copy.
  *
- * bool pactffi_with_matching_rules(InteractionHandle interaction,
- *                                  InteractionPart part,
- *                                  const char *rules);
+ * C interface: none, calls `pactffi_with_binary_file` with the mapped file.
  */
-Napi::Value PactffiWithMatchingRules(const Napi::CallbackInfo& info) {
+Napi::Value PactffiWithBinaryFilePath(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
-  if (info.Length() < 3) {
-    throw Napi::Error::New(env, "PactffiWithMatchingRules received < 3 arguments");
+  if (info.Length() < 4) {
+    throw Napi::Error::New(env, "PactffiWithBinaryFilePath received < 4 arguments");
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithMatchingRules(arg 0) expected a PactHandle (uint16_t)");
+    throw Napi::Error::New(env, "PactffiWithBinaryFilePath(arg 0) expected an InteractionHandle (uint32_t)");
   }
 
   if (!info[1].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiWithMatchingRules(arg 1) expected an InteractionPart (uint32_t)");
+    throw Napi::Error::New(env, "PactffiWithBinaryFilePath(arg 1) expected an InteractionPart (uint32_t)");
   }
 
   if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiWithMatchingRules(arg 2) expected a string");
+    throw Napi::Error::New(env, "PactffiWithBinaryFilePath(arg 2) expected a string");
+  }
+
+  if (!info[3].IsString()) {
+    throw Napi::Error::New(env, "PactffiWithBinaryFilePath(arg 3) expected a string");
   }
 
   InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  uint32_t partNumber = info[1].As<Napi::Number>().Uint32Value();
-  InteractionPart part = integerToInteractionPart(env, partNumber);
-  std::string rules = info[2].As<Napi::String>().Utf8Value();
-  bool res = pactffi_with_matching_rules(interaction, part, rules.c_str());
+  InteractionPart part = integerToInteractionPart(env, info[1].As<Napi::Number>().Uint32Value());
+  Utf8Arg contentType(info[2]);
+  Utf8Arg path(info[3]);
+
+  MappedFile file;
+  std::string error;
+  if (!file.Open(path.c_str(), &error)) {
+    throw Napi::Error::New(env, "PactffiWithBinaryFilePath: " + error);
+  }
+
+  bool res = pactffi_with_binary_file(interaction, part, contentType.c_str(), file.data(), static_cast<size_t>(file.size()));
+  if (res) {
+    std::string absolutePath = AbsoluteFilePath(path.c_str());
+    JournalRecord(JOURNAL_WITH_BINARY_FILE_PATH, interaction, part, contentType.c_str(), absolutePath.c_str());
+  }
 
   return Napi::Boolean::New(env, res);
 }
 
+/**
+ * Add matching rules to the interaction. Matching rules are used to specify how the request
+ * or response should be matched. This is useful for specifying that certain parts of the request 
+ * or response are flexible, such as the date or time.
+ *
+ * * `interaction` - Interaction handle to set the body for.
+ * * `part` - Request or response part.
+ * * `rules` - JSON string of the matching rules to add to the interaction.
+ *
+ * C interface:
+ *
+ * bool pactffi_with_matching_rules(InteractionHandle interaction,
+ *                                  InteractionPart part,
+ *                                  const char *rules);
+ */
+JOURNALED_EXPORT(PactffiWithMatchingRules, pactffi_with_matching_rules, JOURNAL_WITH_MATCHING_RULES)
+
 /**
  * Adds a binary file as the body as a MIME multipart with the expected content type and example contents. Will use
  * a mime type matcher to match the body. Returns an error if the interaction or Pact can't be
@@ -1354,9 +1191,9 @@ Napi::Value PactffiWithMultipartFile(const Napi::CallbackInfo& info) {
   uint32_t partNumber = info[1].As<Napi::Number>().Uint32Value();
   InteractionPart part = integerToInteractionPart(env, partNumber);
 
-  std::string contentType = info[2].As<Napi::String>().Utf8Value();
-  std::string file = info[3].As<Napi::String>().Utf8Value();
-  std::string partName = info[4].As<Napi::String>().Utf8Value();
+  Utf8Arg contentType(info[2]);
+  Utf8Arg file(info[3]);
+  Utf8Arg partName(info[4]);
   std::string boundary = info.Length() > 5 ? info[5].As<Napi::String>().Utf8Value() : "";
   const char* boundaryPtr = boundary.empty() ? nullptr : boundary.c_str();
 
@@ -1365,6 +1202,7 @@ Napi::Value PactffiWithMultipartFile(const Napi::CallbackInfo& info) {
   // TODO: this will also break the https://github.com/pact-foundation/pact-js-core/tree/feat/ffi-consumer/src/consumer branch
   //       which expects a struct
   if (res.tag == StringResult::Tag::StringResult_Ok) {
+    JournalRecord(JOURNAL_WITH_MULTIPART_FILE, interaction, part, contentType.c_str(), file.c_str(), partName.c_str(), boundaryPtr);
     return env.Undefined();
   }
 
@@ -1374,6 +1212,224 @@ Napi::Value PactffiWithMultipartFile(const Napi::CallbackInfo& info) {
   throw Napi::Error::New(env, err);
 }
 
+// What the core matches a multipart content type header against, as the boundary will differ
+static const char kMultipartContentTypeRegex[] = "multipart/form-data;(\\s*charset=[^;]*;)?\\s*boundary=.*";
+
+struct MultipartPart {
+  std::string name;
+  std::string contentType;
+  std::string filename;
+  const uint8_t* data;
+  size_t size;
+};
+
+static std::string RandomBoundary() {
+  static thread_local std::mt19937_64 generator{std::random_device{}()};
+  static const char hex[] = "0123456789abcdef";
+  uint64_t bits = generator();
+  std::string boundary = "----pact-boundary-";
+  for (int i = 0; i < 16; i++) {
+    boundary.push_back(hex[(bits >> (4 * i)) & 0xf]);
+  }
+  return boundary;
+}
+
+// Quotes a Content-Disposition parameter, escaping quotes and line breaks as browsers do
+static void AppendQuoted(std::string& out, const std::string& value) {
+  out += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"': out += "%22"; break;
+      case '\r': out += "%0D"; break;
+      case '\n': out += "%0A"; break;
+      default: out += c;
+    }
+  }
+  out += '"';
+}
+
+// The body path of a part, as the core's multipart matching names it
+static std::string MultipartPartPath(const std::string& name) {
+  bool simple = !name.empty();
+  for (char c : name) {
+    simple = simple && (isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-');
+  }
+  if (simple) {
+    return "$." + name;
+  }
+
+  std::string path = "$['";
+  for (char c : name) {
+    if (c == '\'' || c == '\\') {
+      path += '\\';
+    }
+    path += c;
+  }
+  return path + "']";
+}
+
+/**
+ * Sets a MIME multipart body built from Buffers, so multipart bodies can be put together without
+ * writing each part to a file first (as `pactffiWithMultipartFile` needs). All the parts are given
+ * in one call, and replace any body already set for `part`. As with `pactffiWithMultipartFile`,
+ * each part is matched by its content type, and the content type header by its media type, as the
+ * boundary will differ from request to request.
+ *
+ * * `interaction` - Interaction handle to set the body for.
+ * * `part` - Request or response part.
+ * * `parts` - array of `{ name: string, contentType: string, body: Buffer, filename?: string }`.
+ * * `boundary` - the boundary to use in the example body. A random one is used if not given.
+ *
+ * Returns false if the interaction or Pact can't be modified (i.e. the mock server for it has
+ * already started). Throws if the boundary occurs in one of the parts.
+ *
+ * C interface: none, builds the body and calls `pactffi_with_header_v2`, `pactffi_with_binary_body`
+ * and `pactffi_with_matching_rules`.
+ */
+Napi::Value PactffiWithMultipartParts(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3) {
+    throw Napi::Error::New(env, "PactffiWithMultipartParts received < 3 arguments");
+  }
+
+  if (!info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiWithMultipartParts(arg 0) expected an InteractionHandle (uint32_t)");
+  }
+
+  if (!info[1].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiWithMultipartParts(arg 1) expected an InteractionPart (uint32_t)");
+  }
+
+  if (!info[2].IsArray() || info[2].As<Napi::Array>().Length() == 0) {
+    throw Napi::Error::New(env, "PactffiWithMultipartParts(arg 2) expected a non-empty array of parts");
+  }
+
+  if (info.Length() > 3 && !info[3].IsUndefined() && !info[3].IsString()) {
+    throw Napi::Error::New(env, "PactffiWithMultipartParts(arg 3) expected a string");
+  }
+
+  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
+  InteractionPart part = integerToInteractionPart(env, info[1].As<Napi::Number>().Uint32Value());
+
+  Napi::Array partValues = info[2].As<Napi::Array>();
+  std::vector<MultipartPart> parts;
+  parts.reserve(partValues.Length());
+  for (uint32_t i = 0; i < partValues.Length(); i++) {
+    std::string expected = "PactffiWithMultipartParts(arg 2) expected part " + std::to_string(i) + " to ";
+    Napi::Value value = partValues.Get(i);
+    if (!value.IsObject() || value.IsArray()) {
+      throw Napi::Error::New(env, expected + "be an object");
+    }
+    Napi::Object object = value.As<Napi::Object>();
+    Napi::Value name = object.Get("name");
+    Napi::Value contentType = object.Get("contentType");
+    Napi::Value body = object.Get("body");
+    Napi::Value filename = object.Get("filename");
+    if (!name.IsString()) {
+      throw Napi::Error::New(env, expected + "have a string 'name'");
+    }
+    if (!contentType.IsString()) {
+      throw Napi::Error::New(env, expected + "have a string 'contentType'");
+    }
+    if (!body.IsBuffer()) {
+      throw Napi::Error::New(env, expected + "have a Buffer 'body'");
+    }
+    if (!filename.IsUndefined() && !filename.IsString()) {
+      throw Napi::Error::New(env, expected + "have a string 'filename', if any");
+    }
+
+    Napi::Buffer<uint8_t> buffer = body.As<Napi::Buffer<uint8_t>>();
+    parts.push_back(MultipartPart{
+      name.As<Napi::String>().Utf8Value(),
+      contentType.As<Napi::String>().Utf8Value(),
+      filename.IsString() ? filename.As<Napi::String>().Utf8Value() : "",
+      buffer.Data(),
+      buffer.Length(),
+    });
+  }
+
+  bool given = info.Length() > 3 && info[3].IsString();
+  std::string boundary = given ? info[3].As<Napi::String>().Utf8Value() : RandomBoundary();
+  std::string delimiter = "--" + boundary;
+  for (size_t i = 0; i < parts.size(); i++) {
+    const uint8_t* end = parts[i].data + parts[i].size;
+    if (std::search(parts[i].data, end, delimiter.begin(), delimiter.end()) == end) {
+      continue;
+    }
+    if (given) {
+      throw Napi::Error::New(env, "PactffiWithMultipartParts(arg 3) occurs in part '" + parts[i].name + "'");
+    }
+    // Checked again from the first part with a new one
+    boundary = RandomBoundary();
+    delimiter = "--" + boundary;
+    i = static_cast<size_t>(-1);
+  }
+
+  size_t total = delimiter.size() + 4;
+  for (const MultipartPart& each : parts) {
+    total += delimiter.size() + each.name.size() + each.filename.size() + each.contentType.size() + each.size + 96;
+  }
+  std::string body;
+  body.reserve(total);
+  for (const MultipartPart& each : parts) {
+    body += delimiter;
+    body += "\r\nContent-Disposition: form-data; name=";
+    AppendQuoted(body, each.name);
+    if (!each.filename.empty()) {
+      body += "; filename=";
+      AppendQuoted(body, each.filename);
+    }
+    body += "\r\nContent-Type: ";
+    body += each.contentType;
+    body += "\r\n\r\n";
+    body.append(reinterpret_cast<const char*>(each.data), each.size);
+    body += "\r\n";
+  }
+  body += delimiter;
+  body += "--\r\n";
+
+  // Built as a JS object so the serialiser escapes the names and content types
+  Napi::Object bodyRules = Napi::Object::New(env);
+  for (const MultipartPart& each : parts) {
+    Napi::Object matcher = Napi::Object::New(env);
+    matcher.Set("match", "contentType");
+    matcher.Set("value", each.contentType);
+    Napi::Array matchers = Napi::Array::New(env, 1);
+    matchers.Set(uint32_t(0), matcher);
+    Napi::Object rule = Napi::Object::New(env);
+    rule.Set("combine", "AND");
+    rule.Set("matchers", matchers);
+    bodyRules.Set(MultipartPartPath(each.name), rule);
+  }
+  Napi::Object headerMatcher = Napi::Object::New(env);
+  headerMatcher.Set("match", "regex");
+  headerMatcher.Set("regex", kMultipartContentTypeRegex);
+  Napi::Array headerMatchers = Napi::Array::New(env, 1);
+  headerMatchers.Set(uint32_t(0), headerMatcher);
+  Napi::Object headerRule = Napi::Object::New(env);
+  headerRule.Set("combine", "AND");
+  headerRule.Set("matchers", headerMatchers);
+  Napi::Object headerRules = Napi::Object::New(env);
+  headerRules.Set("Content-Type", headerRule);
+  Napi::Object rules = Napi::Object::New(env);
+  rules.Set("body", bodyRules);
+  rules.Set("header", headerRules);
+  JsonArg rulesJson(rules);
+
+  std::string contentType = "multipart/form-data; boundary=" + boundary;
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(body.data());
+
+  bool res = JournalCall(JOURNAL_WITH_HEADER, pactffi_with_header_v2, interaction, part, "Content-Type", size_t(0), contentType.c_str());
+  res = res && pactffi_with_binary_body(interaction, part, contentType.c_str(), bytes, body.size());
+  if (res) {
+    JournalRecord(JOURNAL_WITH_BINARY_BODY, interaction, part, contentType.c_str(), JournalBytes{bytes, body.size()});
+  }
+  res = res && JournalCall(JOURNAL_WITH_MATCHING_RULES, pactffi_with_matching_rules, interaction, part, rulesJson.c_str());
+
+  return Napi::Boolean::New(env, res);
+}
+
 /**
  * Configures the response for the Interaction. Returns false if the interaction or Pact can't be
  * modified (i.e. the mock server for it has already started)
@@ -1398,27 +1454,204 @@ Napi::Value PactffiWithMultipartFile(const Napi::CallbackInfo& info) {
  *    bool pactffi_response_status_v2(InteractionHandle interaction,
  *                                const char *status);
  */
-Napi::Value PactffiResponseStatus(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
+JOURNALED_EXPORT(PactffiResponseStatus, pactffi_response_status_v2, JOURNAL_RESPONSE_STATUS)
+
+// The content type the interaction's body for `part` was last set with, to keep it for a body
+// override
+static std::string BodyContentType(InteractionHandle interaction, InteractionPart part) {
+  std::string prefix, args;
+  JournalCodec<InteractionPart>::Encode(prefix, part);
+  if (!JournalFind(interaction, JOURNAL_WITH_BODY, prefix, &args)) {
+    return "application/json";
+  }
+
+  JournalReader reader(args.data(), args.size());
+  reader.Int();
+  const char* contentType = reader.String();
+  return reader.failed() || contentType == NULL ? "application/json" : contentType;
+}
+
+static void CheckOverride(Napi::Env env, const char* key, bool valid, const char* expected) {
+  if (!valid) {
+    throw Napi::Error::New(env, std::string("PactffiCloneInteraction(arg 1) expected '") + key + "' to be " + expected);
+  }
+}
+
+// Overrides are applied after the copy is made, so a rejected one can only be reported
+static void CheckApplied(Napi::Env env, const char* key, bool applied) {
+  if (!applied) {
+    throw Napi::Error::New(env, std::string("PactffiCloneInteraction was unable to apply the '") + key + "' override");
+  }
+}
+
+static void CheckApplied(Napi::Env env, const char* key, Napi::Object results) {
+  Napi::Array names = results.GetPropertyNames();
+  for (uint32_t i = 0; i < names.Length(); i++) {
+    Napi::Value name = names.Get(i);
+    if (!results.Get(name).ToBoolean().Value()) {
+      throw Napi::Error::New(env, std::string("PactffiCloneInteraction was unable to apply the '") + key + "' override for '" +
+        name.ToString().Utf8Value() + "'");
+    }
+  }
+}
+
+/**
+ * Copies an HTTP interaction into a new interaction in the same pact, and applies `overrides` to
+ * the copy. The copy has everything the original was given through the binding: description,
+ * provider states, request, response, comments, keys and matching rules. Returns the new
+ * `InteractionHandle`.
+ *
+ * The copy is made by replaying, in native code, the calls that built the original (see
+ * journal.h), so a table of variants costs one call per variant however the original was built.
+ * The original's pact must record its interactions (see `pactffiEnableJournal`).
+ *
+ * `overrides` (only `description` is required, as descriptions must be unique):
+ *
+ * ```
+ * {
+ *   description: string,
+ *   method?: string,
+ *   path?: string,
+ *   query?: { [name]: value | value[] },           // as for pactffiWithQueryParameters
+ *   requestHeaders?: { [name]: value | value[] },  // as for pactffiWithHeaders
+ *   responseHeaders?: { [name]: value | value[] },
+ *   requestBody?: string | object,                 // with the original's content type
+ *   responseBody?: string | object,
+ *   status?: number | string,
+ * }
+ * ```
+ *
+ * Overrides set values rather than remove them: a header or query parameter that isn't
+ * overridden keeps the original's value. Interactions with plugin contents can't be copied.
+ * Throws, naming the override, if the core rejects one (the copy has been added to the pact by
+ * then, as the FFI has no way to remove it).
+ */
+Napi::Value PactffiCloneInteraction(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
 
   if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiResponseStatus received < 2 arguments");
+    throw Napi::Error::New(env, "PactffiCloneInteraction received < 2 arguments");
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiResponseStatus(arg 0) expected a number");
+    throw Napi::Error::New(env, "PactffiCloneInteraction(arg 0) expected a number");
+  }
+
+  if (!info[1].IsObject() || info[1].IsArray()) {
+    throw Napi::Error::New(env, "PactffiCloneInteraction(arg 1) expected an object");
+  }
+
+  InteractionHandle source = info[0].As<Napi::Number>().Uint32Value();
+  Napi::Object overrides = info[1].As<Napi::Object>();
+
+  // Everything is checked before the copy is made, so a bad override doesn't leave one behind
+  Napi::Value description = overrides.Get("description");
+  Napi::Value method = overrides.Get("method");
+  Napi::Value path = overrides.Get("path");
+  Napi::Value query = overrides.Get("query");
+  Napi::Value requestHeaders = overrides.Get("requestHeaders");
+  Napi::Value responseHeaders = overrides.Get("responseHeaders");
+  Napi::Value requestBody = overrides.Get("requestBody");
+  Napi::Value responseBody = overrides.Get("responseBody");
+  Napi::Value status = overrides.Get("status");
+
+  CheckOverride(env, "description", description.IsString(), "a string");
+  CheckOverride(env, "method", method.IsUndefined() || method.IsString(), "a string");
+  CheckOverride(env, "path", path.IsUndefined() || path.IsString(), "a string");
+  for (auto entries : {std::make_pair("query", query), std::make_pair("requestHeaders", requestHeaders), std::make_pair("responseHeaders", responseHeaders)}) {
+    bool valid = entries.second.IsUndefined() || (entries.second.IsObject() && !entries.second.IsArray());
+    CheckOverride(env, entries.first, valid, "an object");
+    if (!entries.second.IsUndefined()) {
+      CheckEntries(env, "PactffiCloneInteraction", 1, entries.second.As<Napi::Object>());
+    }
   }
+  CheckOverride(env, "requestBody", requestBody.IsUndefined() || IsBodyValue(requestBody), "a string or an object");
+  CheckOverride(env, "responseBody", responseBody.IsUndefined() || IsBodyValue(responseBody), "a string or an object");
+  CheckOverride(env, "status", status.IsUndefined() || status.IsNumber() || status.IsString(), "a number or a string");
 
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiResponseStatus(arg 1) expected a string");
+  PactHandle pact = 0;
+  JournalReplayResult result = JournalReplayable(source, &pact);
+
+  Utf8Arg descriptionArg(description);
+  InteractionHandle clone = 0;
+  if (result == JOURNAL_REPLAYED) {
+    clone = pactffi_new_interaction(pact, descriptionArg.c_str());
+    JournalInteraction(pact, clone, descriptionArg.c_str());
+    result = JournalReplay(source, clone);
   }
 
-  InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
-  std::string status = info[1].As<Napi::String>().Utf8Value();
+  switch (result) {
+    case JOURNAL_REPLAYED:
+      break;
+    case JOURNAL_UNSUPPORTED:
+      throw Napi::Error::New(env, "PactffiCloneInteraction(arg 0) has plugin contents, which can't be copied");
+    case JOURNAL_NOT_FOUND:
+      throw Napi::Error::New(env, "PactffiCloneInteraction(arg 0) is not an interaction of a pact with journaling enabled (see pactffiEnableJournal)");
+    case JOURNAL_FAILED:
+      throw Napi::Error::New(env, "PactffiCloneInteraction was unable to copy the interaction (the pact can't be modified once its mock server has started)");
+  }
+
+  // The replay sets the source's description again, if it was set with pactffiUponReceiving
+  if (!JournalCall(JOURNAL_UPON_RECEIVING, pactffi_upon_receiving, clone, descriptionArg.c_str())) {
+    throw Napi::Error::New(env, "PactffiCloneInteraction was unable to set the description of the copy");
+  }
+
+  if (!method.IsUndefined() || !path.IsUndefined()) {
+    std::string methodValue = "GET";
+    std::string pathValue = "/";
+    std::string args;
+    if (JournalFind(clone, JOURNAL_WITH_REQUEST, "", &args)) {
+      JournalReader reader(args.data(), args.size());
+      const char* recordedMethod = reader.String();
+      const char* recordedPath = reader.String();
+      if (!reader.failed() && recordedMethod != NULL && recordedPath != NULL) {
+        methodValue = recordedMethod;
+        pathValue = recordedPath;
+      }
+    }
+    if (!method.IsUndefined()) {
+      methodValue = method.As<Napi::String>().Utf8Value();
+    }
+    if (!path.IsUndefined()) {
+      pathValue = path.As<Napi::String>().Utf8Value();
+    }
 
-  bool res = pactffi_response_status_v2(interaction, status.c_str());
+    bool applied = pactffi_with_request(clone, methodValue.c_str(), pathValue.c_str());
+    if (applied) {
+      JournalRecord(JOURNAL_WITH_REQUEST, clone, methodValue.c_str(), pathValue.c_str());
+    }
+    CheckApplied(env, method.IsUndefined() ? "path" : "method", applied);
+  }
 
-  return Napi::Boolean::New(env, res);
+  if (!query.IsUndefined()) {
+    CheckApplied(env, "query", SetQueryParameters(env, "PactffiCloneInteraction", 1, clone, query.As<Napi::Object>()));
+  }
+  if (!requestHeaders.IsUndefined()) {
+    CheckApplied(env, "requestHeaders",
+      SetHeaders(env, "PactffiCloneInteraction", 1, clone, InteractionPart::InteractionPart_Request, requestHeaders.As<Napi::Object>()));
+  }
+  if (!responseHeaders.IsUndefined()) {
+    CheckApplied(env, "responseHeaders",
+      SetHeaders(env, "PactffiCloneInteraction", 1, clone, InteractionPart::InteractionPart_Response, responseHeaders.As<Napi::Object>()));
+  }
+  if (!requestBody.IsUndefined()) {
+    std::string contentType = BodyContentType(clone, InteractionPart::InteractionPart_Request);
+    CheckApplied(env, "requestBody", SetBody(clone, InteractionPart::InteractionPart_Request, contentType.c_str(), requestBody));
+  }
+  if (!responseBody.IsUndefined()) {
+    std::string contentType = BodyContentType(clone, InteractionPart::InteractionPart_Response);
+    CheckApplied(env, "responseBody", SetBody(clone, InteractionPart::InteractionPart_Response, contentType.c_str(), responseBody));
+  }
+  if (!status.IsUndefined()) {
+    std::string statusValue = status.IsNumber() ? std::to_string(status.As<Napi::Number>().Int64Value()) : status.As<Napi::String>().Utf8Value();
+    bool applied = pactffi_response_status_v2(clone, statusValue.c_str());
+    if (applied) {
+      JournalRecord(JOURNAL_RESPONSE_STATUS, clone, statusValue.c_str());
+    }
+    CheckApplied(env, "status", applied);
+  }
+
+  return Napi::Number::New(env, clone);
 }
 
 /**
@@ -1575,26 +1808,10 @@ Napi::Value PactffiResponseStatus(const Napi::CallbackInfo& info) {
  *
  */
 Napi::Value PactffiNewAsyncMessage(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiNewAsyncMessage received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiNewAsyncMessage(arg 0) expected a PactHandle (uint16_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiNewAsyncMessage(arg 1) expected a string");
-  }
-
-  PactHandle pact = info[0].As<Napi::Number>().Int32Value();
-  std::string description = info[1].As<Napi::String>().Utf8Value();
-
-  MessageHandle handle = pactffi_new_async_message(pact, description.c_str());
-
-  return Napi::Number::New(env, handle);
+  Napi::Value result = CallTyped(info, "PactffiNewAsyncMessage", pactffi_new_async_message);
+  // Messages aren't journaled, so the pact can no longer be snapshotted
+  JournalPactUnsupported(info[0].As<Napi::Number>().Uint32Value());
+  return result;
 }
 
 /**
@@ -1609,26 +1826,9 @@ Napi::Value PactffiNewAsyncMessage(const Napi::CallbackInfo& info) {
  *
  */
 Napi::Value PactffiNewSyncMessage(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiNewSyncMessage received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiNewSyncMessage(arg 0) expected a PactHandle (uint16_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiNewSyncMessage(arg 1) expected a string");
-  }
-
-  PactHandle pact = info[0].As<Napi::Number>().Int32Value();
-  std::string description = info[1].As<Napi::String>().Utf8Value();
-
-  InteractionHandle handle = pactffi_new_sync_message_interaction(pact, description.c_str());
-
-  return Napi::Number::New(env, handle);
+  Napi::Value result = CallTyped(info, "PactffiNewSyncMessage", pactffi_new_sync_message_interaction);
+  JournalPactUnsupported(info[0].As<Napi::Number>().Uint32Value());
+  return result;
 }
 
 /**
@@ -1675,28 +1875,7 @@ Napi::Value PactffiNewSyncMessage(const Napi::CallbackInfo& info) {
  *
  * void pactffi_message_expects_to_receive(MessageHandle message, const char *description);
  */
-Napi::Value PactffiMessageExpectsToReceive(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiMessageExpectsToReceive received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiMessageExpectsToReceive(arg 0) expected a MessageHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiMessageExpectsToReceive(arg 1) expected a string");
-  }
-
-  MessageHandle handle = info[0].As<Napi::Number>().Uint32Value();
-  std::string desc = info[1].As<Napi::String>().Utf8Value();
-
-  pactffi_message_expects_to_receive(handle, desc.c_str());
-
-  return env.Undefined();
-}
+TYPED_EXPORT(PactffiMessageExpectsToReceive, pactffi_message_expects_to_receive)
 
 /**
  * Adds a provider state to the Interaction.
@@ -1709,27 +1888,7 @@ Napi::Value PactffiMessageExpectsToReceive(const Napi::CallbackInfo& info) {
  *
  *    void pactffi_message_given(MessageHandle message, const char *description);
  */
-Napi::Value PactffiMessageGiven(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiMessageGiven received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiMessageGiven(arg 0) expected a MessageHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiMessageGiven(arg 1) expected a string");
-  }
-  MessageHandle handle = info[0].As<Napi::Number>().Uint32Value();
-  std::string desc = info[1].As<Napi::String>().Utf8Value();
-
-  pactffi_message_given(handle, desc.c_str());
-
-  return env.Undefined();
-}
+TYPED_EXPORT(PactffiMessageGiven, pactffi_message_given)
 
 /**
  * Adds a provider state to the Message with a parameter key and value.
@@ -1745,38 +1904,7 @@ Napi::Value PactffiMessageGiven(const Napi::CallbackInfo& info) {
  *                                           const char *name,
  *                                           const char *value);
  */
-Napi::Value PactffiMessageGivenWithParam(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 4) {
-    throw Napi::Error::New(env, "PactffiMessageGivenWithParam received < 4 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiMessageGivenWithParam(arg 0) expected a MessageHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiMessageGivenWithParam(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiMessageGivenWithParam(arg 2) expected a string");
-  }
-
-  if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "PactffiMessageGivenWithParam(arg 3) expected a string");
-  }
-
-  MessageHandle handle = info[0].As<Napi::Number>().Uint32Value();
-  std::string desc = info[1].As<Napi::String>().Utf8Value();
-  std::string name = info[2].As<Napi::String>().Utf8Value();
-  std::string value = info[3].As<Napi::String>().Utf8Value();
-
-  pactffi_message_given_with_param(handle, desc.c_str(), name.c_str(), value.c_str());
-
-  return env.Undefined();
-}
+TYPED_EXPORT(PactffiMessageGivenWithParam, pactffi_message_given_with_param)
 
 /**
  * Adds the contents of the Message.
@@ -1823,7 +1951,7 @@ Napi::Value PactffiMessageWithBinaryContents(const Napi::CallbackInfo& info) {
   }
 
   MessageHandle handle = info[0].As<Napi::Number>().Uint32Value();
-  std::string contentType = info[1].As<Napi::String>().Utf8Value();
+  Utf8Arg contentType(info[1]);
   Napi::Buffer<uint8_t> buffer = info[2].As<Napi::Buffer<uint8_t>>();
   size_t size = info[3].As<Napi::Number>().Uint32Value();
    
@@ -1843,6 +1971,9 @@ Napi::Value PactffiMessageWithBinaryContents(const Napi::CallbackInfo& info) {
  * * `content_type` - Expected content type (e.g. application/json, application/octet-stream)
  * * `size` - number of bytes in the message body to read. This is not required for text bodies (JSON, XML, etc.).
  *
+ * The contents may also be given as a JS object or array, which is serialised to JSON natively
+ * as for PactffiWithBody.
+ *
  * C interface:
  *
  *     void pactffi_message_with_contents(MessageHandle message_handle,
@@ -1865,15 +1996,20 @@ Napi::Value PactffiMessageWithContents(const Napi::CallbackInfo& info) {
     throw Napi::Error::New(env, "PactffiMessageWithContents(arg 1) expected a string");
   }
 
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiMessageWithContents(arg 2) expected a string");
+  if (!IsBodyValue(info[2])) {
+    throw Napi::Error::New(env, "PactffiMessageWithContents(arg 2) expected a string or an object");
   }
 
   MessageHandle handle = info[0].As<Napi::Number>().Uint32Value();
-  std::string contentType = info[1].As<Napi::String>().Utf8Value();
-  std::string buffer = info[2].As<Napi::String>().Utf8Value();
+  Utf8Arg contentType(info[1]);
 
-  pactffi_message_with_contents(handle, contentType.c_str(), (unsigned char *)buffer.c_str(), 0);
+  if (info[2].IsString()) {
+    Utf8Arg buffer(info[2]);
+    pactffi_message_with_contents(handle, contentType.c_str(), (unsigned char *)buffer.c_str(), 0);
+  } else {
+    JsonArg buffer(info[2]);
+    pactffi_message_with_contents(handle, contentType.c_str(), (unsigned char *)buffer.c_str(), 0);
+  }
 
   return env.Undefined();
 }
@@ -1903,33 +2039,7 @@ Napi::Value PactffiMessageWithContents(const Napi::CallbackInfo& info) {
  *                                    const char *key,
  *                                    const char *value);
  */
-Napi::Value PactffiMessageWithMetadata(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 3) {
-    throw Napi::Error::New(env, "PactffiMessageWithMetadata received < 3 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiMessageWithMetadata(arg 0) expected a MessageHandle (uint32_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiMessageWithMetadata(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiMessageWithMetadata(arg 2) expected a string");
-  }
-
-  MessageHandle handle = info[0].As<Napi::Number>().Uint32Value();
-  std::string key = info[1].As<Napi::String>().Utf8Value();
-  std::string value = info[2].As<Napi::String>().Utf8Value();
-
-  pactffi_message_with_metadata_v2(handle, key.c_str(), value.c_str());
-
-  return env.Undefined();
-}
+TYPED_EXPORT(PactffiMessageWithMetadata, pactffi_message_with_metadata_v2)
 
 /**
  * Reifies the given message
@@ -1954,9 +2064,9 @@ Napi::Value PactffiMessageReify(const Napi::CallbackInfo& info) {
 
   MessageHandle handle = info[0].As<Napi::Number>().Uint32Value();
 
-  auto res = pactffi_message_reify(handle);
+  FfiString res(pactffi_message_reify(handle));
 
-  return Napi::String::New(env, res);
+  return res.ToValue(env);
 }
 
 /**
@@ -1991,31 +2101,10 @@ Napi::Value PactffiMessageReify(const Napi::CallbackInfo& info) {
  *                                      const char *plugin_version);
  */
 Napi::Value PactffiUsingPlugin(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 3) {
-    throw Napi::Error::New(env, "PactffiUsingPlugin received < 3 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiUsingPlugin(arg 0) expected a PactHandle (uint16_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiUsingPlugin(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiUsingPlugin(arg 2) expected a string");
-  }
-
-  PactHandle pact = info[0].As<Napi::Number>().Int32Value();
-  std::string name = info[1].As<Napi::String>().Utf8Value();
-  std::string version = info[2].As<Napi::String>().Utf8Value();
-
-  uint16_t result = pactffi_using_plugin(pact, name.c_str(), version.c_str());
-
-  return Number::New(env, result);
+  Napi::Value result = CallTyped(info, "PactffiUsingPlugin", pactffi_using_plugin);
+  // Plugin contents can't be replayed, so the pact can no longer be snapshotted
+  JournalPactUnsupported(info[0].As<Napi::Number>().Uint32Value());
+  return result;
 }
 
 /**
@@ -2040,36 +2129,9 @@ Napi::Value PactffiUsingPlugin(const Napi::CallbackInfo& info) {
  *                                                 uint64_t completion_delay);
  */
 Napi::Value PactffiUsingPluginWithDelay(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 4) {
-    throw Napi::Error::New(env, "PactffiUsingPluginWithDelay received < 4 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiUsingPluginWithDelay(arg 0) expected a PactHandle (uint16_t)");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiUsingPluginWithDelay(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiUsingPluginWithDelay(arg 2) expected a string");
-  }
-
-  if (!info[3].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiUsingPluginWithDelay(arg 3) expected a number");
-  }
-
-  PactHandle pact = info[0].As<Napi::Number>().Int32Value();
-  std::string name = info[1].As<Napi::String>().Utf8Value();
-  std::string version = info[2].As<Napi::String>().Utf8Value();
-  uint64_t completionDelay = info[3].As<Napi::Number>().Int64Value();
-
-  uint16_t result = pactffi_using_plugin_with_delay(pact, name.c_str(), version.c_str(), completionDelay);
-
-  return Number::New(env, result);
+  Napi::Value result = CallTyped(info, "PactffiUsingPluginWithDelay", pactffi_using_plugin_with_delay);
+  JournalPactUnsupported(info[0].As<Napi::Number>().Uint32Value());
+  return result;
 }
 
 /**
@@ -2091,7 +2153,9 @@ Napi::Value PactffiSetTestRunId(const Napi::CallbackInfo& info) {
     throw Napi::Error::New(env, "PactffiSetTestRunId(arg 0) expected a string");
   }
 
-  std::string testRunId = info[0].As<Napi::String>().Utf8Value();
+  Utf8Arg testRunId(info[0]);
+
+  TestLogsSetActive(env, testRunId.str());
 
   if (testRunId.empty()) {
     pactffi_set_test_run_id(NULL);
@@ -2110,23 +2174,7 @@ Napi::Value PactffiSetTestRunId(const Napi::CallbackInfo& info) {
  *
  *    void pactffi_cleanup_plugins(PactHandle pact);
  */
-Napi::Value PactffiCleanupPlugins(const Napi::CallbackInfo& info) {
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiUsingPlugin received < 1 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiUsingPlugin(arg 0) expected a PactHandle (uint16_t)");
-  }
-
-  PactHandle pact = info[0].As<Napi::Number>().Int32Value();
-
-  pactffi_cleanup_plugins(pact);
-
-  return env.Undefined();
-}
+TYPED_EXPORT(PactffiCleanupPlugins, pactffi_cleanup_plugins)
 
 /**
  * Setup the interaction part using a plugin. The contents is a JSON string that will be passed on to
@@ -2188,10 +2236,12 @@ Napi::Value PactffiPluginInteractionContents(const Napi::CallbackInfo& info) {
   InteractionHandle interaction = info[0].As<Napi::Number>().Uint32Value();
   uint32_t partNumber = info[1].As<Napi::Number>().Uint32Value();
   InteractionPart part = integerToInteractionPart(env, partNumber);
-  std::string contentType = info[2].As<Napi::String>().Utf8Value();
-  std::string contents = info[3].As<Napi::String>().Utf8Value();
+  Utf8Arg contentType(info[2]);
+  Utf8Arg contents(info[3]);
 
   bool res = pactffi_interaction_contents(interaction, part, contentType.c_str(), contents.c_str());
+  // Plugin contents can't be replayed without the plugin, so the interaction can't be cloned
+  JournalUnsupported(interaction);
 
   return Napi::Boolean::New(env, res);
 }
@@ -2240,13 +2290,13 @@ Napi::Value PactffiGetAsyncMessageRequestContents(const Napi::CallbackInfo& info
   uint32_t message_count = info[1].As<Napi::Number>().Uint32Value();
   uint32_t message_index = info[2].As<Napi::Number>().Uint32Value();
 
-  struct PactMessageIterator *iter = pactffi_pact_handle_get_message_iter(pact);
-  if (iter == nullptr) {
+  MessageIterPtr iter(pactffi_pact_handle_get_message_iter(pact));
+  if (iter.isNull()) {
     throw Napi::Error::New(env, "Unable to get a message iterator");
   }
 
   for (uint32_t i = 0; i < message_count; i++) {
-    struct Message *message = pactffi_pact_message_iter_next(iter);
+    struct Message *message = pactffi_pact_message_iter_next(iter.get());
     
     if (i == message_index) {
       if (message == nullptr) {
@@ -2314,13 +2364,13 @@ Napi::Value PactffiGetSyncMessageRequestContents(const Napi::CallbackInfo& info)
   uint32_t message_count = info[1].As<Napi::Number>().Uint32Value();
   uint32_t message_index = info[2].As<Napi::Number>().Uint32Value();
 
-  struct PactSyncMessageIterator *iter = pactffi_pact_handle_get_sync_message_iter(pact);
-  if (iter == nullptr) {
+  SyncMessageIterPtr iter(pactffi_pact_handle_get_sync_message_iter(pact));
+  if (iter.isNull()) {
     throw Napi::Error::New(env, "Unable to get a sync message iterator");
   }
 
   for (uint32_t i = 0; i < message_count; i++) {
-    struct SynchronousMessage *message = pactffi_pact_sync_message_iter_next(iter);
+    struct SynchronousMessage *message = pactffi_pact_sync_message_iter_next(iter.get());
     
     if (i == message_index) {
       if (message == nullptr) {
@@ -2389,13 +2439,13 @@ Napi::Value PactffiGetSyncMessageResponseContents(const Napi::CallbackInfo& info
   uint32_t message_count = info[1].As<Napi::Number>().Uint32Value();
   uint32_t message_index = info[2].As<Napi::Number>().Uint32Value();
 
-  struct PactSyncMessageIterator *iter = pactffi_pact_handle_get_sync_message_iter(pact);
-  if (iter == nullptr) {
+  SyncMessageIterPtr iter(pactffi_pact_handle_get_sync_message_iter(pact));
+  if (iter.isNull()) {
     throw Napi::Error::New(env, "Unable to get a sync message iterator");
   }
 
   for (uint32_t i = 0; i < message_count; i++) {
-    struct SynchronousMessage *message = pactffi_pact_sync_message_iter_next(iter);
+    struct SynchronousMessage *message = pactffi_pact_sync_message_iter_next(iter.get());
     
     if (i == message_index) {
       if (message == nullptr) {
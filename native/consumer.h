@@ -2,13 +2,17 @@
 
 Napi::Value PactffiUponReceiving(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithBinaryFile(const Napi::CallbackInfo& info);
+Napi::Value PactffiWithBinaryFilePath(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithMatchingRules(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithBody(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithHeader(const Napi::CallbackInfo& info);
+Napi::Value PactffiWithHeaders(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithMessagePactMetadata(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithMultipartFile(const Napi::CallbackInfo& info);
+Napi::Value PactffiWithMultipartParts(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithPactMetadata(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithQueryParameter(const Napi::CallbackInfo& info);
+Napi::Value PactffiWithQueryParameters(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithRequest(const Napi::CallbackInfo& info);
 Napi::Value PactffiWithSpecification(const Napi::CallbackInfo& info);
 Napi::Value PactffiWritePactFile(const Napi::CallbackInfo& info);
@@ -29,7 +33,9 @@ Napi::Value PactffiMockServerMatched(const Napi::CallbackInfo& info);
 Napi::Value PactffiMockServerMismatches(const Napi::CallbackInfo& info);
 Napi::Value PactffiNewAsyncMessage(const Napi::CallbackInfo& info);
 Napi::Value PactffiNewInteraction(const Napi::CallbackInfo& info);
+Napi::Value PactffiCloneInteraction(const Napi::CallbackInfo& info);
 Napi::Value PactffiNewPact(const Napi::CallbackInfo& info);
+Napi::Value PactffiFreePactHandle(const Napi::CallbackInfo& info);
 
 // Message Pact
 Napi::Value PactffiNewAsyncMessage(const Napi::CallbackInfo& info);
@@ -59,7 +65,6 @@ Napi::Value PactffiPluginInteractionContents(const Napi::CallbackInfo& info);
 // Unimplemented
 Napi::Value PactffiConsumerGetName(const Napi::CallbackInfo& info);
 Napi::Value PactffiFreeMessagePactHandle(const Napi::CallbackInfo& info);
-Napi::Value PactffiFreePactHandle(const Napi::CallbackInfo& info);
 Napi::Value PactffiGenerateDatetimeString(const Napi::CallbackInfo& info);
 Napi::Value PactffiGenerateRegexValue(const Napi::CallbackInfo& info);
 Napi::Value PactffiGetErrorMessage(const Napi::CallbackInfo& info);
@@ -1,5 +1,8 @@
 #include <napi.h>
+#include <vector>
 #include "pact-cpp.h"
+#include "marshal.h"
+#include "typed_export.h"
 
 using namespace Napi;
 
@@ -9,45 +12,9 @@ Napi::Value PactffiVersion(const Napi::CallbackInfo& info) {
   return Napi::String::New(info.Env(), version);
 }
 
-Napi::Value PactffiInit(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
-
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) received < 1 argument");
-  }
-
-  if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) expected a string");
-  }
-
-  // Extract log level environment variable
-  std::string envVar = info[0].As<Napi::String>().Utf8Value();
-
-  // Initialise Pact
-  pactffi_init_with_log_level(envVar.c_str());
-
-  return env.Undefined();
-}
-
-Napi::Value PactffiInitWithLogLevel(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
-
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiInitWithLogLevel(logLevel) received < 1 argument");
-  }
-
-  if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiInitWithLogLevel(logLevel) expected a string");
-  }
+TYPED_EXPORT(PactffiInit, pactffi_init_with_log_level)
 
-  // Extract log level
-  std::string logLevel = info[0].As<Napi::String>().Utf8Value();
-
-  // Initialise Pact
-  pactffi_init_with_log_level(logLevel.c_str());
-
-  return env.Undefined();
-}
+TYPED_EXPORT(PactffiInitWithLogLevel, pactffi_init_with_log_level)
 
 LevelFilter integerToLevelFilter(Napi::Env &env, uint32_t number) {
   LevelFilter logLevel = LevelFilter::LevelFilter_Off;
@@ -81,126 +48,117 @@ LevelFilter integerToLevelFilter(Napi::Env &env, uint32_t number) {
   return logLevel;
 }
 
-
-Napi::Value PactffiLogToFile(const Napi::CallbackInfo& info) {
-   // return: int
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiLogToFile(envVar) received < 2 arguments");
-  }
-
-    if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiLogToFile(envVar) expected a string");
-  }
-
-  if (!info[1].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiLogToFile(envVar) expected a number");
-  }
-
-  // Extract log level
-  std::string fileName = info[0].As<Napi::String>().Utf8Value();
-  uint32_t levelFilterNumber = info[1].As<Napi::Number>().Uint32Value();
-  LevelFilter levelFilter = integerToLevelFilter(env, levelFilterNumber);
-
-  int res = pactffi_log_to_file(fileName.c_str(), levelFilter);
-
-  return Napi::Number::New(env, res);
-}
-/*
-
-Napi::Value Pactffi_log_message(const Napi::CallbackInfo& info) {
-   // return: void
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 3) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) received < 1 argument");
-  }
-
-  if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) expected a string");
-  }
-
-  // pactffi_log_message(const char *source, const char *log_level, const char *message);
-
-  pactffi_log_message(const char *source, const char *log_level, const char *message);
-
-  return info.Env().Undefined();
-}
-
-Napi::Value Pactffi_log_to_stdout(const Napi::CallbackInfo& info) {
-   // return: int
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) received < 1 argument");
-  }
-
-  if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) expected a string");
-  }
-
-  // pactffi_log_to_stdout(LevelFilter level_filter);
-
-  pactffi_log_to_stdout(LevelFilter level_filter);
-
-  return info.Env().Undefined();
-}
-
-Napi::Value Pactffi_log_to_stderr(const Napi::CallbackInfo& info) {
-   // return: int
-   Napi::Env env = info.Env();
+/**
+ * Convenience function to direct all logging to a file.
+ *
+ * C interface:
+ *
+ *    int pactffi_log_to_file(const char *file_name, LevelFilter level_filter);
+ */
+TYPED_EXPORT(PactffiLogToFile, pactffi_log_to_file)
+
+/**
+ * Convenience function to direct all logging to stdout.
+ *
+ * C interface:
+ *
+ *    int pactffi_log_to_stdout(LevelFilter level_filter);
+ */
+TYPED_EXPORT(PactffiLogToStdout, pactffi_log_to_stdout)
+
+/**
+ * Convenience function to direct all logging to stderr.
+ *
+ * C interface:
+ *
+ *    int pactffi_log_to_stderr(LevelFilter level_filter);
+ */
+TYPED_EXPORT(PactffiLogToStderr, pactffi_log_to_stderr)
+
+/**
+ * Convenience function to direct all logging to a task local memory buffer. The contents can
+ * be read back with `pactffi_fetch_log_buffer`.
+ *
+ * C interface:
+ *
+ *    int pactffi_log_to_buffer(LevelFilter level_filter);
+ */
+TYPED_EXPORT(PactffiLogToBuffer, pactffi_log_to_buffer)
+
+/**
+ * Installs several log sinks in one call, each with its own level filter.
+ *
+ * `sinks` is an array of `{ specifier: string, level: number }` objects, where the specifier
+ * is one of `stdout`, `stderr`, `buffer` or `file <path>`. All of the sinks are validated
+ * before the logger is touched, so a bad entry leaves the core logger unconfigured rather than
+ * half applied.
+ *
+ * The level filter is attached to each sink inside the core, so a record is only formatted for
+ * the sinks whose filter accepts it. A `trace` file sink next to an `error` stderr sink does not
+ * pay for formatting trace records on the console.
+ *
+ * Returns 0 on success, or the first negative error code from the core:
+ *
+ * | Error | Description |
+ * |-------|-------------|
+ * | -1 | Can't set the logger (it has already been applied) |
+ * | -2 | No logger has been initialised |
+ * | -3 | The sink specifier was not UTF-8 encoded |
+ * | -4 | The sink type specified is not a known type |
+ * | -5 | No file path was specified in a file-type sink specification |
+ * | -6 | Opening a sink to the specified file path failed |
+ * | -7 | Can't construct the sink |
+ *
+ * C interface:
+ *
+ *    void pactffi_logger_init(void);
+ *    int pactffi_logger_attach_sink(const char *sink_specifier, LevelFilter level_filter);
+ *    int pactffi_logger_apply(void);
+ */
+Napi::Value PactffiLogToSinks(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
 
   if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) received < 1 argument");
+    throw Napi::Error::New(env, "PactffiLogToSinks(sinks) received < 1 argument");
   }
 
-  if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) expected a string");
+  if (!info[0].IsArray()) {
+    throw Napi::Error::New(env, "PactffiLogToSinks(sinks) expected an array");
   }
 
-  // pactffi_log_to_stderr(LevelFilter level_filter);
-
-  pactffi_log_to_stderr(LevelFilter level_filter);
+  Napi::Array sinks = info[0].As<Napi::Array>();
+  std::vector<std::pair<std::string, LevelFilter>> specifiers;
 
-  return info.Env().Undefined();
-}
+  for (uint32_t i = 0; i < sinks.Length(); i++) {
+    Napi::Value entry = sinks.Get(i);
+    if (!entry.IsObject()) {
+      throw Napi::Error::New(env, "PactffiLogToSinks(sinks) expected each sink to be an object");
+    }
 
-Napi::Value Pactffi_log_to_file(const Napi::CallbackInfo& info) {
-   // return: int
-   Napi::Env env = info.Env();
+    Napi::Object sink = entry.As<Napi::Object>();
+    if (!sink.Get("specifier").IsString()) {
+      throw Napi::Error::New(env, "PactffiLogToSinks(sinks) expected sink.specifier to be a string");
+    }
 
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) received < 1 argument");
-  }
+    if (!sink.Get("level").IsNumber()) {
+      throw Napi::Error::New(env, "PactffiLogToSinks(sinks) expected sink.level to be a number");
+    }
 
-  if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) expected a string");
+    std::string specifier = sink.Get("specifier").As<Napi::String>().Utf8Value();
+    uint32_t levelFilterNumber = sink.Get("level").As<Napi::Number>().Uint32Value();
+    specifiers.emplace_back(specifier, integerToLevelFilter(env, levelFilterNumber));
   }
 
-  // pactffi_log_to_file(const char *file_name, LevelFilter level_filter);
-
-  pactffi_log_to_file(const char *file_name, LevelFilter level_filter);
+  pactffi_logger_init();
 
-  return info.Env().Undefined();
-}
-
-Napi::Value Pactffi_log_to_buffer(const Napi::CallbackInfo& info) {
-   // return: int
-   Napi::Env env = info.Env();
-
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) received < 1 argument");
+  for (const auto& sink : specifiers) {
+    int res = pactffi_logger_attach_sink(sink.first.c_str(), sink.second);
+    if (res != 0) {
+      return Napi::Number::New(env, res);
+    }
   }
 
-  if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiInit(envVar) expected a string");
-  }
-
-  // pactffi_log_to_buffer(LevelFilter level_filter);
+  int res = pactffi_logger_apply();
 
-  pactffi_log_to_buffer(LevelFilter level_filter);
-
-  return info.Env().Undefined();
+  return Napi::Number::New(env, res);
 }
-*/
\ No newline at end of file
@@ -0,0 +1,664 @@
+#include <napi.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "pact-cpp.h"
+#include "import.h"
+#include "journal.h"
+#include "json.h"
+#include "marshal.h"
+
+// V8 can't make a string longer than this (in UTF-16 code units, which a UTF-8 byte count bounds)
+static const uint64_t kMaxSourceBytes = (1u << 29) - 24;
+
+// Reads a pact file, giving up once it is larger than can be parsed
+static bool ReadSource(const char* path, std::string* contents, std::string* error) {
+  FILE* file = fopen(path, "rb");
+  if (file == NULL) {
+    *error = std::string("unable to open ") + path + ": " + strerror(errno);
+    return false;
+  }
+
+  char chunk[65536];
+  size_t read;
+  while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0 && contents->size() <= kMaxSourceBytes) {
+    contents->append(chunk, read);
+  }
+  bool failed = ferror(file) != 0;
+  fclose(file);
+  if (failed) {
+    *error = std::string("unable to read ") + path;
+    return false;
+  }
+  return true;
+}
+
+// A pact being imported, freed (with its journals) unless the import gets as far as returning it
+class ImportedPact {
+  public:
+    explicit ImportedPact(PactHandle handle) : handle(handle) {}
+    ~ImportedPact() {
+      if (handle != 0) {
+        pactffi_free_pact_handle(handle);
+        JournalFreePact(handle);
+      }
+    }
+
+    ImportedPact(const ImportedPact&) = delete;
+    ImportedPact& operator=(const ImportedPact&) = delete;
+
+    PactHandle get() const { return handle; }
+    PactHandle release() {
+      PactHandle released = handle;
+      handle = 0;
+      return released;
+    }
+
+  private:
+    PactHandle handle;
+};
+
+// The specification a pact file was written for, from `metadata.pactSpecification.version`
+// ("3.0.0", "1.1", ...). Files without one are read as V3, as the core does.
+static PactSpecification SpecificationOf(Napi::Value metadata) {
+  if (!metadata.IsObject()) {
+    return PactSpecification::PactSpecification_V3;
+  }
+  Napi::Value specification = metadata.As<Napi::Object>().Get("pactSpecification");
+  if (!specification.IsObject()) {
+    return PactSpecification::PactSpecification_V3;
+  }
+  Napi::Value version = specification.As<Napi::Object>().Get("version");
+  if (!version.IsString()) {
+    return PactSpecification::PactSpecification_V3;
+  }
+
+  std::string text = version.As<Napi::String>().Utf8Value();
+  char* end;
+  long major = strtol(text.c_str(), &end, 10);
+  long minor = *end == '.' ? strtol(end + 1, NULL, 10) : 0;
+  switch (major) {
+    case 1:
+      return minor >= 1 ? PactSpecification::PactSpecification_V1_1 : PactSpecification::PactSpecification_V1;
+    case 2:
+      return PactSpecification::PactSpecification_V2;
+    case 4:
+      return PactSpecification::PactSpecification_V4;
+    default:
+      return PactSpecification::PactSpecification_V3;
+  }
+}
+
+static int HexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Decodes a V2 query string component, where `+` is a space
+static std::string PercentDecode(const char* text, size_t length) {
+  std::string decoded;
+  decoded.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    if (text[i] == '+') {
+      decoded.push_back(' ');
+    } else if (text[i] == '%' && i + 2 < length && HexDigit(text[i + 1]) >= 0 && HexDigit(text[i + 2]) >= 0) {
+      decoded.push_back(static_cast<char>(HexDigit(text[i + 1]) * 16 + HexDigit(text[i + 2])));
+      i += 2;
+    } else {
+      decoded.push_back(text[i]);
+    }
+  }
+  return decoded;
+}
+
+static bool IsContentType(const char* name) {
+  static const char kName[] = "content-type";
+  for (size_t i = 0; i < sizeof(kName); i++) {
+    char c = name[i] >= 'A' && name[i] <= 'Z' ? static_cast<char>(name[i] - 'A' + 'a') : name[i];
+    if (c != kName[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool Base64Decode(const char* text, size_t length, std::vector<uint8_t>* out) {
+  out->clear();
+  out->reserve(length / 4 * 3);
+  uint32_t bits = 0;
+  int count = 0;
+  for (size_t i = 0; i < length; i++) {
+    char c = text[i];
+    int value;
+    if (c >= 'A' && c <= 'Z') value = c - 'A';
+    else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+    else if (c >= '0' && c <= '9') value = c - '0' + 52;
+    else if (c == '+' || c == '-') value = 62;
+    else if (c == '/' || c == '_') value = 63;
+    else if (c == '=' || c == '\n' || c == '\r') continue;
+    else return false;
+
+    bits = (bits << 6) | static_cast<uint32_t>(value);
+    if (++count == 4) {
+      out->push_back(static_cast<uint8_t>(bits >> 16));
+      out->push_back(static_cast<uint8_t>(bits >> 8));
+      out->push_back(static_cast<uint8_t>(bits));
+      bits = 0;
+      count = 0;
+    }
+  }
+  if (count == 1) {
+    return false;
+  }
+  if (count == 2) {
+    out->push_back(static_cast<uint8_t>(bits >> 4));
+  } else if (count == 3) {
+    out->push_back(static_cast<uint8_t>(bits >> 10));
+    out->push_back(static_cast<uint8_t>(bits >> 2));
+  }
+  return true;
+}
+
+// Builds the pact from the parsed file. Every call on an interaction goes through the journal, so
+// imported interactions can be cloned like ones built through the DSL.
+class PactImporter {
+  public:
+    PactImporter(Napi::Env env, bool journal) : env(env), journal(journal) {}
+
+    PactHandle Import(Napi::Object file) {
+      Napi::Value consumer = file.Get("consumer");
+      Napi::Value provider = file.Get("provider");
+      if (!consumer.IsObject() || !consumer.As<Napi::Object>().Get("name").IsString()) {
+        Fail("the pact has no consumer name");
+      }
+      if (!provider.IsObject() || !provider.As<Napi::Object>().Get("name").IsString()) {
+        Fail("the pact has no provider name");
+      }
+      if (file.Has("messages")) {
+        Fail("message pacts can't be imported");
+      }
+
+      Utf8Arg consumerName(consumer.As<Napi::Object>().Get("name"));
+      Utf8Arg providerName(provider.As<Napi::Object>().Get("name"));
+      ImportedPact pact(pactffi_new_pact(consumerName.c_str(), providerName.c_str()));
+      if (pact.get() == 0) {
+        Fail("unable to create the pact");
+      }
+      JournalPact(pact.get(), consumerName.c_str(), providerName.c_str());
+      if (journal) {
+        JournalEnable(pact.get());
+      }
+
+      Napi::Value metadata = file.Get("metadata");
+      PactSpecification specification = SpecificationOf(metadata);
+      if (!pactffi_with_specification(pact.get(), specification)) {
+        Fail("unable to set the pact specification");
+      }
+      JournalPactSpecification(pact.get(), specification);
+      ImportMetadata(pact.get(), metadata);
+
+      Napi::Value interactions = file.Get("interactions");
+      if (!interactions.IsUndefined() && !interactions.IsArray()) {
+        Fail("expected 'interactions' to be an array");
+      }
+      if (interactions.IsArray()) {
+        Napi::Array array = interactions.As<Napi::Array>();
+        for (uint32_t i = 0; i < array.Length(); i++) {
+          Napi::HandleScope scope(env);
+          index = i;
+          ImportInteraction(pact.get(), array.Get(i));
+        }
+      }
+
+      return pact.release();
+    }
+
+  private:
+    Napi::Env env;
+    bool journal;
+    // The interaction being imported, for errors
+    int64_t index = -1;
+    std::vector<uint8_t> decoded;
+
+    [[noreturn]] void Fail(const std::string& message) {
+      std::string error = "PactffiImportPact: ";
+      if (index >= 0) {
+        error += "interaction " + std::to_string(index) + ": ";
+      }
+      throw Napi::Error::New(env, error + message);
+    }
+
+    void Check(bool applied, const char* what) {
+      if (!applied) {
+        Fail(std::string("unable to set ") + what);
+      }
+    }
+
+    void SetMetadata(PactHandle pact, const char* ns, const char* name, const char* value) {
+      if (pactffi_with_pact_metadata(pact, ns, name, value)) {
+        JournalPactMetadata(pact, ns, name, value);
+      }
+    }
+
+    // Metadata other than what the core writes itself, as strings, or JSON for other values
+    void ImportMetadata(PactHandle pact, Napi::Value metadata) {
+      if (!metadata.IsObject()) {
+        return;
+      }
+      Napi::Object namespaces = metadata.As<Napi::Object>();
+      Napi::Array names = namespaces.GetPropertyNames();
+      for (uint32_t i = 0; i < names.Length(); i++) {
+        Napi::HandleScope scope(env);
+        std::string ns = names.Get(i).As<Napi::String>().Utf8Value();
+        Napi::Value entries = namespaces.Get(ns);
+        if (ns == "pactSpecification" || ns == "pactRust" || ns == "pactJs" || !entries.IsObject() || entries.IsArray()) {
+          continue;
+        }
+
+        Napi::Object values = entries.As<Napi::Object>();
+        Napi::Array keys = values.GetPropertyNames();
+        for (uint32_t j = 0; j < keys.Length(); j++) {
+          Napi::Value key = keys.Get(j);
+          Napi::Value value = values.Get(key);
+          Utf8Arg name(key);
+          if (value.IsString()) {
+            Utf8Arg text(value);
+            SetMetadata(pact, ns.c_str(), name.c_str(), text.c_str());
+          } else {
+            JsonArg json(value);
+            SetMetadata(pact, ns.c_str(), name.c_str(), json.c_str());
+          }
+        }
+      }
+    }
+
+    void ImportInteraction(PactHandle pact, Napi::Value value) {
+      if (!value.IsObject() || value.IsArray()) {
+        Fail("expected an object");
+      }
+      Napi::Object interaction = value.As<Napi::Object>();
+
+      Napi::Value type = interaction.Get("type");
+      if (!type.IsUndefined() && !(type.IsString() && type.As<Napi::String>().Utf8Value() == "Synchronous/HTTP")) {
+        Fail("only HTTP interactions can be imported");
+      }
+
+      Napi::Value description = interaction.Get("description");
+      if (!description.IsString()) {
+        Fail("expected 'description' to be a string");
+      }
+      Napi::Value request = interaction.Get("request");
+      if (!request.IsObject() || request.IsArray()) {
+        Fail("expected 'request' to be an object");
+      }
+      Napi::Value response = interaction.Get("response");
+      if (!response.IsObject() || response.IsArray()) {
+        Fail("expected 'response' to be an object");
+      }
+
+      InteractionHandle handle;
+      {
+        Utf8Arg text(description);
+        handle = pactffi_new_interaction(pact, text.c_str());
+        if (handle == 0) {
+          Fail("unable to create the interaction");
+        }
+        JournalInteraction(pact, handle, text.c_str());
+        Check(JournalCall(JOURNAL_UPON_RECEIVING, pactffi_upon_receiving, handle, text.c_str()), "the description");
+      }
+
+      ImportProviderStates(handle, interaction);
+      ImportV4Fields(handle, interaction);
+      ImportRequest(handle, request.As<Napi::Object>());
+      ImportResponse(handle, response.As<Napi::Object>());
+    }
+
+    void ImportProviderStates(InteractionHandle interaction, Napi::Object source) {
+      // V2 and earlier have a single state, by name
+      Napi::Value single = source.Get("providerState");
+      if (single.IsString()) {
+        Utf8Arg name(single);
+        Check(JournalCall(JOURNAL_GIVEN, pactffi_given, interaction, name.c_str()), "the provider state");
+      }
+
+      Napi::Value states = source.Get("providerStates");
+      if (!states.IsArray()) {
+        return;
+      }
+      Napi::Array array = states.As<Napi::Array>();
+      for (uint32_t i = 0; i < array.Length(); i++) {
+        Napi::Value state = array.Get(i);
+        if (!state.IsObject() || !state.As<Napi::Object>().Get("name").IsString()) {
+          Fail("expected each provider state to have a name");
+        }
+        Utf8Arg name(state.As<Napi::Object>().Get("name"));
+        Napi::Value params = state.As<Napi::Object>().Get("params");
+        if (params.IsObject() && !params.IsArray()) {
+          JsonArg json(params);
+          Check(JournalCall(JOURNAL_GIVEN_WITH_PARAMS, pactffi_given_with_params, interaction, name.c_str(), json.c_str()) == 0,
+            "a provider state");
+        } else {
+          Check(JournalCall(JOURNAL_GIVEN, pactffi_given, interaction, name.c_str()), "a provider state");
+        }
+      }
+    }
+
+    void ImportV4Fields(InteractionHandle interaction, Napi::Object source) {
+      Napi::Value pending = source.Get("pending");
+      if (pending.IsBoolean()) {
+        Check(JournalCall(JOURNAL_SET_PENDING, pactffi_set_pending, interaction, pending.As<Napi::Boolean>().Value()), "pending");
+      }
+
+      Napi::Value key = source.Get("key");
+      if (key.IsString()) {
+        Utf8Arg text(key);
+        Check(JournalCall(JOURNAL_SET_KEY, pactffi_set_key, interaction, text.c_str()), "the key");
+      }
+
+      Napi::Value comments = source.Get("comments");
+      if (!comments.IsObject() || comments.IsArray()) {
+        return;
+      }
+      Napi::Object entries = comments.As<Napi::Object>();
+      Napi::Array names = entries.GetPropertyNames();
+      for (uint32_t i = 0; i < names.Length(); i++) {
+        std::string name = names.Get(i).As<Napi::String>().Utf8Value();
+        Napi::Value value = entries.Get(name);
+
+        if (name == "text" && value.IsArray()) {
+          Napi::Array texts = value.As<Napi::Array>();
+          for (uint32_t j = 0; j < texts.Length(); j++) {
+            if (texts.Get(j).IsString()) {
+              Utf8Arg text(texts.Get(j));
+              Check(JournalCall(JOURNAL_ADD_TEXT_COMMENT, pactffi_add_text_comment, interaction, text.c_str()), "a comment");
+            }
+          }
+        } else if (name == "testname" && value.IsString()) {
+          Utf8Arg text(value);
+          Check(JournalCall(JOURNAL_INTERACTION_TEST_NAME, pactffi_interaction_test_name, interaction, text.c_str()) == 0,
+            "the test name");
+        } else if (!value.IsNull() && !value.IsUndefined()) {
+          JsonArg json(value);
+          Check(JournalCall(JOURNAL_SET_COMMENT, pactffi_set_comment, interaction, name.c_str(), json.c_str()), "a comment");
+        }
+      }
+    }
+
+    void ImportRequest(InteractionHandle interaction, Napi::Object request) {
+      Napi::Value method = request.Get("method");
+      Napi::Value path = request.Get("path");
+      {
+        std::string methodText = method.IsString() ? method.As<Napi::String>().Utf8Value() : "GET";
+        std::string pathText = path.IsString() ? path.As<Napi::String>().Utf8Value() : "/";
+        Check(JournalCall(JOURNAL_WITH_REQUEST, pactffi_with_request, interaction, methodText.c_str(), pathText.c_str()),
+          "the request");
+      }
+
+      ImportQuery(interaction, request.Get("query"));
+      std::string contentType = ImportHeaders(interaction, InteractionPart::InteractionPart_Request, request.Get("headers"));
+      ImportBody(interaction, InteractionPart::InteractionPart_Request, request.Get("body"), contentType);
+      ImportMatchingRules(interaction, InteractionPart::InteractionPart_Request, request.Get("matchingRules"));
+    }
+
+    void ImportResponse(InteractionHandle interaction, Napi::Object response) {
+      Napi::Value status = response.Get("status");
+      if (status.IsNumber()) {
+        std::string text = std::to_string(status.As<Napi::Number>().Int64Value());
+        Check(JournalCall(JOURNAL_RESPONSE_STATUS, pactffi_response_status_v2, interaction, text.c_str()), "the status");
+      }
+
+      std::string contentType = ImportHeaders(interaction, InteractionPart::InteractionPart_Response, response.Get("headers"));
+      ImportBody(interaction, InteractionPart::InteractionPart_Response, response.Get("body"), contentType);
+      ImportMatchingRules(interaction, InteractionPart::InteractionPart_Response, response.Get("matchingRules"));
+    }
+
+    void SetQueryParameter(InteractionHandle interaction, const char* name, size_t index, const char* value) {
+      Check(JournalCall(JOURNAL_WITH_QUERY_PARAMETER_V2, pactffi_with_query_parameter_v2, interaction, name, index, value),
+        "a query parameter");
+    }
+
+    void ImportQuery(InteractionHandle interaction, Napi::Value query) {
+      // V2 pacts have the query string as it was sent
+      if (query.IsString()) {
+        std::string text = query.As<Napi::String>().Utf8Value();
+        std::vector<std::string> names;
+        std::vector<size_t> counts;
+        size_t start = 0;
+        while (start <= text.size()) {
+          size_t end = text.find('&', start);
+          if (end == std::string::npos) {
+            end = text.size();
+          }
+          if (end > start) {
+            size_t equals = text.find('=', start);
+            size_t nameEnd = equals < end ? equals : end;
+            std::string name = PercentDecode(text.data() + start, nameEnd - start);
+            std::string value = equals < end ? PercentDecode(text.data() + equals + 1, end - equals - 1) : "";
+
+            size_t slot = 0;
+            while (slot < names.size() && names[slot] != name) {
+              slot++;
+            }
+            if (slot == names.size()) {
+              names.push_back(name);
+              counts.push_back(0);
+            }
+            SetQueryParameter(interaction, name.c_str(), counts[slot]++, value.c_str());
+          }
+          start = end + 1;
+        }
+        return;
+      }
+
+      if (!query.IsObject() || query.IsArray()) {
+        return;
+      }
+      Napi::Object parameters = query.As<Napi::Object>();
+      Napi::Array names = parameters.GetPropertyNames();
+      for (uint32_t i = 0; i < names.Length(); i++) {
+        Napi::HandleScope scope(env);
+        Napi::Value key = names.Get(i);
+        Napi::Value values = parameters.Get(key);
+        Utf8Arg name(key);
+        if (values.IsString()) {
+          Utf8Arg value(values);
+          SetQueryParameter(interaction, name.c_str(), 0, value.c_str());
+        } else if (values.IsArray()) {
+          Napi::Array array = values.As<Napi::Array>();
+          for (uint32_t j = 0; j < array.Length(); j++) {
+            if (array.Get(j).IsString()) {
+              Utf8Arg value(array.Get(j));
+              SetQueryParameter(interaction, name.c_str(), j, value.c_str());
+            }
+          }
+        }
+      }
+    }
+
+    void SetHeader(InteractionHandle interaction, InteractionPart part, const char* name, size_t index, Napi::Value value) {
+      Utf8Arg text(value);
+      Check(JournalCall(JOURNAL_WITH_HEADER, pactffi_with_header_v2, interaction, part, name, index, text.c_str()), "a header");
+    }
+
+    // Returns the content type header, if there is one
+    std::string ImportHeaders(InteractionHandle interaction, InteractionPart part, Napi::Value headers) {
+      std::string contentType;
+      if (!headers.IsObject() || headers.IsArray()) {
+        return contentType;
+      }
+
+      Napi::Object entries = headers.As<Napi::Object>();
+      Napi::Array names = entries.GetPropertyNames();
+      for (uint32_t i = 0; i < names.Length(); i++) {
+        Napi::HandleScope scope(env);
+        Napi::Value key = names.Get(i);
+        Napi::Value values = entries.Get(key);
+        Utf8Arg name(key);
+        bool isContentType = IsContentType(name.c_str());
+
+        // V3 and earlier join repeated headers into one string, V4 keeps a list
+        if (values.IsString()) {
+          SetHeader(interaction, part, name.c_str(), 0, values);
+          if (isContentType) {
+            contentType = values.As<Napi::String>().Utf8Value();
+          }
+        } else if (values.IsArray()) {
+          Napi::Array array = values.As<Napi::Array>();
+          for (uint32_t j = 0; j < array.Length(); j++) {
+            if (array.Get(j).IsString()) {
+              SetHeader(interaction, part, name.c_str(), j, array.Get(j));
+              if (isContentType && j == 0) {
+                contentType = array.Get(j).As<Napi::String>().Utf8Value();
+              }
+            }
+          }
+        }
+      }
+      return contentType;
+    }
+
+    void SetBody(InteractionHandle interaction, InteractionPart part, const std::string& contentType, const char* body) {
+      Check(JournalCall(JOURNAL_WITH_BODY, pactffi_with_body, interaction, part, contentType.c_str(), body), "the body");
+    }
+
+    void ImportBody(InteractionHandle interaction, InteractionPart part, Napi::Value body, std::string contentType) {
+      if (body.IsUndefined() || body.IsNull()) {
+        return;
+      }
+
+      // V4 bodies are `{ content, contentType, encoded }`, with binary content base64 encoded
+      Napi::Value content = body;
+      bool base64 = false;
+      if (body.IsObject() && !body.IsArray() && body.As<Napi::Object>().Has("content")) {
+        Napi::Object v4 = body.As<Napi::Object>();
+        content = v4.Get("content");
+        Napi::Value declared = v4.Get("contentType");
+        if (declared.IsString()) {
+          contentType = declared.As<Napi::String>().Utf8Value();
+        }
+        Napi::Value encoded = v4.Get("encoded");
+        base64 = (encoded.IsBoolean() && encoded.As<Napi::Boolean>().Value()) ||
+          (encoded.IsString() && encoded.As<Napi::String>().Utf8Value() == "base64");
+        if (content.IsUndefined() || content.IsNull()) {
+          return;
+        }
+      }
+
+      if (base64) {
+        if (!content.IsString()) {
+          Fail("expected an encoded body to be a string");
+        }
+        Utf8Arg text(content);
+        if (!Base64Decode(text.c_str(), text.length(), &decoded)) {
+          Fail("unable to decode the body");
+        }
+        if (contentType.empty()) {
+          contentType = "application/octet-stream";
+        }
+        JournalBytes bytes{decoded.data(), decoded.size()};
+        bool applied = pactffi_with_binary_body(interaction, part, contentType.c_str(), bytes.data, bytes.size);
+        if (applied) {
+          JournalRecord(JOURNAL_WITH_BINARY_BODY, interaction, part, static_cast<const char*>(contentType.c_str()), bytes);
+        }
+        Check(applied, "the body");
+        return;
+      }
+
+      if (content.IsString()) {
+        if (contentType.empty()) {
+          contentType = "text/plain";
+        }
+        Utf8Arg text(content);
+        SetBody(interaction, part, contentType, text.c_str());
+      } else {
+        if (contentType.empty()) {
+          contentType = "application/json";
+        }
+        JsonArg json(content);
+        SetBody(interaction, part, contentType, json.c_str());
+      }
+    }
+
+    void ImportMatchingRules(InteractionHandle interaction, InteractionPart part, Napi::Value rules) {
+      if (!rules.IsObject() || rules.IsArray()) {
+        return;
+      }
+      JsonArg json(rules);
+      Check(JournalCall(JOURNAL_WITH_MATCHING_RULES, pactffi_with_matching_rules, interaction, part, json.c_str()),
+        "the matching rules");
+    }
+};
+
+/**
+ * Loads a pact file into a new pact, ready to start a mock server from
+ * (`pactffiCreateMockServerForTransport`) or to add more interactions to. Returns the new
+ * `PactHandle`, which belongs to the caller like one from `pactffiNewPact`.
+ *
+ * * `source` - the path of the pact file, or its contents as a Buffer.
+ * * `journal` - optional; enables journaling on the new pact (`pactffiEnableJournal`), so its
+ *   interactions can be cloned (`pactffiCloneInteraction`) and it can be snapshotted.
+ *
+ * The file is parsed in one pass by the engine's JSON parser, and the pact then built natively
+ * without crossing back into JS per interaction.
+ *
+ * Consumer and provider names, the specification version, metadata, provider states, comments,
+ * requests, responses, bodies (including V4 binary bodies) and matching rules are imported.
+ * Generators are not (the FFI has no way to set them other than through integration JSON), and
+ * only HTTP interactions are supported: message pacts and V4 message interactions throw.
+ *
+ * C interface: none, built from `pactffi_new_pact` and the interaction functions.
+ */
+Napi::Value PactffiImportPact(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiImportPact received < 1 arguments");
+  }
+
+  if (!info[0].IsString() && !info[0].IsBuffer()) {
+    throw Napi::Error::New(env, "PactffiImportPact(arg 0) expected a string or a Buffer");
+  }
+
+  bool journal = false;
+  if (info.Length() > 1 && !info[1].IsUndefined()) {
+    if (!info[1].IsBoolean()) {
+      throw Napi::Error::New(env, "PactffiImportPact(arg 1) expected a boolean");
+    }
+    journal = info[1].As<Napi::Boolean>().Value();
+  }
+
+  std::string contents;
+  const char* data;
+  uint64_t size;
+  if (info[0].IsString()) {
+    std::string error;
+    if (!ReadSource(info[0].As<Napi::String>().Utf8Value().c_str(), &contents, &error)) {
+      throw Napi::Error::New(env, "PactffiImportPact: " + error);
+    }
+    data = contents.data();
+    size = contents.size();
+  } else {
+    Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
+    data = reinterpret_cast<const char*>(buffer.Data());
+    size = buffer.Length();
+  }
+
+  if (size > kMaxSourceBytes) {
+    throw Napi::Error::New(env, "PactffiImportPact: the pact is too large to import");
+  }
+
+  Napi::Object json = env.Global().Get("JSON").As<Napi::Object>();
+  Napi::Function parse = json.Get("parse").As<Napi::Function>();
+  Napi::Value parsed = parse.Call(json, {Napi::String::New(env, data, static_cast<size_t>(size))});
+  if (!parsed.IsObject() || parsed.IsArray()) {
+    throw Napi::Error::New(env, "PactffiImportPact: expected the pact to be a JSON object");
+  }
+
+  PactImporter importer(env, journal);
+  return Napi::Number::New(env, importer.Import(parsed.As<Napi::Object>()));
+}
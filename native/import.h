@@ -0,0 +1,3 @@
+#include <napi.h>
+
+Napi::Value PactffiImportPact(const Napi::CallbackInfo& info);
@@ -0,0 +1,143 @@
+#include <napi.h>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include "pact-cpp.h"
+#include "in_process.h"
+#include "ownership.h"
+#include "trace.h"
+
+// Matching for requests intercepted in the test process (by nock and the like), with the core's
+// semantics. The FFI only matches requests in a mock server, so this is a thin layer over one: each
+// pact matched this way gets a mock server of its own on the loopback interface, started on first
+// use and stopped when the pact is freed, and the intercepted requests are sent on to it.
+
+static std::mutex serversMutex;
+static std::map<PactHandle, int32_t> servers;
+
+// The port of the pact's matching server, starting it if this is the first use
+static int32_t ServerFor(Napi::Env env, const char* name, PactHandle pact) {
+  std::lock_guard<std::mutex> lock(serversMutex);
+  auto it = servers.find(pact);
+  if (it != servers.end()) {
+    return it->second;
+  }
+
+  int32_t port = pactffi_create_mock_server_for_transport(pact, "127.0.0.1", 0, "http", NULL);
+  if (port <= 0) {
+    throw Napi::Error::New(env, std::string(name) + " was unable to start matching for the pact (error " + std::to_string(port) + ")");
+  }
+  servers[pact] = port;
+  TraceInstant("in-process matching started", "mock-server", "port", port);
+  return port;
+}
+
+// The port of the pact's matching server, or 0 if matching hasn't started for it
+static int32_t ServerOf(PactHandle pact) {
+  std::lock_guard<std::mutex> lock(serversMutex);
+  auto it = servers.find(pact);
+  return it != servers.end() ? it->second : 0;
+}
+
+void InProcessFreePact(Napi::Env env, PactHandle pact) {
+  std::lock_guard<std::mutex> lock(serversMutex);
+  auto it = servers.find(pact);
+  if (it == servers.end()) {
+    return;
+  }
+  if (pactffi_cleanup_mock_server(it->second)) {
+    ExternalMemoryReleaseMockServer(env, it->second);
+  }
+  TraceInstant("in-process matching stopped", "mock-server", "port", it->second);
+  servers.erase(it);
+}
+
+/**
+ * The port of the mock server that matches requests for a pact in process, starting it on the
+ * loopback interface on the first call for the pact. An intercepted request is sent on to it as
+ * it would have been sent to the provider, and its response is the outcome: the interaction's
+ * response if the request matches one, or a 500 with an `X-Pact` header if not.
+ *
+ * * `pact` - Handle to a Pact model.
+ *
+ * The server matches and records requests like any other mock server: see
+ * `pactffiInProcessMatched` and `pactffiInProcessMismatches`. The pact is matched as it is at the
+ * first call, and (as once a mock server is started for it) can't be added to afterwards. The
+ * server is stopped when the pact is freed.
+ */
+Napi::Value PactffiInProcessPort(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiInProcessPort received < 1 arguments");
+  }
+
+  if (!info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiInProcessPort(arg 0) expected a PactHandle (uint16_t)");
+  }
+
+  int32_t port = ServerFor(env, "PactffiInProcessPort", info[0].As<Napi::Number>().Uint32Value());
+
+  return Napi::Number::New(env, port);
+}
+
+/**
+ * Whether every interaction in the pact has been matched by a request to its
+ * `pactffiInProcessPort`, and no request failed to match, as `pactffiMockServerMatched` reports
+ * for a mock server. False if matching hasn't started for the pact: asking doesn't start it.
+ *
+ * * `pact` - Handle to a Pact model.
+ */
+Napi::Value PactffiInProcessMatched(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiInProcessMatched received < 1 arguments");
+  }
+
+  if (!info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiInProcessMatched(arg 0) expected a PactHandle (uint16_t)");
+  }
+
+  int32_t port = ServerOf(info[0].As<Napi::Number>().Uint32Value());
+  if (port == 0) {
+    return Napi::Boolean::New(env, false);
+  }
+
+  return Napi::Boolean::New(env, pactffi_mock_server_matched(port));
+}
+
+/**
+ * The mismatches for requests sent to the pact's `pactffiInProcessPort`, and the interactions that
+ * no request has matched, as a JSON string in the format of `pactffiMockServerMismatches`. An
+ * empty array if matching hasn't started for the pact: asking doesn't start it.
+ *
+ * * `pact` - Handle to a Pact model.
+ */
+Napi::Value PactffiInProcessMismatches(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiInProcessMismatches received < 1 arguments");
+  }
+
+  if (!info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiInProcessMismatches(arg 0) expected a PactHandle (uint16_t)");
+  }
+
+  int32_t port = ServerOf(info[0].As<Napi::Number>().Uint32Value());
+  if (port == 0) {
+    return Napi::String::New(env, "[]");
+  }
+  // Owned by the server until it is stopped, as for mock servers
+  char* res = pactffi_mock_server_mismatches(port);
+  if (res == NULL) {
+    throw Napi::Error::New(env, "PactffiInProcessMismatches was unable to read the mismatches");
+  }
+
+  Napi::String mismatches = Napi::String::New(env, res);
+  ExternalMemoryRetainForMockServer(env, port, strlen(res) + 1);
+
+  return mismatches;
+}
@@ -0,0 +1,9 @@
+#include <napi.h>
+#include "pact-cpp.h"
+
+Napi::Value PactffiInProcessPort(const Napi::CallbackInfo& info);
+Napi::Value PactffiInProcessMatched(const Napi::CallbackInfo& info);
+Napi::Value PactffiInProcessMismatches(const Napi::CallbackInfo& info);
+
+// Stops the pact's in-process matching server, if it has one, once the pact is freed
+void InProcessFreePact(Napi::Env env, PactHandle pact);
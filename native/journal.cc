@@ -0,0 +1,681 @@
+#include <napi.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "pact-cpp.h"
+#include "journal.h"
+#include "mapped_file.h"
+
+struct JournalEntry {
+  JournalOp op;
+  // How many bytes of `args` identify what the call sets, for calls that replace an earlier one
+  size_t keyLength;
+  std::string args;
+};
+
+struct InteractionJournal {
+  PactHandle pact;
+  std::string description;
+  bool supported = true;
+  std::vector<JournalEntry> entries;
+};
+
+struct PactMetadataEntry {
+  std::string ns;
+  std::string name;
+  std::string value;
+};
+
+struct PactJournal {
+  std::string consumer;
+  std::string provider;
+  // -1 until set
+  int64_t specification = -1;
+  bool supported = true;
+  // Whether interactions are recorded (see JournalEnable)
+  bool recording = false;
+  std::vector<PactMetadataEntry> metadata;
+  // In the order they were created, which is the order they are written to the pact file
+  std::vector<InteractionHandle> interactions;
+};
+
+// For each op, how many leading arguments identify what it sets (so a later call with the same
+// ones replaces it), or -1 for calls that add to the interaction rather than set part of it
+static const int kKeyFields[JOURNAL_OP_COUNT] = {
+  -1, // JOURNAL_NONE
+  0,  // JOURNAL_UPON_RECEIVING
+  -1, // JOURNAL_GIVEN
+  -1, // JOURNAL_GIVEN_WITH_PARAM
+  -1, // JOURNAL_GIVEN_WITH_PARAMS
+  0,  // JOURNAL_SET_PENDING
+  0,  // JOURNAL_SET_KEY
+  1,  // JOURNAL_SET_COMMENT (key)
+  -1, // JOURNAL_ADD_TEXT_COMMENT
+  2,  // JOURNAL_ADD_INTERACTION_REFERENCE (group, name)
+  0,  // JOURNAL_INTERACTION_TEST_NAME
+  0,  // JOURNAL_WITH_REQUEST
+  2,  // JOURNAL_WITH_QUERY_PARAMETER (name, index)
+  2,  // JOURNAL_WITH_QUERY_PARAMETER_V2 (name, index)
+  3,  // JOURNAL_WITH_HEADER (part, name, index)
+  1,  // JOURNAL_WITH_BODY (part)
+  1,  // JOURNAL_WITH_BINARY_FILE (part)
+  -1, // JOURNAL_WITH_MATCHING_RULES
+  -1, // JOURNAL_WITH_MULTIPART_FILE
+  0,  // JOURNAL_RESPONSE_STATUS
+  1,  // JOURNAL_WITH_BINARY_BODY (part)
+  1,  // JOURNAL_WITH_BINARY_FILE_PATH (part)
+};
+
+// Strings and bytes are recorded as this, then the bytes, then a NUL
+static const int64_t kNullString = -1;
+
+// Snapshots start with this, then a version, which is bumped whenever the layout changes
+static const char kSnapshotMagic[8] = {'P', 'A', 'C', 'T', 'S', 'N', 'A', 'P'};
+static const int64_t kSnapshotVersion = 1;
+
+static std::mutex journalMutex;
+static std::unordered_map<InteractionHandle, InteractionJournal> journals;
+static std::unordered_map<PactHandle, PactJournal> pactJournals;
+
+void JournalEncodeInt(std::string& out, int64_t value) {
+  // Little endian whatever the platform, as journals are written out by snapshots
+  char bytes[8];
+  uint64_t bits = static_cast<uint64_t>(value);
+  for (int i = 0; i < 8; i++) {
+    bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+  }
+  out.append(bytes, sizeof(bytes));
+}
+
+void JournalEncodeString(std::string& out, const char* value) {
+  if (value == NULL) {
+    JournalEncodeInt(out, kNullString);
+    return;
+  }
+  JournalEncodeBytes(out, reinterpret_cast<const uint8_t*>(value), strlen(value));
+}
+
+void JournalEncodeBytes(std::string& out, const uint8_t* data, size_t size) {
+  JournalEncodeInt(out, static_cast<int64_t>(size));
+  out.append(reinterpret_cast<const char*>(data), size);
+  out.push_back('\0');
+}
+
+bool JournalReader::Take(size_t count, const char** out) {
+  if (fail || count > length - pos) {
+    fail = true;
+    return false;
+  }
+  *out = data + pos;
+  pos += count;
+  return true;
+}
+
+int64_t JournalReader::Int() {
+  const char* bytes;
+  if (!Take(8, &bytes)) {
+    return 0;
+  }
+
+  uint64_t bits = 0;
+  for (int i = 0; i < 8; i++) {
+    bits |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+  }
+  return static_cast<int64_t>(bits);
+}
+
+const char* JournalReader::String() {
+  JournalBytes bytes = Bytes();
+  return reinterpret_cast<const char*>(bytes.data);
+}
+
+JournalBytes JournalReader::Bytes() {
+  int64_t size = Int();
+  if (fail || size == kNullString) {
+    return {NULL, 0};
+  }
+
+  const char* bytes;
+  if (size < 0 || !Take(static_cast<size_t>(size), &bytes)) {
+    fail = true;
+    return {NULL, 0};
+  }
+
+  const char* terminator;
+  if (!Take(1, &terminator) || *terminator != '\0') {
+    fail = true;
+    return {NULL, 0};
+  }
+
+  return {reinterpret_cast<const uint8_t*>(bytes), static_cast<size_t>(size)};
+}
+
+void JournalPact(PactHandle pact, const char* consumer, const char* provider) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  PactJournal& journal = pactJournals[pact];
+  journal = PactJournal();
+  journal.consumer = consumer;
+  journal.provider = provider;
+}
+
+void JournalPactSpecification(PactHandle pact, PactSpecification specification) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = pactJournals.find(pact);
+  if (it != pactJournals.end()) {
+    it->second.specification = static_cast<int64_t>(specification);
+  }
+}
+
+void JournalPactMetadata(PactHandle pact, const char* ns, const char* name, const char* value) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = pactJournals.find(pact);
+  if (it == pactJournals.end()) {
+    return;
+  }
+
+  for (PactMetadataEntry& entry : it->second.metadata) {
+    if (entry.ns == ns && entry.name == name) {
+      entry.value = value;
+      return;
+    }
+  }
+  it->second.metadata.push_back(PactMetadataEntry{ns, name, value});
+}
+
+void JournalPactUnsupported(PactHandle pact) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = pactJournals.find(pact);
+  if (it != pactJournals.end()) {
+    it->second.supported = false;
+  }
+}
+
+bool JournalEnable(PactHandle pact) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = pactJournals.find(pact);
+  if (it == pactJournals.end() || !it->second.interactions.empty()) {
+    return false;
+  }
+  it->second.recording = true;
+  return true;
+}
+
+bool JournalEnabled(PactHandle pact) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = pactJournals.find(pact);
+  return it != pactJournals.end() && it->second.recording;
+}
+
+void JournalInteraction(PactHandle pact, InteractionHandle interaction, const char* description) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = pactJournals.find(pact);
+  if (it == pactJournals.end() || !it->second.recording) {
+    return;
+  }
+  it->second.interactions.push_back(interaction);
+
+  InteractionJournal& journal = journals[interaction];
+  journal.pact = pact;
+  journal.description = description;
+  journal.supported = true;
+  journal.entries.clear();
+}
+
+void JournalFreePact(PactHandle pact) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  pactJournals.erase(pact);
+  for (auto it = journals.begin(); it != journals.end();) {
+    if (it->second.pact == pact) {
+      it = journals.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void JournalUnsupported(InteractionHandle interaction) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = journals.find(interaction);
+  if (it != journals.end()) {
+    it->second.supported = false;
+  }
+}
+
+void JournalAppend(InteractionHandle interaction, JournalOp op, std::string& args, const size_t* fieldEnds, size_t fields) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = journals.find(interaction);
+  if (it == journals.end()) {
+    return;
+  }
+  std::vector<JournalEntry>& entries = it->second.entries;
+
+  int keyFields = kKeyFields[op];
+  size_t keyLength = keyFields <= 0 || static_cast<size_t>(keyFields) > fields ? 0 : fieldEnds[keyFields - 1];
+
+  if (keyFields >= 0) {
+    for (auto entry = entries.begin(); entry != entries.end(); ++entry) {
+      if (entry->op == op && entry->keyLength == keyLength && entry->args.compare(0, keyLength, args, 0, keyLength) == 0) {
+        // Moved to the end, as the call is now the latest, keeping its buffer for the new arguments
+        std::rotate(entry, entry + 1, entries.end());
+        entries.back().args.assign(args);
+        return;
+      }
+    }
+  }
+
+  entries.push_back(JournalEntry{op, keyLength, args});
+}
+
+JournalReplayResult JournalReplayable(InteractionHandle interaction, PactHandle* pact) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = journals.find(interaction);
+  if (it == journals.end()) {
+    return JOURNAL_NOT_FOUND;
+  }
+  if (!it->second.supported) {
+    return JOURNAL_UNSUPPORTED;
+  }
+  *pact = it->second.pact;
+  return JOURNAL_REPLAYED;
+}
+
+bool JournalFind(InteractionHandle interaction, JournalOp op, const std::string& prefix, std::string* args) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = journals.find(interaction);
+  if (it == journals.end()) {
+    return false;
+  }
+
+  const std::vector<JournalEntry>& entries = it->second.entries;
+  for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry) {
+    if (entry->op == op && entry->args.compare(0, prefix.size(), prefix) == 0) {
+      *args = entry->args;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Decodes the arguments for `fn` after the interaction handle, and calls it on `target`
+template <typename R, typename... Params, size_t... I>
+static bool ReplayCall(R (*fn)(InteractionHandle, Params...), InteractionHandle target, JournalReader& reader, std::index_sequence<I...>) {
+  // Braced initialisers are evaluated left to right, so the arguments are read in order
+  std::tuple<Params...> values{JournalCodec<Params>::Decode(reader)...};
+  if (reader.failed() || !reader.done()) {
+    return false;
+  }
+
+  if constexpr (std::is_void<R>::value) {
+    fn(target, std::get<I>(values)...);
+    return true;
+  } else {
+    return JournalSucceeded(fn(target, std::get<I>(values)...));
+  }
+}
+
+template <typename R, typename... Params>
+static bool Replay(R (*fn)(InteractionHandle, Params...), InteractionHandle target, JournalReader& reader) {
+  return ReplayCall(fn, target, reader, std::index_sequence_for<Params...>{});
+}
+
+static bool ReplayEntry(const JournalEntry& entry, InteractionHandle target) {
+  JournalReader reader(entry.args.data(), entry.args.size());
+
+  switch (entry.op) {
+    case JOURNAL_UPON_RECEIVING:
+      return Replay(pactffi_upon_receiving, target, reader);
+    case JOURNAL_GIVEN:
+      return Replay(pactffi_given, target, reader);
+    case JOURNAL_GIVEN_WITH_PARAM:
+      return Replay(pactffi_given_with_param, target, reader);
+    case JOURNAL_GIVEN_WITH_PARAMS:
+      return Replay(pactffi_given_with_params, target, reader);
+    case JOURNAL_SET_PENDING:
+      return Replay(pactffi_set_pending, target, reader);
+    case JOURNAL_SET_KEY:
+      return Replay(pactffi_set_key, target, reader);
+    case JOURNAL_SET_COMMENT:
+      return Replay(pactffi_set_comment, target, reader);
+    case JOURNAL_ADD_TEXT_COMMENT:
+      return Replay(pactffi_add_text_comment, target, reader);
+    case JOURNAL_ADD_INTERACTION_REFERENCE:
+      return Replay(pactffi_add_interaction_reference, target, reader);
+    case JOURNAL_INTERACTION_TEST_NAME:
+      return Replay(pactffi_interaction_test_name, target, reader);
+    case JOURNAL_WITH_REQUEST:
+      return Replay(pactffi_with_request, target, reader);
+    case JOURNAL_WITH_QUERY_PARAMETER:
+      return Replay(pactffi_with_query_parameter, target, reader);
+    case JOURNAL_WITH_QUERY_PARAMETER_V2:
+      return Replay(pactffi_with_query_parameter_v2, target, reader);
+    case JOURNAL_WITH_HEADER:
+      return Replay(pactffi_with_header_v2, target, reader);
+    case JOURNAL_WITH_BODY:
+      return Replay(pactffi_with_body, target, reader);
+    case JOURNAL_WITH_MATCHING_RULES:
+      return Replay(pactffi_with_matching_rules, target, reader);
+    case JOURNAL_RESPONSE_STATUS:
+      return Replay(pactffi_response_status_v2, target, reader);
+    case JOURNAL_WITH_BINARY_FILE:
+    case JOURNAL_WITH_BINARY_BODY: {
+      InteractionPart part = JournalCodec<InteractionPart>::Decode(reader);
+      const char* contentType = reader.String();
+      JournalBytes body = reader.Bytes();
+      if (reader.failed() || !reader.done()) {
+        return false;
+      }
+      if (entry.op == JOURNAL_WITH_BINARY_BODY) {
+        return pactffi_with_binary_body(target, part, contentType, body.data, body.size);
+      }
+      return pactffi_with_binary_file(target, part, contentType, body.data, body.size);
+    }
+    case JOURNAL_WITH_BINARY_FILE_PATH: {
+      // Mapped again rather than kept, as these are for files too big to want two copies of
+      InteractionPart part = JournalCodec<InteractionPart>::Decode(reader);
+      const char* contentType = reader.String();
+      const char* path = reader.String();
+      if (reader.failed() || !reader.done() || path == NULL) {
+        return false;
+      }
+      MappedFile file;
+      std::string error;
+      if (!file.Open(path, &error)) {
+        return false;
+      }
+      return pactffi_with_binary_file(target, part, contentType, file.data(), static_cast<size_t>(file.size()));
+    }
+    case JOURNAL_WITH_MULTIPART_FILE: {
+      InteractionPart part = JournalCodec<InteractionPart>::Decode(reader);
+      const char* contentType = reader.String();
+      const char* file = reader.String();
+      const char* partName = reader.String();
+      const char* boundary = reader.String();
+      if (reader.failed() || !reader.done()) {
+        return false;
+      }
+      StringResult res = pactffi_with_multipart_file_v2(target, part, contentType, file, partName, boundary);
+      return res.tag == StringResult::Tag::StringResult_Ok;
+    }
+    default:
+      return false;
+  }
+}
+
+JournalReplayResult JournalReplay(InteractionHandle from, InteractionHandle to) {
+  // Copied out so the FFI calls are made without holding the lock
+  std::vector<JournalEntry> entries;
+  {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    auto it = journals.find(from);
+    if (it == journals.end()) {
+      return JOURNAL_NOT_FOUND;
+    }
+    if (!it->second.supported) {
+      return JOURNAL_UNSUPPORTED;
+    }
+    entries = it->second.entries;
+  }
+
+  for (const JournalEntry& entry : entries) {
+    if (!ReplayEntry(entry, to)) {
+      return JOURNAL_FAILED;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = journals.find(to);
+  if (it != journals.end()) {
+    std::vector<JournalEntry>& target = it->second.entries;
+    target.insert(target.begin(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+  }
+
+  return JOURNAL_REPLAYED;
+}
+
+JournalReplayResult JournalReplayPact(PactHandle from, PactHandle to) {
+  // Copied out so the FFI calls are made without holding the lock
+  std::vector<PactMetadataEntry> metadata;
+  std::vector<InteractionJournal> interactions;
+  {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    auto it = pactJournals.find(from);
+    if (it == pactJournals.end() || !it->second.recording) {
+      return JOURNAL_NOT_FOUND;
+    }
+    if (!it->second.supported) {
+      return JOURNAL_UNSUPPORTED;
+    }
+    metadata = it->second.metadata;
+
+    interactions.reserve(it->second.interactions.size());
+    for (InteractionHandle handle : it->second.interactions) {
+      auto interaction = journals.find(handle);
+      if (interaction == journals.end() || !interaction->second.supported) {
+        return JOURNAL_UNSUPPORTED;
+      }
+      interactions.push_back(interaction->second);
+    }
+  }
+
+  for (const PactMetadataEntry& entry : metadata) {
+    if (!pactffi_with_pact_metadata(to, entry.ns.c_str(), entry.name.c_str(), entry.value.c_str())) {
+      return JOURNAL_FAILED;
+    }
+    JournalPactMetadata(to, entry.ns.c_str(), entry.name.c_str(), entry.value.c_str());
+  }
+
+  for (InteractionJournal& source : interactions) {
+    InteractionHandle interaction = pactffi_new_interaction(to, source.description.c_str());
+    JournalInteraction(to, interaction, source.description.c_str());
+
+    for (const JournalEntry& entry : source.entries) {
+      if (!ReplayEntry(entry, interaction)) {
+        return JOURNAL_FAILED;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(journalMutex);
+    auto it = journals.find(interaction);
+    if (it != journals.end()) {
+      it->second.entries = std::move(source.entries);
+    }
+  }
+
+  return JOURNAL_REPLAYED;
+}
+
+// Writes a body recorded by path as the body itself, as a snapshot may be restored where the file
+// is somewhere else, or not at all
+static bool SnapshotFileEntry(const JournalEntry& entry, std::string* out, std::string* error) {
+  JournalReader reader(entry.args.data(), entry.args.size());
+  InteractionPart part = JournalCodec<InteractionPart>::Decode(reader);
+  const char* contentType = reader.String();
+  const char* path = reader.String();
+  if (reader.failed() || !reader.done() || path == NULL) {
+    *error = "the record of a body from a file is malformed";
+    return false;
+  }
+
+  MappedFile file;
+  if (!file.Open(path, error)) {
+    return false;
+  }
+
+  std::string args;
+  JournalCodec<InteractionPart>::Encode(args, part);
+  size_t keyLength = args.size();
+  JournalEncodeString(args, contentType);
+  JournalEncodeBytes(args, file.data(), static_cast<size_t>(file.size()));
+
+  JournalEncodeInt(*out, JOURNAL_WITH_BINARY_FILE);
+  JournalEncodeInt(*out, static_cast<int64_t>(keyLength));
+  JournalEncodeBytes(*out, reinterpret_cast<const uint8_t*>(args.data()), args.size());
+  return true;
+}
+
+JournalSnapshotResult JournalSnapshot(PactHandle pact, std::string* out, std::string* error) {
+  std::lock_guard<std::mutex> lock(journalMutex);
+  auto it = pactJournals.find(pact);
+  if (it == pactJournals.end() || !it->second.recording) {
+    return JOURNAL_SNAPSHOT_NOT_FOUND;
+  }
+  const PactJournal& journal = it->second;
+  if (!journal.supported) {
+    return JOURNAL_SNAPSHOT_UNSUPPORTED;
+  }
+
+  std::vector<const InteractionJournal*> interactions;
+  interactions.reserve(journal.interactions.size());
+  for (InteractionHandle handle : journal.interactions) {
+    auto interaction = journals.find(handle);
+    if (interaction == journals.end() || !interaction->second.supported) {
+      return JOURNAL_SNAPSHOT_UNSUPPORTED;
+    }
+    interactions.push_back(&interaction->second);
+  }
+
+  out->assign(kSnapshotMagic, sizeof(kSnapshotMagic));
+  JournalEncodeInt(*out, kSnapshotVersion);
+  JournalEncodeString(*out, journal.consumer.c_str());
+  JournalEncodeString(*out, journal.provider.c_str());
+  JournalEncodeInt(*out, journal.specification);
+
+  JournalEncodeInt(*out, static_cast<int64_t>(journal.metadata.size()));
+  for (const PactMetadataEntry& entry : journal.metadata) {
+    JournalEncodeString(*out, entry.ns.c_str());
+    JournalEncodeString(*out, entry.name.c_str());
+    JournalEncodeString(*out, entry.value.c_str());
+  }
+
+  JournalEncodeInt(*out, static_cast<int64_t>(interactions.size()));
+  for (const InteractionJournal* interaction : interactions) {
+    JournalEncodeString(*out, interaction->description.c_str());
+    JournalEncodeInt(*out, static_cast<int64_t>(interaction->entries.size()));
+    for (const JournalEntry& entry : interaction->entries) {
+      if (entry.op == JOURNAL_WITH_BINARY_FILE_PATH) {
+        if (!SnapshotFileEntry(entry, out, error)) {
+          return JOURNAL_SNAPSHOT_UNREADABLE;
+        }
+        continue;
+      }
+      JournalEncodeInt(*out, entry.op);
+      JournalEncodeInt(*out, static_cast<int64_t>(entry.keyLength));
+      JournalEncodeBytes(*out, reinterpret_cast<const uint8_t*>(entry.args.data()), entry.args.size());
+    }
+  }
+
+  return JOURNAL_SNAPSHOT_OK;
+}
+
+struct SnapshotInteraction {
+  const char* description;
+  std::vector<JournalEntry> entries;
+};
+
+PactHandle JournalRestore(const char* data, size_t length, std::string* error) {
+  if (length < sizeof(kSnapshotMagic) || memcmp(data, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+    *error = "not a pact snapshot";
+    return 0;
+  }
+
+  JournalReader reader(data + sizeof(kSnapshotMagic), length - sizeof(kSnapshotMagic));
+  int64_t version = reader.Int();
+  if (!reader.failed() && version != kSnapshotVersion) {
+    *error = "snapshot version " + std::to_string(version) + " is not supported (expected " +
+      std::to_string(kSnapshotVersion) + ")";
+    return 0;
+  }
+
+  // Read in full before anything is created, so a truncated snapshot doesn't leave half a pact
+  const char* consumer = reader.String();
+  const char* provider = reader.String();
+  int64_t specification = reader.Int();
+
+  std::vector<const char*> metadata;
+  int64_t metadataCount = reader.Int();
+  for (int64_t i = 0; i < metadataCount && !reader.failed(); i++) {
+    metadata.push_back(reader.String());
+    metadata.push_back(reader.String());
+    metadata.push_back(reader.String());
+  }
+
+  std::vector<SnapshotInteraction> interactions;
+  int64_t interactionCount = reader.Int();
+  for (int64_t i = 0; i < interactionCount && !reader.failed(); i++) {
+    SnapshotInteraction interaction;
+    interaction.description = reader.String();
+    int64_t entryCount = reader.Int();
+    for (int64_t j = 0; j < entryCount && !reader.failed(); j++) {
+      int64_t op = reader.Int();
+      int64_t keyLength = reader.Int();
+      JournalBytes args = reader.Bytes();
+      if (op <= JOURNAL_NONE || op >= JOURNAL_OP_COUNT || keyLength < 0 || static_cast<uint64_t>(keyLength) > args.size) {
+        *error = "snapshot is malformed";
+        return 0;
+      }
+      interaction.entries.push_back(JournalEntry{static_cast<JournalOp>(op), static_cast<size_t>(keyLength),
+        std::string(reinterpret_cast<const char*>(args.data), args.size)});
+    }
+    interactions.push_back(std::move(interaction));
+  }
+
+  // Only ever written as strings, so NULL means the snapshot is corrupt
+  bool missing = consumer == NULL || provider == NULL;
+  for (const char* value : metadata) {
+    missing = missing || value == NULL;
+  }
+  for (const SnapshotInteraction& interaction : interactions) {
+    missing = missing || interaction.description == NULL;
+  }
+  if (reader.failed() || !reader.done() || missing) {
+    *error = "snapshot is malformed";
+    return 0;
+  }
+
+  // Restored pacts record their interactions, having the record to hand, so they can be cloned
+  // and snapshotted in turn
+  PactHandle pact = pactffi_new_pact(consumer, provider);
+  JournalPact(pact, consumer, provider);
+  JournalEnable(pact);
+  bool restored = true;
+
+  if (specification >= 0) {
+    PactSpecification version = static_cast<PactSpecification>(specification);
+    restored = pactffi_with_specification(pact, version);
+    JournalPactSpecification(pact, version);
+  }
+
+  for (size_t i = 0; restored && i < metadata.size(); i += 3) {
+    restored = pactffi_with_pact_metadata(pact, metadata[i], metadata[i + 1], metadata[i + 2]);
+    JournalPactMetadata(pact, metadata[i], metadata[i + 1], metadata[i + 2]);
+  }
+
+  for (size_t i = 0; restored && i < interactions.size(); i++) {
+    InteractionHandle interaction = pactffi_new_interaction(pact, interactions[i].description);
+    JournalInteraction(pact, interaction, interactions[i].description);
+
+    for (const JournalEntry& entry : interactions[i].entries) {
+      if (!ReplayEntry(entry, interaction)) {
+        restored = false;
+        break;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(journalMutex);
+    journals[interaction].entries = std::move(interactions[i].entries);
+  }
+
+  if (!restored) {
+    pactffi_free_pact_handle(pact);
+    JournalFreePact(pact);
+    *error = "unable to rebuild the pact from the snapshot";
+    return 0;
+  }
+
+  return pact;
+}
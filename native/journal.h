@@ -0,0 +1,212 @@
+#pragma once
+
+#include <napi.h>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "pact-cpp.h"
+
+// A record of the DSL calls that built each HTTP interaction, so an interaction can be copied by
+// replaying them (`pactffiCloneInteraction`). The core has no way to copy an interaction, or to
+// read back one that is still being built, so the binding keeps its own account of what went in.
+//
+// Each successful call on an interaction is recorded as an op and its arguments after the handle,
+// encoded as for the FFI function it replays. Calls that set something (the request, a header at
+// an index, the body of a part) replace an earlier call that set the same thing, so calling a
+// setter repeatedly doesn't grow the journal; calls that add (states, matching rules) accumulate.
+//
+// Journals are process wide, like the handles they are keyed by, and are dropped with their pact.
+//
+// Pacts have a journal too (names, specification, metadata and their interactions in order), so a
+// whole pact can be written out as a snapshot and rebuilt from it (`pactffiSnapshotPact`).
+//
+// Recording interactions keeps a copy of every body and header the DSL is given for the life of
+// the pact, so it is opt in, per pact (`pactffiEnableJournal`), before any interaction is added.
+// Without it, only the pact's names, specification and metadata are kept.
+
+// The values are stored in journals, so only ever add to the end of this list
+enum JournalOp : uint8_t {
+  JOURNAL_NONE = 0,
+  JOURNAL_UPON_RECEIVING,
+  JOURNAL_GIVEN,
+  JOURNAL_GIVEN_WITH_PARAM,
+  JOURNAL_GIVEN_WITH_PARAMS,
+  JOURNAL_SET_PENDING,
+  JOURNAL_SET_KEY,
+  JOURNAL_SET_COMMENT,
+  JOURNAL_ADD_TEXT_COMMENT,
+  JOURNAL_ADD_INTERACTION_REFERENCE,
+  JOURNAL_INTERACTION_TEST_NAME,
+  JOURNAL_WITH_REQUEST,
+  JOURNAL_WITH_QUERY_PARAMETER,
+  JOURNAL_WITH_QUERY_PARAMETER_V2,
+  JOURNAL_WITH_HEADER,
+  JOURNAL_WITH_BODY,
+  JOURNAL_WITH_BINARY_FILE,
+  JOURNAL_WITH_MATCHING_RULES,
+  JOURNAL_WITH_MULTIPART_FILE,
+  JOURNAL_RESPONSE_STATUS,
+  JOURNAL_WITH_BINARY_BODY,
+  JOURNAL_WITH_BINARY_FILE_PATH,
+  JOURNAL_OP_COUNT,
+};
+
+// A binary argument, recorded with its length rather than NUL terminated
+struct JournalBytes {
+  const uint8_t* data;
+  size_t size;
+};
+
+// Reads arguments back out of an encoded call. Reads past the end, or of a malformed string, set
+// `failed` and return empty values rather than reading out of bounds.
+class JournalReader {
+  public:
+    JournalReader(const char* data, size_t length) : data(data), length(length) {}
+
+    int64_t Int();
+    // NULL for a string recorded as NULL. Points into the journal, NUL terminated.
+    const char* String();
+    JournalBytes Bytes();
+
+    bool failed() const { return fail; }
+    bool done() const { return pos == length; }
+
+  private:
+    const char* data;
+    size_t length;
+    size_t pos = 0;
+    bool fail = false;
+
+    bool Take(size_t count, const char** out);
+};
+
+void JournalEncodeInt(std::string& out, int64_t value);
+void JournalEncodeString(std::string& out, const char* value);
+void JournalEncodeBytes(std::string& out, const uint8_t* data, size_t size);
+
+// How an FFI argument type is recorded and read back
+template <typename T, typename Enable = void>
+struct JournalCodec;
+
+template <typename T>
+struct JournalCodec<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type> {
+  static void Encode(std::string& out, T value) { JournalEncodeInt(out, static_cast<int64_t>(value)); }
+  static T Decode(JournalReader& reader) { return static_cast<T>(reader.Int()); }
+};
+
+template <>
+struct JournalCodec<const char*> {
+  static void Encode(std::string& out, const char* value) { JournalEncodeString(out, value); }
+  static const char* Decode(JournalReader& reader) { return reader.String(); }
+};
+
+template <>
+struct JournalCodec<JournalBytes> {
+  static void Encode(std::string& out, JournalBytes value) { JournalEncodeBytes(out, value.data, value.size); }
+  static JournalBytes Decode(JournalReader& reader) { return reader.Bytes(); }
+};
+
+// Starts a journal for a pact
+void JournalPact(PactHandle pact, const char* consumer, const char* provider);
+
+// Records a pact's specification version, once set
+void JournalPactSpecification(PactHandle pact, PactSpecification specification);
+
+// Records a metadata value set on a pact, replacing an earlier value for the same key
+void JournalPactMetadata(PactHandle pact, const char* ns, const char* name, const char* value);
+
+// Marks a pact as having content the journal can't rebuild (messages, plugins), so it can't be
+// snapshotted
+void JournalPactUnsupported(PactHandle pact);
+
+// Starts recording the interactions created from `pact`. Returns false if it has no journal, or
+// already has interactions, whose calls would be missing from the record.
+bool JournalEnable(PactHandle pact);
+
+// Whether `pact` records its interactions
+bool JournalEnabled(PactHandle pact);
+
+// Starts a journal for an interaction created from `pact`, with `description`, if the pact
+// records its interactions
+void JournalInteraction(PactHandle pact, InteractionHandle interaction, const char* description);
+
+// Drops the journals of a pact and its interactions, once the pact is freed
+void JournalFreePact(PactHandle pact);
+
+// Marks an interaction as built with calls the journal can't replay (such as plugin contents),
+// so it can't be copied
+void JournalUnsupported(InteractionHandle interaction);
+
+// Appends an encoded call to an interaction's journal, replacing an earlier call it supersedes.
+// Does nothing for handles without a journal (messages, or interactions from other addons).
+void JournalAppend(InteractionHandle interaction, JournalOp op, std::string& args, const size_t* fieldEnds, size_t fields);
+
+// Records a successful call on `interaction`. `args` are the FFI function's arguments after the
+// interaction handle.
+template <typename... Args>
+void JournalRecord(JournalOp op, InteractionHandle interaction, Args... args) {
+  static thread_local std::string encoded;
+  encoded.clear();
+
+  size_t fieldEnds[sizeof...(Args) + 1] = {};
+  size_t field = 0;
+  ((JournalCodec<Args>::Encode(encoded, args), fieldEnds[field++] = encoded.size()), ...);
+
+  JournalAppend(interaction, op, encoded, fieldEnds, sizeof...(Args));
+}
+
+// Whether an FFI result means the call was applied, so is worth recording
+inline bool JournalSucceeded(bool result) { return result; }
+inline bool JournalSucceeded(int result) { return result == 0; }
+inline bool JournalSucceeded(unsigned int result) { return result == 0; }
+
+// Calls an interaction setter, and records the call if it succeeded. For calls the binding makes
+// itself rather than through an export, such as when importing a pact.
+template <typename R, typename... Params, typename... Args>
+R JournalCall(JournalOp op, R (*fn)(InteractionHandle, Params...), InteractionHandle interaction, Args... args) {
+  R result = fn(interaction, args...);
+  if (JournalSucceeded(result)) {
+    JournalRecord(op, interaction, static_cast<Params>(args)...);
+  }
+  return result;
+}
+
+
+// The arguments of the last `op` call on `interaction` whose leading arguments were `prefix`
+// (encoded as by JournalRecord), e.g. the body of one part. Returns false if there wasn't one.
+bool JournalFind(InteractionHandle interaction, JournalOp op, const std::string& prefix, std::string* args);
+
+enum JournalReplayResult {
+  JOURNAL_REPLAYED,
+  JOURNAL_NOT_FOUND,
+  JOURNAL_UNSUPPORTED,
+  JOURNAL_FAILED,
+};
+
+// Whether `interaction` can be replayed (JOURNAL_REPLAYED), and the pact it was created from. For
+// checking before creating the interaction to replay onto, as the FFI can't remove one again.
+JournalReplayResult JournalReplayable(InteractionHandle interaction, PactHandle* pact);
+
+// Replays every call recorded for `from` onto `to`, and copies them into `to`'s journal
+JournalReplayResult JournalReplay(InteractionHandle from, InteractionHandle to);
+
+// Adds the metadata and interactions recorded for `from` to `to`, as a worker's pact is folded into
+// the shared one it writes to (see aggregator.cc). `from` must record its interactions. Content
+// the journal can't replay is checked for before anything is added.
+JournalReplayResult JournalReplayPact(PactHandle from, PactHandle to);
+
+enum JournalSnapshotResult {
+  JOURNAL_SNAPSHOT_OK,
+  JOURNAL_SNAPSHOT_NOT_FOUND,
+  JOURNAL_SNAPSHOT_UNSUPPORTED,
+  JOURNAL_SNAPSHOT_UNREADABLE,
+};
+
+// Writes a pact's journal, and those of its interactions, to `out`. Not found for pacts that don't
+// record their interactions. Bodies recorded by path are read into the snapshot, so it doesn't
+// depend on the file; unreadable, with the reason in `error`, if one can't be read.
+JournalSnapshotResult JournalSnapshot(PactHandle pact, std::string* out, std::string* error);
+
+// Rebuilds a pact from a snapshot written by JournalSnapshot. Returns 0, with the reason in
+// `error`, if the snapshot is malformed, from an incompatible version, or can't be replayed.
+PactHandle JournalRestore(const char* data, size_t length, std::string* error);
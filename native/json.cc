@@ -0,0 +1,253 @@
+#include <napi.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "json.h"
+
+// Deeper than any fixture, and well short of the native stack
+static const size_t kMaxDepth = 1000;
+// Buffers that have grown past this are freed once released (see marshal.cc)
+static const size_t kMaxRetainedBytes = 8 * 1024 * 1024;
+
+// Output buffers, used as a stack like Utf8Arg's: a toJSON that calls back into the addon
+// serialises into the next one rather than over the top of this one
+struct JsonBufferPool {
+  std::vector<std::unique_ptr<std::string>> buffers;
+  size_t inUse = 0;
+};
+
+static thread_local JsonBufferPool pool;
+
+class JsonWriter {
+  public:
+    JsonWriter(napi_env env, std::string& out) : env(env), out(out) {}
+
+    // Returns false, writing nothing, for values JSON has no representation for (undefined,
+    // functions and symbols), so the caller can skip or null them
+    bool Write(napi_value value) {
+      napi_valuetype type;
+      check(napi_typeof(env, value, &type));
+
+      switch (type) {
+        case napi_undefined:
+        case napi_function:
+        case napi_symbol:
+        case napi_external:
+          return false;
+        case napi_null:
+          out += "null";
+          return true;
+        case napi_boolean: {
+          bool b;
+          check(napi_get_value_bool(env, value, &b));
+          out += b ? "true" : "false";
+          return true;
+        }
+        case napi_number: {
+          double number;
+          check(napi_get_value_double(env, value, &number));
+          WriteNumber(number);
+          return true;
+        }
+        case napi_string:
+          WriteString(value);
+          return true;
+        case napi_bigint:
+          throw Napi::TypeError::New(env, "Do not know how to serialize a BigInt");
+        case napi_object:
+          return WriteObject(value);
+      }
+
+      return false;
+    }
+
+  private:
+    napi_env env;
+    std::string& out;
+    std::string scratch;
+    // Containers being written, to detect cycles
+    std::vector<napi_value> path;
+
+    void check(napi_status status) {
+      if (status != napi_ok) {
+        throw Napi::Error::New(env);
+      }
+    }
+
+    void WriteNumber(double number) {
+      char digits[32];
+
+      if (!std::isfinite(number)) {
+        out += "null";
+        return;
+      }
+
+      if (number == std::floor(number) && std::fabs(number) < 9007199254740992.0) {
+        snprintf(digits, sizeof(digits), "%lld", static_cast<long long>(number));
+        out += digits;
+        return;
+      }
+
+      // The fewest significant digits that read back as the same double, as JS prints numbers
+      for (int precision = 15; precision <= 17; precision++) {
+        snprintf(digits, sizeof(digits), "%.*g", precision, number);
+        if (strtod(digits, NULL) == number) {
+          break;
+        }
+      }
+      out += digits;
+    }
+
+    void WriteString(napi_value value) {
+      size_t length;
+      check(napi_get_value_string_utf8(env, value, NULL, 0, &length));
+      scratch.resize(length);
+      check(napi_get_value_string_utf8(env, value, &scratch[0], length + 1, &length));
+
+      static const char hex[] = "0123456789abcdef";
+      out.reserve(out.size() + length + 2);
+      out += '"';
+      size_t run = 0;
+      for (size_t i = 0; i < length; i++) {
+        unsigned char c = static_cast<unsigned char>(scratch[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+          continue;
+        }
+
+        out.append(scratch, run, i - run);
+        run = i + 1;
+        switch (c) {
+          case '"': out += "\\\""; break;
+          case '\\': out += "\\\\"; break;
+          case '\b': out += "\\b"; break;
+          case '\f': out += "\\f"; break;
+          case '\n': out += "\\n"; break;
+          case '\r': out += "\\r"; break;
+          case '\t': out += "\\t"; break;
+          default:
+            out += "\\u00";
+            out += hex[c >> 4];
+            out += hex[c & 0xf];
+        }
+      }
+      out.append(scratch, run, length - run);
+      out += '"';
+    }
+
+    bool WriteObject(napi_value object) {
+      // Dates and anything else with a toJSON are written as what it returns
+      napi_value toJson;
+      check(napi_get_named_property(env, object, "toJSON", &toJson));
+      napi_valuetype toJsonType;
+      check(napi_typeof(env, toJson, &toJsonType));
+      if (toJsonType == napi_function) {
+        napi_value key, result;
+        check(napi_create_string_utf8(env, "", 0, &key));
+        check(napi_call_function(env, object, toJson, 1, &key, &result));
+        return Write(result);
+      }
+
+      if (path.size() >= kMaxDepth) {
+        throw Napi::RangeError::New(env, "Body is nested too deeply to serialize");
+      }
+      for (napi_value seen : path) {
+        bool same;
+        check(napi_strict_equals(env, seen, object, &same));
+        if (same) {
+          throw Napi::TypeError::New(env, "Converting circular structure to JSON");
+        }
+      }
+
+      Napi::HandleScope scope(env);
+      path.push_back(object);
+
+      bool isArray;
+      check(napi_is_array(env, object, &isArray));
+      if (isArray) {
+        WriteArray(object);
+      } else {
+        WriteProperties(object);
+      }
+
+      path.pop_back();
+      return true;
+    }
+
+    void WriteArray(napi_value array) {
+      uint32_t length;
+      check(napi_get_array_length(env, array, &length));
+
+      out += '[';
+      for (uint32_t i = 0; i < length; i++) {
+        if (i > 0) {
+          out += ',';
+        }
+        napi_value element;
+        check(napi_get_element(env, array, i, &element));
+        if (!Write(element)) {
+          out += "null";
+        }
+      }
+      out += ']';
+    }
+
+    void WriteProperties(napi_value object) {
+      napi_value keys;
+      check(napi_get_all_property_names(env, object, napi_key_own_only,
+        static_cast<napi_key_filter>(napi_key_enumerable | napi_key_skip_symbols),
+        napi_key_numbers_to_strings, &keys));
+      uint32_t count;
+      check(napi_get_array_length(env, keys, &count));
+
+      out += '{';
+      bool first = true;
+      for (uint32_t i = 0; i < count; i++) {
+        napi_value key, value;
+        check(napi_get_element(env, keys, i, &key));
+        check(napi_get_property(env, object, key, &value));
+
+        // Written tentatively, and dropped again if the value turns out to be unrepresentable
+        size_t mark = out.size();
+        if (!first) {
+          out += ',';
+        }
+        WriteString(key);
+        out += ':';
+        if (Write(value)) {
+          first = false;
+        } else {
+          out.resize(mark);
+        }
+      }
+      out += '}';
+    }
+};
+
+JsonArg::JsonArg(Napi::Value value) {
+  napi_env env = value.Env();
+
+  if (pool.inUse == pool.buffers.size()) {
+    pool.buffers.emplace_back(new std::string());
+  }
+  buffer = pool.buffers[pool.inUse++].get();
+  buffer->clear();
+
+  try {
+    JsonWriter writer(env, *buffer);
+    if (!writer.Write(value)) {
+      throw Napi::TypeError::New(env, "Body has no JSON representation");
+    }
+  } catch (...) {
+    pool.inUse--;
+    throw;
+  }
+}
+
+JsonArg::~JsonArg() {
+  pool.inUse--;
+  if (buffer->capacity() > kMaxRetainedBytes) {
+    std::string().swap(*buffer);
+  }
+}
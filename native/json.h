@@ -0,0 +1,28 @@
+#pragma once
+
+#include <napi.h>
+#include <string>
+
+// A body argument given as a JS object or array, serialised to JSON natively rather than with
+// JSON.stringify in JS followed by a UTF-8 copy here. Follows JSON.stringify's rules: `toJSON` is
+// honoured, undefined, functions and symbols are skipped in objects and written as null in arrays,
+// non-finite numbers are written as null, and BigInts and cycles are errors. Keys are written in
+// property order and unchanged, so embedded matchers (`pact:matcher:type` and friends) reach the
+// core exactly as given.
+//
+// Serialises into a per thread buffer reused from call to call, with the same lifetime rules as
+// Utf8Arg (see marshal.h): only valid until it goes out of scope.
+class JsonArg {
+  public:
+    explicit JsonArg(Napi::Value value);
+    ~JsonArg();
+
+    JsonArg(const JsonArg&) = delete;
+    JsonArg& operator=(const JsonArg&) = delete;
+
+    const char* c_str() const { return buffer->c_str(); }
+    size_t length() const { return buffer->size(); }
+
+  private:
+    std::string* buffer;
+};
@@ -0,0 +1,185 @@
+#include <napi.h>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "pact-cpp.h"
+#include "addon.h"
+#include "logs.h"
+
+using namespace Napi;
+
+// Core log records split out per test. The records come from mock servers, whose records the core
+// already keeps in a buffer per server, and are attributed to the test run id that was active when
+// the server was started. This requires a `buffer` sink to have been configured on the core logger.
+//
+// Records written to the core's global buffer (by the DSL calls themselves) aren't attributed: the
+// FFI can only copy that buffer out whole, and it is append only, so splitting it at each change of
+// test run id would copy it again every time, at a cost that grows with the length of the run.
+
+// The state lives in each environment's PactAddon (see addon.h), so tests running in different
+// worker threads are attributed independently.
+
+// Appends whatever has been written to a core buffer since `offset`, and moves `offset` past it
+static void appendNewRecords(const char* logs, size_t& offset, std::string* into) {
+  if (logs == NULL) {
+    return;
+  }
+
+  size_t length = strlen(logs);
+  if (length > offset) {
+    if (into != NULL) {
+      into->append(logs + offset, length - offset);
+    }
+    offset = length;
+  }
+}
+
+// The mock server logs are owned by the mock server and released by `pactffi_cleanup_mock_server`,
+// so they are not freed here.
+static void drainMockServer(TestLogsState& state, int32_t port, MockServerLogs& server) {
+  const char* logs = pactffi_mock_server_logs(port);
+  appendNewRecords(logs, server.offset, &state.testLogs[server.owner].contents);
+}
+
+void TestLogsSetActive(Napi::Env env, const std::string& testRunId) {
+  TestLogsState& state = PactAddon::From(env)->testLogs;
+
+  if (!state.enabled) {
+    return;
+  }
+
+  state.activeTestRunId = testRunId;
+}
+
+void TestLogsTrackMockServer(Napi::Env env, int32_t port) {
+  TestLogsState& state = PactAddon::From(env)->testLogs;
+
+  if (!state.enabled || state.activeTestRunId.empty()) {
+    return;
+  }
+
+  state.mockServerLogs[port] = MockServerLogs{state.activeTestRunId, 0};
+  state.testLogs[state.activeTestRunId].ports.push_back(port);
+}
+
+void TestLogsReleaseMockServer(Napi::Env env, int32_t port) {
+  TestLogsState& state = PactAddon::From(env)->testLogs;
+
+  auto server = state.mockServerLogs.find(port);
+  if (server == state.mockServerLogs.end()) {
+    return;
+  }
+
+  // Cleaning up the mock server frees its logs, so keep whatever the test hasn't fetched yet
+  drainMockServer(state, port, server->second);
+
+  std::vector<int32_t>& ports = state.testLogs[server->second.owner].ports;
+  for (auto it = ports.begin(); it != ports.end(); ++it) {
+    if (*it == port) {
+      ports.erase(it);
+      break;
+    }
+  }
+
+  state.mockServerLogs.erase(server);
+}
+
+/**
+ * Starts splitting the records of mock servers by test run id (see `pactffiSetTestRunId`) and by
+ * port. A `buffer` sink must be configured on the core logger for there to be anything to split.
+ */
+Napi::Value PactffiEnableTestLogs(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  TestLogsState& state = PactAddon::From(env)->testLogs;
+
+  state.enabled = true;
+
+  return env.Undefined();
+}
+
+/**
+ * Returns the core log records collected for a test, and clears them.
+ *
+ * * `key` - a test run id, or the port of a mock server. Fetching by port returns the records
+ *   written by that mock server since it was last fetched.
+ */
+Napi::Value PactffiFetchTestLogs(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiFetchTestLogs received < 1 arguments");
+  }
+
+  if (!info[0].IsString() && !info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiFetchTestLogs(arg 0) expected a string or a number");
+  }
+
+  TestLogsState& state = PactAddon::From(env)->testLogs;
+  std::string contents;
+
+  if (info[0].IsNumber()) {
+    int32_t port = info[0].As<Napi::Number>().Int32Value();
+    auto server = state.mockServerLogs.find(port);
+
+    if (server == state.mockServerLogs.end()) {
+      size_t offset = 0;
+      appendNewRecords(pactffi_mock_server_logs(port), offset, &contents);
+    } else {
+      appendNewRecords(pactffi_mock_server_logs(port), server->second.offset, &contents);
+    }
+
+    return Napi::String::New(env, contents);
+  }
+
+  std::string testRunId = info[0].As<Napi::String>().Utf8Value();
+  auto buffer = state.testLogs.find(testRunId);
+  if (buffer == state.testLogs.end()) {
+    return Napi::String::New(env, contents);
+  }
+
+  for (int32_t port : buffer->second.ports) {
+    drainMockServer(state, port, state.mockServerLogs[port]);
+  }
+
+  contents.swap(buffer->second.contents);
+  if (buffer->second.ports.empty()) {
+    state.testLogs.erase(buffer);
+  }
+
+  return Napi::String::New(env, contents);
+}
+
+/**
+ * Drops the core log records collected for a test without copying them out. Intended for
+ * passing tests, whose logs are not needed.
+ *
+ * * `testRunId` - the test run id the records were collected under.
+ */
+Napi::Value PactffiDiscardTestLogs(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiDiscardTestLogs received < 1 arguments");
+  }
+
+  if (!info[0].IsString()) {
+    throw Napi::Error::New(env, "PactffiDiscardTestLogs(arg 0) expected a string");
+  }
+
+  TestLogsState& state = PactAddon::From(env)->testLogs;
+
+  std::string testRunId = info[0].As<Napi::String>().Utf8Value();
+  auto buffer = state.testLogs.find(testRunId);
+  if (buffer == state.testLogs.end()) {
+    return env.Undefined();
+  }
+
+  for (int32_t port : buffer->second.ports) {
+    state.mockServerLogs.erase(port);
+  }
+  state.testLogs.erase(buffer);
+
+  return env.Undefined();
+}
@@ -0,0 +1,10 @@
+#include <napi.h>
+
+// Hooks used by the consumer bindings to attribute core logs to a test
+void TestLogsSetActive(Napi::Env env, const std::string& testRunId);
+void TestLogsTrackMockServer(Napi::Env env, int32_t port);
+void TestLogsReleaseMockServer(Napi::Env env, int32_t port);
+
+Napi::Value PactffiEnableTestLogs(const Napi::CallbackInfo& info);
+Napi::Value PactffiFetchTestLogs(const Napi::CallbackInfo& info);
+Napi::Value PactffiDiscardTestLogs(const Napi::CallbackInfo& info);
@@ -0,0 +1,187 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "mapped_file.h"
+
+static const uint8_t kEmpty[1] = {0};
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+#if defined(_WIN32)
+
+static std::string lastError(const char* what, const char* path) {
+  return std::string(what) + " " + path + " (error " + std::to_string(GetLastError()) + ")";
+}
+
+bool MappedFile::Open(const char* path, std::string* error) {
+  Close();
+
+  int wideLength = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+  std::wstring widePath(wideLength > 0 ? wideLength : 1, L'\0');
+  MultiByteToWideChar(CP_UTF8, 0, path, -1, &widePath[0], wideLength);
+
+  HANDLE handle = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (handle == INVALID_HANDLE_VALUE) {
+    *error = lastError("unable to open", path);
+    return false;
+  }
+  file = handle;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(handle, &fileSize)) {
+    *error = lastError("unable to read the size of", path);
+    Close();
+    return false;
+  }
+  length = static_cast<uint64_t>(fileSize.QuadPart);
+  if (length > SIZE_MAX) {
+    *error = std::string(path) + " is too large to map in a 32 bit process";
+    Close();
+    return false;
+  }
+
+  if (length == 0) {
+    region = kEmpty;
+    return true;
+  }
+
+  mapping = CreateFileMappingW(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL) {
+    *error = lastError("unable to map", path);
+    Close();
+    return false;
+  }
+
+  region = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (region == NULL) {
+    *error = lastError("unable to map", path);
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+void MappedFile::Close() {
+  if (region != nullptr && region != kEmpty) {
+    UnmapViewOfFile(region);
+  }
+  if (mapping != nullptr) {
+    CloseHandle(mapping);
+  }
+  if (file != nullptr) {
+    CloseHandle(file);
+  }
+  region = nullptr;
+  mapping = nullptr;
+  file = nullptr;
+  length = 0;
+}
+
+std::string AbsoluteFilePath(const char* path) {
+  int wideLength = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+  std::wstring widePath(wideLength > 0 ? wideLength : 1, L'\0');
+  MultiByteToWideChar(CP_UTF8, 0, path, -1, &widePath[0], wideLength);
+
+  DWORD fullLength = GetFullPathNameW(widePath.c_str(), 0, NULL, NULL);
+  if (fullLength == 0) {
+    return path;
+  }
+  std::wstring fullPath(fullLength, L'\0');
+  fullLength = GetFullPathNameW(widePath.c_str(), fullLength, &fullPath[0], NULL);
+  if (fullLength == 0) {
+    return path;
+  }
+
+  int utf8Length = WideCharToMultiByte(CP_UTF8, 0, fullPath.c_str(), static_cast<int>(fullLength), NULL, 0, NULL, NULL);
+  std::string result(utf8Length > 0 ? utf8Length : 0, '\0');
+  WideCharToMultiByte(CP_UTF8, 0, fullPath.c_str(), static_cast<int>(fullLength), &result[0], utf8Length, NULL, NULL);
+  return result;
+}
+
+#else
+
+static std::string lastError(const char* what, const char* path) {
+  return std::string(what) + " " + path + " (" + strerror(errno) + ")";
+}
+
+std::string AbsoluteFilePath(const char* path) {
+  char* resolved = realpath(path, NULL);
+  if (resolved == NULL) {
+    return path;
+  }
+  std::string result(resolved);
+  free(resolved);
+  return result;
+}
+
+bool MappedFile::Open(const char* path, std::string* error) {
+  Close();
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    *error = lastError("unable to open", path);
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    *error = lastError("unable to read the size of", path);
+    close(fd);
+    return false;
+  }
+  if (!S_ISREG(info.st_mode)) {
+    *error = std::string(path) + " is not a file";
+    close(fd);
+    return false;
+  }
+  length = static_cast<uint64_t>(info.st_size);
+  if (length > SIZE_MAX) {
+    *error = std::string(path) + " is too large to map in a 32 bit process";
+    close(fd);
+    length = 0;
+    return false;
+  }
+
+  if (length == 0) {
+    close(fd);
+    region = kEmpty;
+    return true;
+  }
+
+  void* mapped = mmap(NULL, static_cast<size_t>(length), PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    *error = lastError("unable to map", path);
+    length = 0;
+    return false;
+  }
+
+  // Read front to back, by the parser or the FFI
+  madvise(mapped, static_cast<size_t>(length), MADV_SEQUENTIAL);
+  region = static_cast<const uint8_t*>(mapped);
+  return true;
+}
+
+void MappedFile::Close() {
+  if (region != nullptr && region != kEmpty) {
+    munmap(const_cast<uint8_t*>(region), static_cast<size_t>(length));
+  }
+  region = nullptr;
+  length = 0;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// A file mapped read only into memory for the life of the object, so large files can be handed
+// to the FFI (or parsed) without being read into a buffer first. Sizes are 64 bit throughout.
+// Empty files map to an empty, non NULL region.
+class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps `path`. Returns false, with a description of the failure in `error`, if it can't be
+    // opened or mapped.
+    bool Open(const char* path, std::string* error);
+
+    const uint8_t* data() const { return region; }
+    uint64_t size() const { return length; }
+
+  private:
+    const uint8_t* region = nullptr;
+    uint64_t length = 0;
+#if defined(_WIN32)
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+
+    void Close();
+};
+
+// `path` made absolute (against the current directory), so it still names the same file if the
+// directory changes. `path` as it is if it can't be resolved.
+std::string AbsoluteFilePath(const char* path);
@@ -0,0 +1,87 @@
+#include <napi.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "marshal.h"
+
+// Buffers for strings too long to decode on the stack. Utf8Args are locals, so they are released
+// in the reverse order they were taken, and the buffers are used as a stack: an export with two
+// long arguments holds two of them at once.
+struct PooledBuffer {
+  std::unique_ptr<char[]> data;
+  size_t capacity = 0;
+};
+
+struct BufferPool {
+  std::vector<PooledBuffer> buffers;
+  size_t inUse = 0;
+};
+
+// Buffers that have grown past this are freed once released, so one very large body doesn't
+// stay resident for the life of the thread
+static const size_t kMaxRetainedBytes = 8 * 1024 * 1024;
+// The most a character takes in UTF-8. Decoding never splits a character, so a result that
+// leaves at least this much of the buffer unused cannot have been truncated.
+static const size_t kMaxCharBytes = 4;
+
+static thread_local BufferPool pool;
+static thread_local MarshalCounters counters = {};
+
+Utf8Arg::Utf8Arg(Napi::Value value) : data(inlineBuffer), len(0), pooled(-1) {
+  napi_env env = value.Env();
+  counters.strings++;
+
+  napi_status status = napi_get_value_string_utf8(env, value, inlineBuffer, kInlineSize, &len);
+  if (status != napi_ok) {
+    throw Napi::Error::New(env);
+  }
+  if (len + kMaxCharBytes < kInlineSize) {
+    return;
+  }
+
+  // Possibly truncated: find the real length, and decode again into a buffer big enough
+  status = napi_get_value_string_utf8(env, value, NULL, 0, &len);
+  if (status != napi_ok) {
+    throw Napi::Error::New(env);
+  }
+
+  if (pool.inUse == pool.buffers.size()) {
+    pool.buffers.emplace_back();
+  }
+  PooledBuffer& buffer = pool.buffers[pool.inUse];
+  if (buffer.capacity < len + 1) {
+    buffer.capacity = std::max(len + 1, buffer.capacity * 2);
+    buffer.data.reset(new char[buffer.capacity]);
+    counters.heapAllocations++;
+  }
+  counters.pooled++;
+
+  status = napi_get_value_string_utf8(env, value, buffer.data.get(), len + 1, &len);
+  if (status != napi_ok) {
+    throw Napi::Error::New(env);
+  }
+
+  pooled = static_cast<int>(pool.inUse++);
+  data = buffer.data.get();
+}
+
+Utf8Arg::~Utf8Arg() {
+  if (pooled < 0) {
+    return;
+  }
+
+  pool.inUse--;
+  PooledBuffer& buffer = pool.buffers[pooled];
+  if (buffer.capacity > kMaxRetainedBytes) {
+    buffer.data.reset();
+    buffer.capacity = 0;
+  }
+}
+
+MarshalCounters MarshalStats(bool reset) {
+  MarshalCounters snapshot = counters;
+  if (reset) {
+    counters = {};
+  }
+  return snapshot;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <napi.h>
+#include <string>
+
+// A string argument decoded to the NUL terminated UTF-8 the FFI takes, without a heap allocation
+// per call. Strings that fit are decoded into a buffer on the stack; longer ones into a buffer
+// kept per thread and reused from call to call. Only valid until it goes out of scope, so create
+// it as a local in the export and hand `c_str()` to the FFI, which copies what it keeps.
+//
+// The caller checks the argument is a string first, as with `As<Napi::String>()`.
+class Utf8Arg {
+  public:
+    explicit Utf8Arg(Napi::Value value);
+    ~Utf8Arg();
+
+    Utf8Arg(const Utf8Arg&) = delete;
+    Utf8Arg& operator=(const Utf8Arg&) = delete;
+
+    const char* c_str() const { return data; }
+    size_t length() const { return len; }
+    bool empty() const { return len == 0; }
+    std::string str() const { return std::string(data, len); }
+
+  private:
+    // Covers header names and values, paths, descriptions and content types. Bodies and
+    // matching rules usually go through the per thread buffers.
+    static const size_t kInlineSize = 128;
+
+    char inlineBuffer[kInlineSize];
+    const char* data;
+    size_t len;
+    // Index of the per thread buffer in use, or -1 when decoded inline
+    int pooled;
+};
+
+// Counts of string arguments decoded on this thread, and how many of them needed a heap
+// allocation (a per thread buffer being created or grown), for `pactffiStats`
+struct MarshalCounters {
+  uint64_t strings;
+  uint64_t pooled;
+  uint64_t heapAllocations;
+};
+
+MarshalCounters MarshalStats(bool reset);
@@ -0,0 +1,154 @@
+#include <napi.h>
+#include <string>
+#include <vector>
+#include "pact-cpp.h"
+#include "marshal.h"
+#include "matchers.h"
+
+// A parsed matcher definition, freed when the export returns or throws
+class ParsedDefinition {
+  public:
+    explicit ParsedDefinition(const char* expression) : definition(pactffi_parse_matcher_definition(expression)) {}
+    ~ParsedDefinition() {
+      if (definition != NULL) {
+        pactffi_matcher_definition_delete(definition);
+      }
+    }
+
+    ParsedDefinition(const ParsedDefinition&) = delete;
+    ParsedDefinition& operator=(const ParsedDefinition&) = delete;
+
+    const MatchingRuleDefinitionResult* get() const { return definition; }
+
+  private:
+    const MatchingRuleDefinitionResult* definition;
+};
+
+// The iterator over a definition's rules. It owns the rules it yields, so has to outlive every
+// use of them.
+class RuleIterator {
+  public:
+    explicit RuleIterator(const MatchingRuleDefinitionResult* definition) : iter(pactffi_matcher_definition_iter(definition)) {}
+    ~RuleIterator() {
+      if (iter != NULL) {
+        pactffi_matching_rule_iter_delete(iter);
+      }
+    }
+
+    RuleIterator(const RuleIterator&) = delete;
+    RuleIterator& operator=(const RuleIterator&) = delete;
+
+    MatchingRuleIterator* get() const { return iter; }
+
+  private:
+    MatchingRuleIterator* iter;
+};
+
+// Takes a string the FFI allocated, and frees it
+static std::string TakeString(const char* value) {
+  std::string result(value);
+  pactffi_string_delete(const_cast<char*>(value));
+  return result;
+}
+
+/**
+ * Evaluates candidate values against a matcher definition, with the core's matching semantics, in
+ * one call. For validating generated fixtures before they go into interactions.
+ *
+ * * `definition` - a matcher definition expression, as used in the integration JSON, such as
+ *   `matching(regex, '[0-9]+', '100')`, `matching(type, 'fido')` or
+ *   `matching(datetime, 'yyyy-MM-dd', '2000-01-01')`. Several can be given separated by commas,
+ *   and a value must satisfy them all.
+ * * `values` - the candidate values, as strings.
+ *
+ * Returns an array with an entry per value: null if it matches, otherwise the core's mismatch
+ * message (the messages of several failing matchers are joined with `; `). A definition without
+ * a matcher requires values equal to its example. Throws if the definition can't be parsed or
+ * refers to another part of a body, which a lone value can't be matched against.
+ *
+ * The definition is parsed once, however many values there are.
+ *
+ * C interface:
+ *
+ *    const MatchingRuleDefinitionResult *pactffi_parse_matcher_definition(const char *expression);
+ *    const char *pactffi_matches_string_value(const MatchingRule *matching_rule,
+ *                                             const char *expected_value,
+ *                                             const char *actual_value,
+ *                                             uint8_t cascaded);
+ */
+Napi::Value PactffiMatchValues(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    throw Napi::Error::New(env, "PactffiMatchValues received < 2 arguments");
+  }
+
+  if (!info[0].IsString()) {
+    throw Napi::Error::New(env, "PactffiMatchValues(arg 0) expected a string");
+  }
+
+  if (!info[1].IsArray()) {
+    throw Napi::Error::New(env, "PactffiMatchValues(arg 1) expected an array of strings");
+  }
+
+  Napi::Array values = info[1].As<Napi::Array>();
+  uint32_t count = values.Length();
+  for (uint32_t i = 0; i < count; i++) {
+    if (!values.Get(i).IsString()) {
+      throw Napi::Error::New(env, "PactffiMatchValues(arg 1) expected an array of strings");
+    }
+  }
+
+  Utf8Arg expression(info[0]);
+  ParsedDefinition parsed(expression.c_str());
+  if (parsed.get() == NULL) {
+    throw Napi::Error::New(env, "PactffiMatchValues(arg 0) could not be parsed");
+  }
+
+  const char* error = pactffi_matcher_definition_error(parsed.get());
+  if (error != NULL) {
+    throw Napi::Error::New(env, "PactffiMatchValues(arg 0) is not a valid matcher definition: " + TakeString(error));
+  }
+
+  const char* value = pactffi_matcher_definition_value(parsed.get());
+  std::string expected = value != NULL ? TakeString(value) : std::string();
+
+  std::vector<const MatchingRule*> rules;
+  RuleIterator iter(parsed.get());
+  if (iter.get() != NULL) {
+    const MatchingRuleResult* result;
+    while ((result = pactffi_matching_rule_iter_next(iter.get())) != NULL) {
+      const MatchingRule* rule = pactffi_matching_rule_pointer(result);
+      if (rule == NULL) {
+        throw Napi::Error::New(env, "PactffiMatchValues(arg 0) refers to another part of a body, so can't match a lone value");
+      }
+      rules.push_back(rule);
+    }
+  }
+
+  Napi::Array results = Napi::Array::New(env, count);
+  std::string mismatch;
+  for (uint32_t i = 0; i < count; i++) {
+    Utf8Arg actual(values.Get(i));
+    mismatch.clear();
+
+    if (rules.empty()) {
+      if (actual.str() != expected) {
+        mismatch = "Expected '" + actual.str() + "' to be equal to '" + expected + "'";
+      }
+    }
+    for (const MatchingRule* rule : rules) {
+      const char* message = pactffi_matches_string_value(rule, expected.c_str(), actual.c_str(), 0);
+      if (message != NULL) {
+        if (!mismatch.empty()) {
+          mismatch += "; ";
+        }
+        mismatch += TakeString(message);
+      }
+    }
+
+    results.Set(i, mismatch.empty() ? env.Null() : Napi::String::New(env, mismatch));
+  }
+
+  return results;
+}
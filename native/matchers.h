@@ -0,0 +1,3 @@
+#include <napi.h>
+
+Napi::Value PactffiMatchValues(const Napi::CallbackInfo& info);
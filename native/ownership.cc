@@ -0,0 +1,21 @@
+#include <napi.h>
+#include "addon.h"
+#include "ownership.h"
+
+using namespace Napi;
+
+void ExternalMemoryRetainForMockServer(Napi::Env env, int32_t port, size_t bytes) {
+  PactAddon::From(env)->mockServerExternalBytes[port] += bytes;
+  MemoryManagement::AdjustExternalMemory(env, static_cast<int64_t>(bytes));
+}
+
+void ExternalMemoryReleaseMockServer(Napi::Env env, int32_t port) {
+  std::unordered_map<int32_t, size_t>& retained = PactAddon::From(env)->mockServerExternalBytes;
+  auto it = retained.find(port);
+  if (it == retained.end()) {
+    return;
+  }
+
+  MemoryManagement::AdjustExternalMemory(env, -static_cast<int64_t>(it->second));
+  retained.erase(it);
+}
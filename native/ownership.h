@@ -0,0 +1,93 @@
+#pragma once
+
+#include <napi.h>
+#include <string>
+#include <vector>
+#include "pact-cpp.h"
+
+// Owners for memory that crosses the FFI boundary. Every export that receives memory from pact_ffi
+// that it is responsible for freeing holds it in one of these, so it is released on every return
+// path, including when a Napi::Error is thrown part way through.
+
+// A string allocated by pact_ffi, released with `pactffi_string_delete`. Only for strings the FFI
+// documents as the caller's to free; strings that belong to a mock server (mismatches, logs) are
+// freed by `pactffi_cleanup_mock_server` and must not be wrapped.
+class FfiString {
+  public:
+    explicit FfiString(const char* str) : str(const_cast<char*>(str)) {}
+    ~FfiString() { pactffi_string_delete(str); }
+
+    FfiString(const FfiString&) = delete;
+    FfiString& operator=(const FfiString&) = delete;
+
+    const char* get() const { return str; }
+    bool isNull() const { return str == NULL; }
+
+    // Copies the string into a JS string, or returns null for a NULL pointer
+    Napi::Value ToValue(Napi::Env env) const {
+      if (str == NULL) {
+        return env.Null();
+      }
+      return Napi::String::New(env, str);
+    }
+
+  private:
+    char* str;
+};
+
+// An object allocated by pact_ffi that has its own delete function, such as a message iterator
+template <typename T, void (*Delete)(T*)>
+class FfiPtr {
+  public:
+    explicit FfiPtr(T* ptr) : ptr(ptr) {}
+    ~FfiPtr() {
+      if (ptr != nullptr) {
+        Delete(ptr);
+      }
+    }
+
+    FfiPtr(const FfiPtr&) = delete;
+    FfiPtr& operator=(const FfiPtr&) = delete;
+
+    T* get() const { return ptr; }
+    bool isNull() const { return ptr == nullptr; }
+
+  private:
+    T* ptr;
+};
+
+using MessageIterPtr = FfiPtr<PactMessageIterator, pactffi_pact_message_iter_delete>;
+using SyncMessageIterPtr = FfiPtr<PactSyncMessageIterator, pactffi_pact_sync_message_iter_delete>;
+
+// A JS array of strings as the `const char* const*` + length pairs the verifier setters take. The
+// core copies what it needs before returning, so the strings only have to outlive the call.
+class CStringArray {
+  public:
+    explicit CStringArray(Napi::Array arr) {
+      strings.reserve(arr.Length());
+      for (size_t i = 0; i < arr.Length(); i++) {
+        strings.push_back(arr.Get(i).As<Napi::String>().Utf8Value());
+      }
+      // Pointers are taken once the strings stop moving
+      for (const std::string& str : strings) {
+        pointers.push_back(str.c_str());
+      }
+    }
+
+    CStringArray(const CStringArray&) = delete;
+    CStringArray& operator=(const CStringArray&) = delete;
+
+    // Never dangling, even for an empty array
+    const char* const* data() const { return pointers.empty() ? &empty : pointers.data(); }
+    size_t size() const { return pointers.size(); }
+
+  private:
+    std::vector<std::string> strings;
+    std::vector<const char*> pointers;
+    const char* empty = NULL;
+};
+
+// Accounts for FFI memory a mock server holds on to between calls (each mismatch report is kept
+// until the server is cleaned up) with V8, so GC pressure reflects what the process really holds
+void ExternalMemoryRetainForMockServer(Napi::Env env, int32_t port, size_t bytes);
+void ExternalMemoryReleaseMockServer(Napi::Env env, int32_t port);
@@ -2,44 +2,62 @@
 #include <map>
 #include "pact-cpp.h"
 #include <vector>
+#include "addon.h"
+#include "ownership.h"
+#include "trace.h"
+#include "marshal.h"
+#include "typed_export.h"
 
 using namespace Napi;
 
-// To save passing the struct around. Remove once the rust types are made opaque
-std::map<int, VerifierHandle*> handles;
-
- std::vector<const char*> NapiArrayToCStringVector(Napi::Array arr) {
-  std::vector<const char*> cVec;
-  for(size_t i = 0; i < arr.Length(); i++) {
-      std::string tag = arr.Get(i).As<Napi::String>().Utf8Value();
-      char *cstr = strdup(tag.c_str());
-      cVec.push_back(cstr);
-  }
-
-  return cVec;
+// Verifier handles are kept per environment (see addon.h), so workers can't use each other's.
+// Returns NULL for an unknown id, which the core treats as an invalid handle.
+static VerifierHandle* lookupVerifier(Napi::Env env, uint32_t handleId) {
+  VerifierTable& verifiers = PactAddon::From(env)->verifiers;
+  auto it = verifiers.handles.find(handleId);
+  return it == verifiers.handles.end() ? NULL : it->second;
 }
 
+// Typed exports (see typed_export.h) take a verifier as the id PactffiVerifierNewForApplication
+// returned
+template <>
+struct ArgTraits<VerifierHandle*> {
+  static constexpr napi_valuetype type = napi_number;
+  static constexpr const char* expected = "a number (VerifierHandle)";
+  struct Holder {
+    explicit Holder(Napi::Value value) : value(lookupVerifier(value.Env(), value.As<Napi::Number>().Uint32Value())) {}
+    VerifierHandle* value;
+  };
+  static VerifierHandle* Get(const Holder& holder) { return holder.value; }
+};
+
 class VerificationWorker : public AsyncWorker {
     public:
-        VerificationWorker(Function& callback, size_t handle)
-        : AsyncWorker(callback), handle(handle) {}
+        // The handle is looked up here, on the JS thread, as the handle table is not thread safe
+        VerificationWorker(Function& callback, int handleId, VerifierHandle* handle)
+        : AsyncWorker(callback), handleId(handleId), handle(handle) {
+          PactAddon::From(Env())->verifiers.executing.insert(handleId);
+        }
 
         ~VerificationWorker() {}
 
     // This code will be executed on the worker thread
     void Execute() override {
-      VerifierHandle *h = handles[handle];
-      result = pactffi_verifier_execute(h);
+      uint64_t start = TraceNow();
+      result = pactffi_verifier_execute(handle);
+      TraceComplete("VerificationWorker::Execute", "async-worker", start, "verifier", handleId, true, result);
     }
 
     void OnOK() override {
         HandleScope scope(Env());
+        PactAddon::From(Env())->verifiers.executing.erase(handleId);
         Callback().Call({Env().Null(), Number::New(Env(), result)});
     }
 
     private:
       int result;
-      int handle;
+      int handleId;
+      VerifierHandle* handle;
 
 };
 
@@ -58,26 +76,28 @@ class VerificationWorker : public AsyncWorker {
 Napi::Value PactffiVerifierNewForApplication(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   if (info.Length() < 2) {
-    throw Napi::Error::New(env,  "PactffiNewForApplication received < 2 arguments");
+    throw Napi::Error::New(env, "PactffiVerifierNewForApplication received < 2 arguments");
   }
 
   if (!info[0].IsString()) {
-    throw Napi::Error::New(env, "PactffiNewForApplication(arg 0) expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierNewForApplication(arg 0) expected a string");
   }
 
   if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiNewForApplication(arg 1) expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierNewForApplication(arg 1) expected a string");
   }
 
   // Extract arguments to verifier
-  std::string name = info[0].As<Napi::String>().Utf8Value();
-  std::string version = info[1].As<Napi::String>().Utf8Value();
+  Utf8Arg name(info[0]);
+  Utf8Arg version(info[1]);
 
   // Store the pointer
   VerifierHandle *handle = pactffi_verifier_new_for_application(name.c_str(), version.c_str());
-  handles[handles.size()] = handle;
+  VerifierTable& verifiers = PactAddon::From(env)->verifiers;
+  int handleId = verifiers.nextId++;
+  verifiers.handles[handleId] = handle;
 
-  return Number::New(env, handles.size() - 1);
+  return Number::New(env, handleId);
 }
 
 /**
@@ -107,20 +127,24 @@ Napi::Value PactffiVerifierNewForApplication(const Napi::CallbackInfo& info) {
 Napi::Value PactffiVerifierExecute(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
-  if (info.Length() < 1) {
-    throw Napi::Error::New(env, "PactffiInit(arguments) received < 1 argument");
+  if (info.Length() < 2) {
+    throw Napi::Error::New(env, "PactffiVerifierExecute received < 2 arguments");
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiInit(arguments) expected a number");
+    throw Napi::Error::New(env, "PactffiVerifierExecute(arg 0) expected a VerifierHandle");
+  }
+
+  if (!info[1].IsFunction()) {
+    throw Napi::Error::New(env, "PactffiVerifierExecute(arg 1) expected a function");
   }
 
   // Extract arguments to verifier
-  size_t handle = info[0].As<Napi::Number>().Uint32Value();
+  uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
 
   // Execute the function asynchronously
   Napi::Function callback = info[1].As<Napi::Function>();
-  VerificationWorker* verificationWorker = new VerificationWorker(callback, handle);
+  VerificationWorker* verificationWorker = new VerificationWorker(callback, handleId, lookupVerifier(env, handleId));
   verificationWorker->Queue();
 
   return info.Env().Undefined();
@@ -143,20 +167,13 @@ Napi::Value PactffiVerifierJson(const Napi::CallbackInfo& info) {
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierJson(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierJson(arg 0) expected a VerifierHandle");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  const char* res = pactffi_verifier_json(handles[handleId]);
-
-  if (res == NULL) {
-    return env.Null();
-  }
-
-  Napi::String json = Napi::String::New(env, res);
-  pactffi_string_delete((char*)res);
+  FfiString json(pactffi_verifier_json(lookupVerifier(env, handleId)));
 
-  return json;
+  return json.ToValue(env);
 }
 
 
@@ -180,7 +197,12 @@ Napi::Value PactffiVerifierShutdown(const Napi::CallbackInfo& info) {
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
 
-  pactffi_verifier_shutdown(handles[handleId]);
+  VerifierTable& verifiers = PactAddon::From(env)->verifiers;
+  auto it = verifiers.handles.find(handleId);
+  if (it != verifiers.handles.end()) {
+    pactffi_verifier_shutdown(it->second);
+    verifiers.handles.erase(it);
+  }
 
   return info.Env().Undefined();
 }
@@ -204,47 +226,7 @@ Napi::Value PactffiVerifierShutdown(const Napi::CallbackInfo& info) {
  *                                           const char *path);
  *
  * */
-Napi::Value PactffiVerifierSetProviderInfo(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
-  if (info.Length() < 6) {
-    throw Napi::Error::New(env, "PactffiVerifierSetProviderInfo received < 6 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderInfo(arg 0) expected a VerifierHandle");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderInfo(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderInfo(arg 2 expected a string");
-  }
-
-  if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderInfo(arg 3 expected a string");
-  }
-
-  if (!info[4].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderInfo(arg 4) expected a number");
-  }
-
-  if (!info[5].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderInfo(arg 5) expected a string");
-  }
-
-  uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string name = info[1].As<Napi::String>().Utf8Value();
-  std::string scheme = info[2].As<Napi::String>().Utf8Value();
-  std::string host = info[3].As<Napi::String>().Utf8Value();
-  uint32_t port = info[4].As<Napi::Number>().Uint32Value();
-  std::string path = info[5].As<Napi::String>().Utf8Value();
-
-  pactffi_verifier_set_provider_info(handles[handleId], name.c_str(), scheme.c_str(), host.c_str(), port, path.c_str());
-
-  return info.Env().Undefined();
-}
+TYPED_EXPORT(PactffiVerifierSetProviderInfo, pactffi_verifier_set_provider_info)
 
 
 /**
@@ -270,42 +252,7 @@ Napi::Value PactffiVerifierSetProviderInfo(const Napi::CallbackInfo& info) {
  *                                           const char *scheme);
  *
  * */
-Napi::Value PactffiVerifierAddProviderTransport(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
-  if (info.Length() < 5) {
-    throw Napi::Error::New(env, "PactffiVerifierAddProviderTransport received < 6 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiVerifierAddProviderTransport(arg 0) expected a VerifierHandle");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiVerifierAddProviderTransport(arg 1) expected a string");
-  }
-
-  if (!info[2].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiVerifierAddProviderTransport(arg 2) expected a number");
-  }
-
-  if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "PactffiVerifierAddProviderTransport(arg 3) expected a string");
-  }
-
-  if (!info[4].IsString()) {
-    throw Napi::Error::New(env, "PactffiVerifierAddProviderTransport(arg 4) expected a string");
-  }
-
-  uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string protocol = info[1].As<Napi::String>().Utf8Value();
-  uint32_t port = info[2].As<Napi::Number>().Uint32Value();
-  std::string path = info[3].As<Napi::String>().Utf8Value();
-  std::string scheme = info[4].As<Napi::String>().Utf8Value();
-
-  pactffi_verifier_add_provider_transport(handles[handleId], protocol.c_str(), port, path.c_str(), scheme.c_str());
-
-  return info.Env().Undefined();
-}
+TYPED_EXPORT(PactffiVerifierAddProviderTransport, pactffi_verifier_add_provider_transport)
 
 /**
  * Enables or disables if no pacts are found to verify results in an error.
@@ -326,21 +273,21 @@ Napi::Value PactffiVerifierAddProviderTransport(const Napi::CallbackInfo& info)
 Napi::Value PactffiVerifierSetNoPactsIsError(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiVerifierSetProviderInfo received < 2 arguments");
+    throw Napi::Error::New(env, "PactffiVerifierSetNoPactsIsError received < 2 arguments");
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderInfo(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierSetNoPactsIsError(arg 0) expected a VerifierHandle");
   }
 
   if (!info[1].IsBoolean()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderInfo(arg 1 expected a boolean");
+    throw Napi::Error::New(env, "PactffiVerifierSetNoPactsIsError(arg 1) expected a boolean");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
   bool isError = info[1].As<Napi::Boolean>().Value();
 
-  pactffi_verifier_set_no_pacts_is_error(handles[handleId], isError);
+  pactffi_verifier_set_no_pacts_is_error(lookupVerifier(env, handleId), isError);
 
   return info.Env().Undefined();
 }
@@ -371,27 +318,27 @@ Napi::Value PactffiVerifierSetFilterInfo(const Napi::CallbackInfo& info) {
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetFilterInfo(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierSetFilterInfo(arg 0) expected a VerifierHandle");
   }
 
   if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetFilterInfo(arg 1) expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierSetFilterInfo(arg 1) expected a string");
   }
 
   if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetFilterInfo(arg 2 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierSetFilterInfo(arg 2) expected a string");
   }
 
   if (!info[3].IsBoolean()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetFilterInfo(arg 3 expected a boolean");
+    throw Napi::Error::New(env, "PactffiVerifierSetFilterInfo(arg 3) expected a boolean");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string description = info[1].As<Napi::String>().Utf8Value();
-  std::string filterState = info[2].As<Napi::String>().Utf8Value();
+  Utf8Arg description(info[1]);
+  Utf8Arg filterState(info[2]);
   bool filterNoState = info[3].As<Napi::Boolean>().Value();
 
-  pactffi_verifier_set_filter_info(handles[handleId], description.c_str(), filterState.c_str(), filterNoState);
+  pactffi_verifier_set_filter_info(lookupVerifier(env, handleId), description.c_str(), filterState.c_str(), filterNoState);
 
   return info.Env().Undefined();
 }
@@ -418,27 +365,27 @@ Napi::Value PactffiVerifierSetProviderState(const Napi::CallbackInfo& info) {
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderState(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierSetProviderState(arg 0) expected a VerifierHandle");
   }
 
   if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderState(arg 1) expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierSetProviderState(arg 1) expected a string");
   }
 
   if (!info[2].IsBoolean()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderState(arg 2 expected a boolean");
+    throw Napi::Error::New(env, "PactffiVerifierSetProviderState(arg 2) expected a boolean");
   }
 
   if (!info[3].IsBoolean()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetProviderState(arg 3 expected a boolean");
+    throw Napi::Error::New(env, "PactffiVerifierSetProviderState(arg 3) expected a boolean");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string url = info[1].As<Napi::String>().Utf8Value();
+  Utf8Arg url(info[1]);
   bool teardown = info[2].As<Napi::Boolean>().Value();
   bool body = info[3].As<Napi::Boolean>().Value();
 
-  pactffi_verifier_set_provider_state(handles[handleId], url.c_str(), teardown, body);
+  pactffi_verifier_set_provider_state(lookupVerifier(env, handleId), url.c_str(), teardown, body);
 
   return info.Env().Undefined();
 }
@@ -466,22 +413,22 @@ Napi::Value PactffiVerifierSetVerificationOptions(const Napi::CallbackInfo& info
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetVerificationOptions(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierSetVerificationOptions(arg 0) expected a VerifierHandle");
   }
 
   if (!info[1].IsBoolean()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetVerificationOptions(arg 1) expected a boolean");
+    throw Napi::Error::New(env, "PactffiVerifierSetVerificationOptions(arg 1) expected a boolean");
   }
 
   if (!info[2].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetVerificationOptions(arg 2) expected a number");
+    throw Napi::Error::New(env, "PactffiVerifierSetVerificationOptions(arg 2) expected a number");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
   bool disableSslVerification = info[1].As<Napi::Boolean>().Value();
   uint32_t requestTimeout = info[2].As<Napi::Number>().Uint32Value();
 
-  pactffi_verifier_set_verification_options(handles[handleId],
+  pactffi_verifier_set_verification_options(lookupVerifier(env, handleId),
                                           disableSslVerification,
                                           requestTimeout);
 
@@ -521,36 +468,38 @@ Napi::Value PactffiVerifierSetPublishOptions(const Napi::CallbackInfo& info) {
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetPublishOptions(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierSetPublishOptions(arg 0) expected a VerifierHandle");
   }
 
   if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetPublishOptions(arg 1 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierSetPublishOptions(arg 1) expected a string");
   }
 
   if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetPublishOptions(arg 2 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierSetPublishOptions(arg 2) expected a string");
   }
 
   if (!info[3].IsArray()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetPublishOptions(arg 3) expected an array of strings");
+    throw Napi::Error::New(env, "PactffiVerifierSetPublishOptions(arg 3) expected an array of strings");
   }
 
   if (!info[4].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetPublishOptions(arg 3 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierSetPublishOptions(arg 4) expected a string");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string providerVersion = info[1].As<Napi::String>().Utf8Value();
-  std::string buildUrl = info[2].As<Napi::String>().Utf8Value();
+  Utf8Arg providerVersion(info[1]);
+  Utf8Arg buildUrl(info[2]);
   Napi::Array providerTagsRaw = info[3].As<Napi::Array>();
-  std::string providerVersionBranch = info[4].As<Napi::String>().Utf8Value();
+  Utf8Arg providerVersionBranch(info[4]);
 
-  pactffi_verifier_set_publish_options(handles[handleId],
+  CStringArray providerTags(providerTagsRaw);
+
+  pactffi_verifier_set_publish_options(lookupVerifier(env, handleId),
                                           providerVersion.c_str(),
                                           buildUrl.c_str(),
-                                          &NapiArrayToCStringVector(providerTagsRaw)[0],
-                                          providerTagsRaw.Length(),
+                                          providerTags.data(),
+                                          providerTags.size(),
                                           providerVersionBranch.c_str());
 
   return info.Env().Undefined();
@@ -578,19 +527,21 @@ Napi::Value PactffiVerifierSetConsumerFilters(const Napi::CallbackInfo& info) {
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetConsumerFilters(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierSetConsumerFilters(arg 0) expected a VerifierHandle");
   }
 
   if (!info[1].IsArray()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetConsumerFilters(arg 1) expected an array of strings");
+    throw Napi::Error::New(env, "PactffiVerifierSetConsumerFilters(arg 1) expected an array of strings");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
   Napi::Array consumerFilters = info[1].As<Napi::Array>();
 
-  pactffi_verifier_set_consumer_filters(handles[handleId],
-                                        &NapiArrayToCStringVector(consumerFilters)[0],
-                                        consumerFilters.Length());
+  CStringArray cConsumerFilters(consumerFilters);
+
+  pactffi_verifier_set_consumer_filters(lookupVerifier(env, handleId),
+                                        cConsumerFilters.data(),
+                                        cConsumerFilters.size());
 
   return info.Env().Undefined();
 }
@@ -612,17 +563,17 @@ Napi::Value PactffiVerifierSetFailIfNoPactsFound(const Napi::CallbackInfo& info)
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetFailIfNoPactsFound(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierSetFailIfNoPactsFound(arg 0) expected a VerifierHandle");
   }
 
   if (!info[1].IsBoolean()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetFailIfNoPactsFound(arg 1) expected a boolean");
+    throw Napi::Error::New(env, "PactffiVerifierSetFailIfNoPactsFound(arg 1) expected a boolean");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
   bool failIfNoPactsFound = info[1].As<Napi::Boolean>().Value();
 
-  pactffi_verifier_set_no_pacts_is_error(handles[handleId], failIfNoPactsFound);
+  pactffi_verifier_set_no_pacts_is_error(lookupVerifier(env, handleId), failIfNoPactsFound);
 
   return info.Env().Undefined();
 }
@@ -651,17 +602,17 @@ Napi::Value PactffiVerifierSetFollowRedirects(const Napi::CallbackInfo& info) {
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetFollowRedirects(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierSetFollowRedirects(arg 0) expected a VerifierHandle");
   }
 
   if (!info[1].IsBoolean()) {
-    throw Napi::Error::New(env, "pactffiVerifierSetFollowRedirects(arg 1) expected a boolean");
+    throw Napi::Error::New(env, "PactffiVerifierSetFollowRedirects(arg 1) expected a boolean");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
   bool follow = info[1].As<Napi::Boolean>().Value();
 
-  pactffi_verifier_set_follow_redirects(handles[handleId], follow);
+  pactffi_verifier_set_follow_redirects(lookupVerifier(env, handleId), follow);
 
   return info.Env().Undefined();
 }
@@ -682,34 +633,7 @@ Napi::Value PactffiVerifierSetFollowRedirects(const Napi::CallbackInfo& info) {
  *                                            const char *header_value);
  *
  */
-Napi::Value PactffiVerifierAddCustomHeader(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiVerifierAddCustomHeader received < 3 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "PactffiVerifierAddCustomHeader(arg 0) expected a VerifierHandle");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "PactffiVerifierAddCustomHeader(arg 1 expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "PactffiVerifierAddCustomHeader(arg 2 expected a string");
-  }
-
-  uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string name = info[1].As<Napi::String>().Utf8Value();
-  std::string value = info[2].As<Napi::String>().Utf8Value();
-
-  pactffi_verifier_add_custom_header(handles[handleId],
-                                        name.c_str(),
-                                        value.c_str());
-
-  return info.Env().Undefined();
-}
+TYPED_EXPORT(PactffiVerifierAddCustomHeader, pactffi_verifier_add_custom_header)
 
 /**
  * Adds a Pact file as a source to verify.
@@ -723,27 +647,7 @@ Napi::Value PactffiVerifierAddCustomHeader(const Napi::CallbackInfo& info) {
  *
  *    void pactffi_verifier_add_file_source(VerifierHandle *handle, const char *file);
  */
-Napi::Value PactffiVerifierAddFileSource(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiVerifierAddFileSource received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierAddFileSource(arg 0) expected a VerifierHandle");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierAddFileSource(arg 1) expected a string");
-  }
-
-  uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string file = info[1].As<Napi::String>().Utf8Value();
-
-  pactffi_verifier_add_file_source(handles[handleId], file.c_str());
-
-  return info.Env().Undefined();
-}
+TYPED_EXPORT(PactffiVerifierAddFileSource, pactffi_verifier_add_file_source)
 
 /**
  * Adds a Pact directory as a source to verify. All pacts from the directory that match the
@@ -758,27 +662,7 @@ Napi::Value PactffiVerifierAddFileSource(const Napi::CallbackInfo& info) {
  *
  *    void pactffi_verifier_add_directory_source(VerifierHandle *handle, const char *directory);
  */
-Napi::Value PactffiVerifierAddDirectorySource(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
-  if (info.Length() < 2) {
-    throw Napi::Error::New(env, "PactffiVerifierAddDirectorySource received < 2 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierAddDirectorySource(arg 0) expected a VerifierHandle");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierAddDirectorySource(arg 1) expected a string");
-  }
-
-  uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string dir = info[1].As<Napi::String>().Utf8Value();
-
-  pactffi_verifier_add_directory_source(handles[handleId], dir.c_str());
-
-  return info.Env().Undefined();
-}
+TYPED_EXPORT(PactffiVerifierAddDirectorySource, pactffi_verifier_add_directory_source)
 
 /**
  * Adds a URL as a source to verify. The Pact file will be fetched from the URL.
@@ -799,42 +683,7 @@ Napi::Value PactffiVerifierAddDirectorySource(const Napi::CallbackInfo& info) {
  *                                     const char *password,
  *                                     const char *token);
  */
-Napi::Value PactffiVerifierUrlSource(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
-  if (info.Length() < 5) {
-    throw Napi::Error::New(env, "PactffiVerifierUrlSource received < 5 arguments");
-  }
-
-  if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierUrlSource(arg 0) expected a VerifierHandle");
-  }
-
-  if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierUrlSource(arg 1) expected a string");
-  }
-
-  if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierUrlSource(arg 2) expected a string");
-  }
-
-  if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierUrlSource(arg 3) expected a string");
-  }
-
-  if (!info[4].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierUrlSource(arg 4) expected a string");
-  }
-
-  uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string url = info[1].As<Napi::String>().Utf8Value();
-  std::string username = info[2].As<Napi::String>().Utf8Value();
-  std::string password = info[3].As<Napi::String>().Utf8Value();
-  std::string token = info[4].As<Napi::String>().Utf8Value();
-
-  pactffi_verifier_url_source(handles[handleId], url.c_str(), username.c_str(), password.c_str(), token.c_str());
-
-  return info.Env().Undefined();
-}
+TYPED_EXPORT(PactffiVerifierUrlSource, pactffi_verifier_url_source)
 
 // Deprecated
 // /**
@@ -940,79 +789,79 @@ Napi::Value PactffiVerifierBrokerSourceWithSelectors(const Napi::CallbackInfo& i
   }
 
   if (!info[0].IsNumber()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 0) expected a VerifierHandle");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 0) expected a VerifierHandle");
   }
 
   if (!info[1].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 1 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 1) expected a string");
   }
 
   if (!info[2].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 2 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 2) expected a string");
   }
 
   if (!info[3].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 3 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 3) expected a string");
   }
 
   if (!info[4].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 4 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 4) expected a string");
   }
 
   if (!info[5].IsBoolean()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 5) expected a boolean");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 5) expected a boolean");
   }
 
   if (!info[6].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 6 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 6) expected a string");
   }
 
   if (!info[7].IsArray()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 7) expected an array of strings");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 7) expected an array of strings");
   }
 
   if (!info[8].IsString()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 8 expected a string");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 8) expected a string");
   }
 
   if (!info[9].IsArray()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 9) expected an array of strings");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 9) expected an array of strings");
   }
 
   if (!info[10].IsArray()) {
-    throw Napi::Error::New(env, "pactffiVerifierBrokerSourceWithSelectors(arg 10) expected an array of strings");
+    throw Napi::Error::New(env, "PactffiVerifierBrokerSourceWithSelectors(arg 10) expected an array of strings");
   }
 
   uint32_t handleId = info[0].As<Napi::Number>().Uint32Value();
-  std::string url = info[1].As<Napi::String>().Utf8Value();
-  std::string username = info[2].As<Napi::String>().Utf8Value();
-  std::string password = info[3].As<Napi::String>().Utf8Value();
-  std::string token = info[4].As<Napi::String>().Utf8Value();
+  Utf8Arg url(info[1]);
+  Utf8Arg username(info[2]);
+  Utf8Arg password(info[3]);
+  Utf8Arg token(info[4]);
   bool enablePending = info[5].As<Napi::Boolean>().Value();
-  std::string includeWipPactsSince = info[6].As<Napi::String>().Utf8Value();
+  Utf8Arg includeWipPactsSince(info[6]);
   Napi::Array providerTags = info[7].As<Napi::Array>();
-  std::string providerVersionBranch = info[8].As<Napi::String>().Utf8Value();
+  Utf8Arg providerVersionBranch(info[8]);
   Napi::Array consumerVersionSelectors = info[9].As<Napi::Array>();
   Napi::Array consumerVersionTags = info[10].As<Napi::Array>();
 
-  auto cProviderTags = NapiArrayToCStringVector(providerTags);
-  auto cConsumerVersionSelectors = NapiArrayToCStringVector(consumerVersionSelectors);
-  auto cConsumerVersionTags = NapiArrayToCStringVector(consumerVersionTags);
+  CStringArray cProviderTags(providerTags);
+  CStringArray cConsumerVersionSelectors(consumerVersionSelectors);
+  CStringArray cConsumerVersionTags(consumerVersionTags);
 
-  pactffi_verifier_broker_source_with_selectors(handles[handleId],
+  pactffi_verifier_broker_source_with_selectors(lookupVerifier(env, handleId),
                                               url.c_str(),
                                               username.c_str(),
                                               password.c_str(),
                                               token.c_str(),
                                               enablePending,
                                               includeWipPactsSince.c_str(),
-                                              &cProviderTags[0],
-                                              providerTags.Length(),
+                                              cProviderTags.data(),
+                                              cProviderTags.size(),
                                               providerVersionBranch.c_str(),
-                                              &cConsumerVersionSelectors[0],
-                                              consumerVersionSelectors.Length(),
-                                              &cConsumerVersionTags[0],
-                                              consumerVersionTags.Length());
+                                              cConsumerVersionSelectors.data(),
+                                              cConsumerVersionSelectors.size(),
+                                              cConsumerVersionTags.data(),
+                                              cConsumerVersionTags.size());
 
   return info.Env().Undefined();
 }
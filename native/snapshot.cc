@@ -0,0 +1,109 @@
+#include <napi.h>
+#include <string>
+#include "pact-cpp.h"
+#include "journal.h"
+#include "snapshot.h"
+
+/**
+ * Starts recording the calls that build the pact's interactions, so they can be copied
+ * (`pactffiCloneInteraction`) and the pact snapshotted (`pactffiSnapshotPact`). Must be called
+ * before the first interaction is added. The record holds a copy of every body and header given
+ * for the life of the pact, which is why it is opt in.
+ *
+ * * `pact` - Handle to a Pact model, created with `pactffiNewPact`.
+ *
+ * Throws if the pact already has interactions, or wasn't created through the binding.
+ */
+Napi::Value PactffiEnableJournal(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiEnableJournal received < 1 arguments");
+  }
+
+  if (!info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiEnableJournal(arg 0) expected a PactHandle (uint16_t)");
+  }
+
+  if (!JournalEnable(info[0].As<Napi::Number>().Uint32Value())) {
+    throw Napi::Error::New(env, "PactffiEnableJournal(arg 0) already has interactions, or is not a pact created through the binding");
+  }
+
+  return env.Undefined();
+}
+
+/**
+ * Writes a pact, with its interactions, to an opaque Buffer that `pactffiRestorePact` can rebuild
+ * it from, in this or any other process using the same version of the binding. A base pact can be
+ * built once (in a global setup, say) and restored by each test file, rather than each one running
+ * the DSL again.
+ *
+ * * `pact` - Handle to a Pact model with journaling enabled (see `pactffiEnableJournal`), or
+ *   restored from a snapshot.
+ *
+ * The snapshot is taken from the binding's record of the calls that built the pact (see
+ * journal.h), so it holds everything set through the binding, but nothing set on the pact by other
+ * means. Pacts with messages or plugin contents can't be snapshotted. Bodies set from a file
+ * (`pactffiWithBinaryFilePath`) are read into the snapshot when it is taken, so it doesn't depend
+ * on the file being where it was, or unchanged; throws if one can't be read.
+ */
+Napi::Value PactffiSnapshotPact(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiSnapshotPact received < 1 arguments");
+  }
+
+  if (!info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiSnapshotPact(arg 0) expected a PactHandle (uint16_t)");
+  }
+
+  PactHandle pact = info[0].As<Napi::Number>().Uint32Value();
+
+  std::string snapshot;
+  std::string error;
+  switch (JournalSnapshot(pact, &snapshot, &error)) {
+    case JOURNAL_SNAPSHOT_OK:
+      break;
+    case JOURNAL_SNAPSHOT_NOT_FOUND:
+      throw Napi::Error::New(env, "PactffiSnapshotPact(arg 0) is not a pact with journaling enabled (see pactffiEnableJournal), or has been freed");
+    case JOURNAL_SNAPSHOT_UNSUPPORTED:
+      throw Napi::Error::New(env, "PactffiSnapshotPact(arg 0) has messages or plugin contents, which can't be snapshotted");
+    case JOURNAL_SNAPSHOT_UNREADABLE:
+      throw Napi::Error::New(env, "PactffiSnapshotPact was unable to read a body from a file: " + error);
+  }
+
+  return Napi::Buffer<uint8_t>::Copy(env, reinterpret_cast<const uint8_t*>(snapshot.data()), snapshot.size());
+}
+
+/**
+ * Rebuilds a pact from a snapshot taken by `pactffiSnapshotPact`, and returns a handle to the new
+ * pact. The new pact is independent of the one the snapshot was taken from: interactions added to
+ * either are not seen by the other. It needs to be freed with `pactffiFreePactHandle`.
+ *
+ * * `snapshot` - the Buffer returned by `pactffiSnapshotPact`.
+ *
+ * Throws if the Buffer is not a snapshot, was taken by an incompatible version of the binding, or
+ * is truncated.
+ */
+Napi::Value PactffiRestorePact(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiRestorePact received < 1 arguments");
+  }
+
+  if (!info[0].IsBuffer()) {
+    throw Napi::Error::New(env, "PactffiRestorePact(arg 0) expected a Buffer");
+  }
+
+  Napi::Buffer<uint8_t> snapshot = info[0].As<Napi::Buffer<uint8_t>>();
+
+  std::string error;
+  PactHandle pact = JournalRestore(reinterpret_cast<const char*>(snapshot.Data()), snapshot.Length(), &error);
+  if (pact == 0) {
+    throw Napi::Error::New(env, "PactffiRestorePact: " + error);
+  }
+
+  return Napi::Number::New(env, pact);
+}
@@ -0,0 +1,5 @@
+#include <napi.h>
+
+Napi::Value PactffiEnableJournal(const Napi::CallbackInfo& info);
+Napi::Value PactffiSnapshotPact(const Napi::CallbackInfo& info);
+Napi::Value PactffiRestorePact(const Napi::CallbackInfo& info);
@@ -0,0 +1,479 @@
+#include <napi.h>
+#include <atomic>
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+#include "stats.h"
+#include "marshal.h"
+#include "watchdog.h"
+#include "trace.h"
+
+using namespace Napi;
+
+// Per export call counters and latency histograms.
+//
+// Each thread that calls into the addon (the main thread and any worker threads) records into its
+// own counters, so recording never contends. The counters are atomics only so that a snapshot taken
+// on another thread reads whole values; they are written by the owning thread alone.
+//
+// Latencies go into a log-linear histogram in the style of HdrHistogram: each power of two is split
+// into 8 linear sub-buckets, so any recorded value is within 12.5% of the true latency.
+
+static const int kSubBucketBits = 3;
+static const uint64_t kSubBuckets = 1 << kSubBucketBits;
+static const int kMaxMagnitude = 40; // 2^40ns, about 18 minutes. Anything slower lands in the last bucket
+static const size_t kBuckets = (kMaxMagnitude - 1) * kSubBuckets;
+static const size_t kMaxExports = 256;
+
+struct ExportDescriptor {
+  std::string name;
+  size_t index;
+  Napi::Value (*callback)(const Napi::CallbackInfo&);
+  const char* subject;
+};
+
+struct ExportCounters {
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> errors;
+  std::atomic<uint64_t> totalNs;
+  std::atomic<uint64_t> maxNs;
+  std::atomic<uint64_t> buckets[kBuckets];
+};
+
+struct ThreadStats {
+  std::atomic<uint64_t> epoch{0};
+  std::atomic<ExportCounters*> slots[kMaxExports] = {};
+
+  ~ThreadStats() {
+    for (size_t i = 0; i < kMaxExports; i++) {
+      delete slots[i].load();
+    }
+  }
+};
+
+static std::atomic<bool> statsEnabled{false};
+// Bumped on reset. A thread whose counters are from an older epoch clears them on its next call,
+// and snapshots skip it until then, so a reset never races with the owning thread.
+static std::atomic<uint64_t> statsEpoch{0};
+
+static std::mutex statsMutex;
+static std::vector<ExportDescriptor*> descriptors;
+static std::vector<ThreadStats*> liveThreads;
+static ThreadStats retiredThreads;
+
+// Counters of threads that have exited are folded into `retiredThreads`, so worker threads don't
+// lose their stats when they terminate.
+struct ThreadStatsRegistration {
+  ThreadStats* stats = nullptr;
+
+  ThreadStats* get() {
+    if (stats == nullptr) {
+      stats = new ThreadStats();
+      stats->epoch.store(statsEpoch.load());
+      std::lock_guard<std::mutex> lock(statsMutex);
+      liveThreads.push_back(stats);
+    }
+    return stats;
+  }
+
+  ~ThreadStatsRegistration() {
+    if (stats == nullptr) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    for (auto it = liveThreads.begin(); it != liveThreads.end(); ++it) {
+      if (*it == stats) {
+        liveThreads.erase(it);
+        break;
+      }
+    }
+
+    if (stats->epoch.load() == statsEpoch.load()) {
+      for (size_t i = 0; i < kMaxExports; i++) {
+        ExportCounters* from = stats->slots[i].load();
+        if (from == nullptr) {
+          continue;
+        }
+
+        ExportCounters* into = retiredThreads.slots[i].load();
+        if (into == nullptr) {
+          into = new ExportCounters();
+          retiredThreads.slots[i].store(into);
+        }
+
+        into->calls += from->calls.load();
+        into->errors += from->errors.load();
+        into->totalNs += from->totalNs.load();
+        if (from->maxNs.load() > into->maxNs.load()) {
+          into->maxNs.store(from->maxNs.load());
+        }
+        for (size_t b = 0; b < kBuckets; b++) {
+          into->buckets[b] += from->buckets[b].load();
+        }
+      }
+    }
+
+    delete stats;
+  }
+};
+
+static thread_local ThreadStatsRegistration threadStats;
+
+static inline int mostSignificantBit(uint64_t value) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return (int)index;
+#else
+  return 63 - __builtin_clzll(value);
+#endif
+}
+
+static inline size_t bucketFor(uint64_t ns) {
+  if (ns < kSubBuckets) {
+    return ns;
+  }
+
+  int msb = mostSignificantBit(ns);
+  if (msb > kMaxMagnitude) {
+    return kBuckets - 1;
+  }
+
+  return (msb - kSubBucketBits + 1) * kSubBuckets + ((ns >> (msb - kSubBucketBits)) & (kSubBuckets - 1));
+}
+
+// The highest latency that would be recorded in a bucket
+static uint64_t bucketUpperBound(size_t bucket) {
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+
+  uint64_t magnitude = bucket / kSubBuckets;
+  uint64_t width = (uint64_t)1 << (magnitude - 1);
+  return (kSubBuckets + bucket % kSubBuckets) * width + width - 1;
+}
+
+static inline void clearCounters(ExportCounters* counters) {
+  counters->calls.store(0, std::memory_order_relaxed);
+  counters->errors.store(0, std::memory_order_relaxed);
+  counters->totalNs.store(0, std::memory_order_relaxed);
+  counters->maxNs.store(0, std::memory_order_relaxed);
+  for (size_t b = 0; b < kBuckets; b++) {
+    counters->buckets[b].store(0, std::memory_order_relaxed);
+  }
+}
+
+// Only ever called by the thread that owns `stats`, so plain load/store is enough
+static inline void bump(std::atomic<uint64_t>& counter, uint64_t by) {
+  counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+static void record(size_t index, uint64_t ns, bool failed) {
+  ThreadStats* stats = threadStats.get();
+
+  uint64_t epoch = statsEpoch.load(std::memory_order_relaxed);
+  if (stats->epoch.load(std::memory_order_relaxed) != epoch) {
+    for (size_t i = 0; i < kMaxExports; i++) {
+      ExportCounters* counters = stats->slots[i].load(std::memory_order_relaxed);
+      if (counters != nullptr) {
+        clearCounters(counters);
+      }
+    }
+    stats->epoch.store(epoch, std::memory_order_release);
+  }
+
+  ExportCounters* counters = stats->slots[index].load(std::memory_order_relaxed);
+  if (counters == nullptr) {
+    counters = new ExportCounters();
+    stats->slots[index].store(counters, std::memory_order_release);
+  }
+
+  bump(counters->calls, 1);
+  if (failed) {
+    bump(counters->errors, 1);
+  }
+  bump(counters->totalNs, ns);
+  if (ns > counters->maxNs.load(std::memory_order_relaxed)) {
+    counters->maxNs.store(ns, std::memory_order_relaxed);
+  }
+  bump(counters->buckets[bucketFor(ns)], 1);
+}
+
+static Napi::Value InstrumentedExport(const Napi::CallbackInfo& info) {
+  ExportDescriptor* descriptor = static_cast<ExportDescriptor*>(info.Data());
+
+  bool recordStats = statsEnabled.load(std::memory_order_relaxed);
+  uint64_t thresholdNs = watchdogThresholdNs.load(std::memory_order_relaxed);
+  bool recordTrace = traceEnabled.load(std::memory_order_relaxed);
+
+  if (!recordStats && thresholdNs == 0 && !recordTrace) {
+    return descriptor->callback(info);
+  }
+
+  uint64_t start = TraceNow();
+  auto finished = [&](bool failed, const Napi::Value* result) {
+    uint64_t ns = TraceNow() - start;
+    if (recordStats) {
+      record(descriptor->index, ns, failed);
+    }
+    if (thresholdNs > 0 && ns >= thresholdNs) {
+      WatchdogReport(info, descriptor->name, ns, failed);
+    }
+    if (recordTrace) {
+      // Handles and ports are small integers, so a numeric first argument or result is the id
+      bool hasSubject = descriptor->subject != NULL && info.Length() > 0 && info[0].IsNumber();
+      bool hasResult = result != NULL && result->IsNumber();
+      TraceComplete(descriptor->name.c_str(), "export", start,
+        hasSubject ? descriptor->subject : NULL, hasSubject ? info[0].As<Napi::Number>().Int64Value() : 0,
+        hasResult, hasResult ? result->As<Napi::Number>().Int64Value() : 0);
+    }
+  };
+
+  try {
+    Napi::Value result = descriptor->callback(info);
+    finished(false, &result);
+    return result;
+  } catch (...) {
+    finished(true, NULL);
+    throw;
+  }
+}
+
+static const char* subjectName(ExportSubject subject) {
+  switch (subject) {
+    case SUBJECT_PACT:
+      return "pact";
+    case SUBJECT_INTERACTION:
+      return "interaction";
+    case SUBJECT_MESSAGE:
+      return "message";
+    case SUBJECT_PORT:
+      return "port";
+    case SUBJECT_VERIFIER:
+      return "verifier";
+    default:
+      return NULL;
+  }
+}
+
+void ExportFunction(Napi::Env env, Napi::Object exports, const char* name, Napi::Value (*callback)(const Napi::CallbackInfo&), ExportSubject subject) {
+  ExportDescriptor* descriptor = nullptr;
+
+  {
+    // Init runs once per environment (e.g. per worker thread), so reuse the descriptor from an
+    // earlier environment. Descriptors live as long as the process, like the module itself.
+    std::lock_guard<std::mutex> lock(statsMutex);
+    for (ExportDescriptor* existing : descriptors) {
+      if (existing->name == name && existing->callback == callback) {
+        descriptor = existing;
+        break;
+      }
+    }
+
+    if (descriptor == nullptr && descriptors.size() < kMaxExports) {
+      descriptor = new ExportDescriptor{name, descriptors.size(), callback, subjectName(subject)};
+      descriptors.push_back(descriptor);
+    }
+  }
+
+  if (descriptor == nullptr) {
+    exports.Set(Napi::String::New(env, name), Napi::Function::New(env, callback, name));
+    return;
+  }
+
+  exports.Set(Napi::String::New(env, name), Napi::Function::New(env, InstrumentedExport, name, descriptor));
+}
+
+/**
+ * Turns recording of per export call counts and latencies on or off. Recording is off by default;
+ * when it is off, each call costs a single flag check.
+ *
+ * * `enabled` - whether to record calls
+ */
+Napi::Value PactffiEnableStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiEnableStats received < 1 arguments");
+  }
+
+  if (!info[0].IsBoolean()) {
+    throw Napi::Error::New(env, "PactffiEnableStats(arg 0) expected a boolean");
+  }
+
+  statsEnabled.store(info[0].As<Napi::Boolean>().Value());
+
+  return env.Undefined();
+}
+
+/**
+ * Returns a snapshot of the per export call counts, error counts and latency histograms, summed
+ * over all threads. Only exports that have been called are included. Latencies are in nanoseconds.
+ *
+ * ```
+ * {
+ *   enabled: boolean,
+ *   exports: {
+ *     [name]: {
+ *       calls, errors, totalNs, maxNs, p50Ns, p90Ns, p99Ns, p999Ns,
+ *       histogram: [[upperBoundNs, count], ...]
+ *     }
+ *   },
+ *   marshalling: { strings, pooled, heapAllocations }
+ * }
+ * ```
+ *
+ * `marshalling` counts the string arguments decoded on the calling thread, how many were too long
+ * to decode on the stack, and how many of those needed a heap allocation. It is always recorded.
+ *
+ * * `reset` - optional, clears the counters after taking the snapshot
+ */
+Napi::Value PactffiStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() > 0 && !info[0].IsBoolean() && !info[0].IsUndefined()) {
+    throw Napi::Error::New(env, "PactffiStats(arg 0) expected a boolean");
+  }
+
+  bool reset = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>().Value();
+
+  Napi::Object snapshot = Napi::Object::New(env);
+  Napi::Object exported = Napi::Object::New(env);
+  snapshot.Set("enabled", Napi::Boolean::New(env, statsEnabled.load()));
+  snapshot.Set("exports", exported);
+
+  std::lock_guard<std::mutex> lock(statsMutex);
+
+  uint64_t epoch = statsEpoch.load();
+  std::vector<ThreadStats*> threads;
+  threads.push_back(&retiredThreads);
+  for (ThreadStats* thread : liveThreads) {
+    if (thread->epoch.load(std::memory_order_acquire) == epoch) {
+      threads.push_back(thread);
+    }
+  }
+
+  std::vector<uint64_t> buckets(kBuckets);
+  for (ExportDescriptor* descriptor : descriptors) {
+    uint64_t calls = 0, errors = 0, totalNs = 0, maxNs = 0;
+    std::fill(buckets.begin(), buckets.end(), 0);
+
+    for (ThreadStats* thread : threads) {
+      ExportCounters* counters = thread->slots[descriptor->index].load(std::memory_order_acquire);
+      if (counters == nullptr) {
+        continue;
+      }
+
+      calls += counters->calls.load(std::memory_order_relaxed);
+      errors += counters->errors.load(std::memory_order_relaxed);
+      totalNs += counters->totalNs.load(std::memory_order_relaxed);
+      maxNs = std::max(maxNs, counters->maxNs.load(std::memory_order_relaxed));
+      for (size_t b = 0; b < kBuckets; b++) {
+        buckets[b] += counters->buckets[b].load(std::memory_order_relaxed);
+      }
+    }
+
+    if (calls == 0) {
+      continue;
+    }
+
+    Napi::Object stats = Napi::Object::New(env);
+    stats.Set("calls", Napi::Number::New(env, (double)calls));
+    stats.Set("errors", Napi::Number::New(env, (double)errors));
+    stats.Set("totalNs", Napi::Number::New(env, (double)totalNs));
+    stats.Set("maxNs", Napi::Number::New(env, (double)maxNs));
+
+    // Percentiles are reported as the upper bound of the bucket they fall in, like HdrHistogram's
+    // "highest equivalent value", capped at the true maximum
+    const std::pair<const char*, double> percentiles[] = {
+      {"p50Ns", 0.5}, {"p90Ns", 0.9}, {"p99Ns", 0.99}, {"p999Ns", 0.999},
+    };
+    uint64_t recorded = 0;
+    for (size_t b = 0; b < kBuckets; b++) {
+      recorded += buckets[b];
+    }
+    for (const auto& percentile : percentiles) {
+      uint64_t target = (uint64_t)(percentile.second * recorded + 0.999999);
+      uint64_t seen = 0;
+      uint64_t value = maxNs;
+      for (size_t b = 0; b < kBuckets; b++) {
+        seen += buckets[b];
+        if (seen >= target && seen > 0) {
+          value = std::min(bucketUpperBound(b), maxNs);
+          break;
+        }
+      }
+      stats.Set(percentile.first, Napi::Number::New(env, (double)value));
+    }
+
+    Napi::Array histogram = Napi::Array::New(env);
+    uint32_t entries = 0;
+    for (size_t b = 0; b < kBuckets; b++) {
+      if (buckets[b] == 0) {
+        continue;
+      }
+      Napi::Array entry = Napi::Array::New(env, 2);
+      entry.Set((uint32_t)0, Napi::Number::New(env, (double)bucketUpperBound(b)));
+      entry.Set((uint32_t)1, Napi::Number::New(env, (double)buckets[b]));
+      histogram.Set(entries++, entry);
+    }
+    stats.Set("histogram", histogram);
+
+    exported.Set(descriptor->name, stats);
+  }
+
+  MarshalCounters marshal = MarshalStats(reset);
+  Napi::Object marshalling = Napi::Object::New(env);
+  marshalling.Set("strings", Napi::Number::New(env, (double)marshal.strings));
+  marshalling.Set("pooled", Napi::Number::New(env, (double)marshal.pooled));
+  marshalling.Set("heapAllocations", Napi::Number::New(env, (double)marshal.heapAllocations));
+  snapshot.Set("marshalling", marshalling);
+
+  if (reset) {
+    statsEpoch.fetch_add(1);
+    for (size_t i = 0; i < kMaxExports; i++) {
+      ExportCounters* counters = retiredThreads.slots[i].load();
+      if (counters != nullptr) {
+        clearCounters(counters);
+      }
+    }
+  }
+
+  return snapshot;
+}
+
+/**
+ * Returns how many bytes the C allocator currently has handed out, which includes the core's
+ * allocations, as `{ allocatedBytes, source }`. Returns null where the allocator can't be asked
+ * (e.g. musl and Windows).
+ */
+Napi::Value PactffiAllocatorStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New(env);
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 mi = mallinfo2();
+  stats.Set("allocatedBytes", Napi::Number::New(env, (double)(mi.uordblks + mi.hblkhd)));
+  stats.Set("source", Napi::String::New(env, "mallinfo2"));
+#elif defined(__APPLE__)
+  malloc_statistics_t zoneStats;
+  malloc_zone_statistics(NULL, &zoneStats);
+  stats.Set("allocatedBytes", Napi::Number::New(env, (double)zoneStats.size_in_use));
+  stats.Set("source", Napi::String::New(env, "malloc_zone_statistics"));
+#else
+  return env.Null();
+#endif
+
+  return stats;
+}
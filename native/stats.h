@@ -0,0 +1,20 @@
+#include <napi.h>
+
+// What the first argument of an export identifies, so trace spans can say which pact,
+// interaction or mock server a call was about
+enum ExportSubject {
+  SUBJECT_NONE,
+  SUBJECT_PACT,
+  SUBJECT_INTERACTION,
+  SUBJECT_MESSAGE,
+  SUBJECT_PORT,
+  SUBJECT_VERIFIER,
+};
+
+// Registers a binding export. Every export goes through here so its calls can be counted, timed
+// and traced (see `pactffiEnableStats`, `pactffiEnableWatchdog` and `pactffiEnableTrace`).
+void ExportFunction(Napi::Env env, Napi::Object exports, const char* name, Napi::Value (*callback)(const Napi::CallbackInfo&), ExportSubject subject = SUBJECT_NONE);
+
+Napi::Value PactffiEnableStats(const Napi::CallbackInfo& info);
+Napi::Value PactffiStats(const Napi::CallbackInfo& info);
+Napi::Value PactffiAllocatorStats(const Napi::CallbackInfo& info);
@@ -0,0 +1,266 @@
+#include <napi.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "trace.h"
+
+using namespace Napi;
+
+// Timeline of what the addon and the core did, written as Chrome trace event JSON
+// (https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU) so it can be
+// loaded in Perfetto or chrome://tracing.
+//
+// Events are recorded into a buffer per thread. Each buffer has its own lock, which is only
+// contended while a trace is being written.
+
+struct TraceEvent {
+  const char* name;
+  const char* category;
+  char phase;
+  uint64_t tsNs;
+  uint64_t durNs;
+  const char* argName;
+  int64_t argValue;
+  bool hasResult;
+  int64_t result;
+};
+
+struct TraceBuffer {
+  std::mutex mutex;
+  uint32_t tid;
+  std::vector<TraceEvent> events;
+  uint64_t dropped = 0;
+};
+
+// Bounds the memory a forgotten trace can use, about 64MB per thread
+static const size_t kMaxEventsPerThread = 1 << 20;
+
+std::atomic<bool> traceEnabled{false};
+
+static const std::chrono::steady_clock::time_point traceEpoch = std::chrono::steady_clock::now();
+
+static std::mutex traceMutex;
+static std::vector<TraceBuffer*> traceBuffers;
+static uint32_t nextTid = 1;
+static std::string traceExitPath;
+static std::once_flag traceExitHook;
+
+// Buffers are kept after their thread exits, so a worker's events still make it into the trace
+struct TraceBufferRegistration {
+  TraceBuffer* buffer = nullptr;
+
+  TraceBuffer* get() {
+    if (buffer == nullptr) {
+      buffer = new TraceBuffer();
+      std::lock_guard<std::mutex> lock(traceMutex);
+      buffer->tid = nextTid++;
+      traceBuffers.push_back(buffer);
+    }
+    return buffer;
+  }
+};
+
+static thread_local TraceBufferRegistration threadTrace;
+
+uint64_t TraceNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceEpoch).count();
+}
+
+static void recordEvent(const TraceEvent& event) {
+  TraceBuffer* buffer = threadTrace.get();
+  std::lock_guard<std::mutex> lock(buffer->mutex);
+
+  if (buffer->events.size() >= kMaxEventsPerThread) {
+    buffer->dropped++;
+    return;
+  }
+
+  buffer->events.push_back(event);
+}
+
+void TraceComplete(const char* name, const char* category, uint64_t startNs, const char* argName, int64_t argValue, bool hasResult, int64_t result) {
+  if (!traceEnabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  recordEvent(TraceEvent{name, category, 'X', startNs, TraceNow() - startNs, argName, argValue, hasResult, result});
+}
+
+void TraceInstant(const char* name, const char* category, const char* argName, int64_t argValue) {
+  if (!traceEnabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  recordEvent(TraceEvent{name, category, 'i', TraceNow(), 0, argName, argValue, false, 0});
+}
+
+// Event names are export names and literals, so they never need escaping
+static void appendEvent(std::string& json, const TraceEvent& event, uint32_t tid) {
+  char line[512];
+
+  int length = snprintf(line, sizeof(line), "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+    event.name, event.category, event.phase, event.tsNs / 1e3, tid);
+  json.append(line, length);
+
+  if (event.phase == 'X') {
+    length = snprintf(line, sizeof(line), ",\"dur\":%.3f", event.durNs / 1e3);
+    json.append(line, length);
+  } else if (event.phase == 'i') {
+    json += ",\"s\":\"t\"";
+  }
+
+  if (event.argName != NULL || event.hasResult) {
+    json += ",\"args\":{";
+    if (event.argName != NULL) {
+      length = snprintf(line, sizeof(line), "\"%s\":%lld", event.argName, (long long)event.argValue);
+      json.append(line, length);
+    }
+    if (event.hasResult) {
+      length = snprintf(line, sizeof(line), "%s\"result\":%lld", event.argName != NULL ? "," : "", (long long)event.result);
+      json.append(line, length);
+    }
+    json += "}";
+  }
+
+  json += "}";
+}
+
+// Writes all buffered events to `path`, returning the number written or -1 if the file couldn't be
+// written
+static int64_t writeTrace(const std::string& path, bool clear) {
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  int64_t written = 0;
+  uint64_t dropped = 0;
+  bool first = true;
+
+  {
+    std::lock_guard<std::mutex> lock(traceMutex);
+
+    for (TraceBuffer* buffer : traceBuffers) {
+      std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+      char metadata[128];
+      int length = snprintf(metadata, sizeof(metadata), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+        first ? "" : ",", buffer->tid, buffer->tid);
+      json.append(metadata, length);
+      first = false;
+
+      for (const TraceEvent& event : buffer->events) {
+        json += ",";
+        appendEvent(json, event, buffer->tid);
+        written++;
+      }
+
+      dropped += buffer->dropped;
+      if (clear) {
+        buffer->events.clear();
+        buffer->dropped = 0;
+      }
+    }
+  }
+
+  char footer[64];
+  int length = snprintf(footer, sizeof(footer), "],\"droppedEvents\":%llu}", (unsigned long long)dropped);
+  json.append(footer, length);
+
+  FILE* file = fopen(path.c_str(), "wb");
+  if (file == NULL) {
+    return -1;
+  }
+
+  size_t size = fwrite(json.data(), 1, json.size(), file);
+  if (fclose(file) != 0 || size != json.size()) {
+    return -1;
+  }
+
+  return written;
+}
+
+static void writeTraceOnExit() {
+  std::string path;
+
+  {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    path = traceExitPath;
+  }
+
+  if (!path.empty()) {
+    writeTrace(path, false);
+  }
+}
+
+/**
+ * Starts (or stops) recording a timeline of export calls, async worker executions and mock server
+ * lifecycle events. The buffered events are written with `pactffiWriteTrace`, and optionally when
+ * the process exits.
+ *
+ * * `enabled` - whether to record events
+ * * `exitPath` - optional, a file to write the trace to when the process exits. Written at process
+ *   exit rather than when the calling environment is torn down, so setting it from a worker doesn't
+ *   lose the events recorded after that worker exits.
+ */
+Napi::Value PactffiEnableTrace(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiEnableTrace received < 1 arguments");
+  }
+
+  if (!info[0].IsBoolean()) {
+    throw Napi::Error::New(env, "PactffiEnableTrace(arg 0) expected a boolean");
+  }
+
+  if (info.Length() > 1 && !info[1].IsString() && !info[1].IsUndefined()) {
+    throw Napi::Error::New(env, "PactffiEnableTrace(arg 1) expected a string");
+  }
+
+  if (info.Length() > 1 && info[1].IsString()) {
+    {
+      std::lock_guard<std::mutex> lock(traceMutex);
+      traceExitPath = info[1].As<Napi::String>().Utf8Value();
+    }
+    std::call_once(traceExitHook, []() { std::atexit(writeTraceOnExit); });
+  }
+
+  traceEnabled.store(info[0].As<Napi::Boolean>().Value());
+
+  return env.Undefined();
+}
+
+/**
+ * Writes the recorded events as Chrome trace event JSON.
+ *
+ * * `path` - the file to write
+ * * `clear` - optional, drops the written events from the buffers
+ *
+ * Returns the number of events written.
+ */
+Napi::Value PactffiWriteTrace(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    throw Napi::Error::New(env, "PactffiWriteTrace received < 1 arguments");
+  }
+
+  if (!info[0].IsString()) {
+    throw Napi::Error::New(env, "PactffiWriteTrace(arg 0) expected a string");
+  }
+
+  if (info.Length() > 1 && !info[1].IsBoolean() && !info[1].IsUndefined()) {
+    throw Napi::Error::New(env, "PactffiWriteTrace(arg 1) expected a boolean");
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  bool clear = info.Length() > 1 && info[1].IsBoolean() && info[1].As<Napi::Boolean>().Value();
+
+  int64_t written = writeTrace(path, clear);
+  if (written < 0) {
+    throw Napi::Error::New(env, "PactffiWriteTrace could not write the trace to " + path);
+  }
+
+  return Napi::Number::New(env, (double)written);
+}
@@ -0,0 +1,19 @@
+#include <napi.h>
+#include <atomic>
+
+// Whether spans are being recorded (see `pactffiEnableTrace`)
+extern std::atomic<bool> traceEnabled;
+
+// Nanoseconds since the addon was loaded, the timebase of all trace events
+uint64_t TraceNow();
+
+// Records a span that started at `startNs` and ends now. `argName`/`argValue` identify the handle or
+// port the span is about, and are left out when `argName` is NULL. `name` and `category` must
+// outlive the trace, i.e. be literals or export names.
+void TraceComplete(const char* name, const char* category, uint64_t startNs, const char* argName, int64_t argValue, bool hasResult = false, int64_t result = 0);
+
+// Records a point in time event, such as a mock server starting
+void TraceInstant(const char* name, const char* category, const char* argName, int64_t argValue);
+
+Napi::Value PactffiEnableTrace(const Napi::CallbackInfo& info);
+Napi::Value PactffiWriteTrace(const Napi::CallbackInfo& info);
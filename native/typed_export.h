@@ -0,0 +1,176 @@
+#pragma once
+
+#include <napi.h>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include "pact-cpp.h"
+#include "marshal.h"
+#include "journal.h"
+
+// Exports that pass their arguments straight through to a single FFI function are declared with
+// TYPED_EXPORT, which derives the argument checks and conversions from the FFI function's
+// signature at compile time:
+//
+//    TYPED_EXPORT(PactffiUponReceiving, pactffi_upon_receiving)
+//
+// defines `Napi::Value PactffiUponReceiving(const Napi::CallbackInfo&)`, which expects an
+// InteractionHandle and a string, calls `pactffi_upon_receiving` and returns its result. The
+// arguments are type checked in one pass over a table built from the signature, so every typed
+// export reports a missing or mistyped argument the same way:
+//
+//    PactffiUponReceiving received < 2 arguments
+//    PactffiUponReceiving(arg 1) expected a string
+//
+// Exports that do more than forward a call (track mock servers, own returned strings, take
+// optional arguments) are still written out by hand.
+//
+// Interaction setters are declared with JOURNALED_EXPORT instead, which also records each
+// successful call in the interaction's journal (see journal.h):
+//
+//    JOURNALED_EXPORT(PactffiUponReceiving, pactffi_upon_receiving, JOURNAL_UPON_RECEIVING)
+
+PactSpecification integerToSpecification(Napi::Env &env, uint32_t number);
+InteractionPart integerToInteractionPart(Napi::Env &env, uint32_t number);
+LevelFilter integerToLevelFilter(Napi::Env &env, uint32_t number);
+
+// How a JS argument is checked (`type`, described by `expected` in errors) and converted to an
+// FFI parameter of type T. The converted value is held in a `Holder` for the duration of the call
+// and passed to the FFI as `Get(holder)`.
+template <typename T, typename Enable = void>
+struct ArgTraits;
+
+template <>
+struct ArgTraits<const char*> {
+  static constexpr napi_valuetype type = napi_string;
+  static constexpr const char* expected = "a string";
+  using Holder = Utf8Arg;
+  static const char* Get(const Utf8Arg& holder) { return holder.c_str(); }
+};
+
+template <>
+struct ArgTraits<bool> {
+  static constexpr napi_valuetype type = napi_boolean;
+  static constexpr const char* expected = "a boolean";
+  struct Holder {
+    explicit Holder(Napi::Value value) : value(value.As<Napi::Boolean>().Value()) {}
+    bool value;
+  };
+  static bool Get(const Holder& holder) { return holder.value; }
+};
+
+// Handles, ports, indexes and counts
+template <typename T>
+struct ArgTraits<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+  static constexpr napi_valuetype type = napi_number;
+  static constexpr const char* expected = "a number";
+  struct Holder {
+    explicit Holder(Napi::Value value) : value(static_cast<T>(value.As<Napi::Number>().Int64Value())) {}
+    T value;
+  };
+  static T Get(const Holder& holder) { return holder.value; }
+};
+
+// Enums arrive as numbers and are range checked by their existing converters
+template <typename T, T (*Convert)(Napi::Env&, uint32_t)>
+struct EnumArgTraits {
+  static constexpr napi_valuetype type = napi_number;
+  static constexpr const char* expected = "a number";
+  struct Holder {
+    explicit Holder(Napi::Value value) {
+      Napi::Env env = value.Env();
+      this->value = Convert(env, value.As<Napi::Number>().Uint32Value());
+    }
+    T value;
+  };
+  static T Get(const Holder& holder) { return holder.value; }
+};
+
+template <>
+struct ArgTraits<PactSpecification> : EnumArgTraits<PactSpecification, integerToSpecification> {};
+template <>
+struct ArgTraits<InteractionPart> : EnumArgTraits<InteractionPart, integerToInteractionPart> {};
+template <>
+struct ArgTraits<LevelFilter> : EnumArgTraits<LevelFilter, integerToLevelFilter> {};
+
+template <typename R>
+Napi::Value TypedResult(Napi::Env env, R result) {
+  if constexpr (std::is_same<R, bool>::value) {
+    return Napi::Boolean::New(env, result);
+  } else {
+    static_assert(std::is_arithmetic<R>::value, "TYPED_EXPORT only returns bools and numbers");
+    return Napi::Number::New(env, static_cast<double>(result));
+  }
+}
+
+template <JournalOp Op, typename R, typename... Params>
+struct TypedCall {
+  using ParamTuple = std::tuple<Params...>;
+
+  // Converts argument I into a local holder and recurses, so holders are released in reverse
+  // order once the call returns (which Utf8Arg's buffers rely on)
+  template <size_t I, typename... Converted>
+  static R Invoke(const Napi::CallbackInfo& info, R (*fn)(Params...), Converted... converted) {
+    if constexpr (I == sizeof...(Params)) {
+      if constexpr (std::is_void<R>::value) {
+        fn(converted...);
+        if constexpr (Op != JOURNAL_NONE) {
+          JournalRecord(Op, converted...);
+        }
+      } else {
+        R result = fn(converted...);
+        if constexpr (Op != JOURNAL_NONE) {
+          if (JournalSucceeded(result)) {
+            JournalRecord(Op, converted...);
+          }
+        }
+        return result;
+      }
+    } else {
+      using Traits = ArgTraits<typename std::tuple_element<I, ParamTuple>::type>;
+      typename Traits::Holder holder(info[I]);
+      return Invoke<I + 1>(info, fn, converted..., Traits::Get(holder));
+    }
+  }
+
+  static Napi::Value Call(const Napi::CallbackInfo& info, const char* name, R (*fn)(Params...)) {
+    Napi::Env env = info.Env();
+    constexpr size_t arity = sizeof...(Params);
+
+    if (info.Length() < arity) {
+      throw Napi::Error::New(env, std::string(name) + " received < " + std::to_string(arity) + " arguments");
+    }
+
+    if constexpr (arity > 0) {
+      static const napi_valuetype types[] = {ArgTraits<Params>::type...};
+      static const char* const expected[] = {ArgTraits<Params>::expected...};
+      for (size_t i = 0; i < arity; i++) {
+        if (info[i].Type() != types[i]) {
+          throw Napi::Error::New(env, std::string(name) + "(arg " + std::to_string(i) + ") expected " + expected[i]);
+        }
+      }
+    }
+
+    if constexpr (std::is_void<R>::value) {
+      Invoke<0>(info, fn);
+      return env.Undefined();
+    } else {
+      return TypedResult(env, Invoke<0>(info, fn));
+    }
+  }
+};
+
+template <JournalOp Op = JOURNAL_NONE, typename R, typename... Params>
+Napi::Value CallTyped(const Napi::CallbackInfo& info, const char* name, R (*fn)(Params...)) {
+  return TypedCall<Op, R, Params...>::Call(info, name, fn);
+}
+
+#define TYPED_EXPORT(name, fn) \
+  Napi::Value name(const Napi::CallbackInfo& info) { \
+    return CallTyped(info, #name, fn); \
+  }
+
+#define JOURNALED_EXPORT(name, fn, op) \
+  Napi::Value name(const Napi::CallbackInfo& info) { \
+    return CallTyped<op>(info, #name, fn); \
+  }
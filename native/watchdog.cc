@@ -0,0 +1,228 @@
+#include <napi.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include "watchdog.h"
+
+using namespace Napi;
+
+// Watchdog for exports that block the JS thread. Every export runs synchronously, and several of
+// them (creating and cleaning up mock servers, writing pact files, loading plugins) can do slow
+// work in the core. Calls slower than the threshold are reported to a JS callback and kept in a
+// list of the worst offenders.
+
+struct WatchdogOffender {
+  std::string name;
+  uint64_t durationNs;
+  std::string args;
+};
+
+std::atomic<uint64_t> watchdogThresholdNs{0};
+
+static std::mutex watchdogMutex;
+static size_t watchdogTopN = 10;
+static std::vector<WatchdogOffender> watchdogOffenders;
+// The callback is a JS function, so there is one per environment (main thread and each worker)
+static std::map<napi_env, Napi::FunctionReference*> watchdogCallbacks;
+static std::set<napi_env> watchdogCleanupHooks;
+
+// A short description of the arguments a call was made with, e.g. `(1, <string 3 bytes>, <Buffer
+// 1024 bytes>)`. Strings are described by their length only: some are credentials (broker
+// passwords and tokens), and the summary ends up in the offender list and the log.
+static std::string summariseArguments(const Napi::CallbackInfo& info) {
+  std::string summary = "(";
+
+  for (size_t i = 0; i < info.Length(); i++) {
+    if (i > 0) {
+      summary += ", ";
+    }
+
+    Napi::Value arg = info[i];
+    if (arg.IsString()) {
+      // Measured without copying the string out
+      size_t length = 0;
+      napi_get_value_string_utf8(info.Env(), arg, NULL, 0, &length);
+      summary += "<string " + std::to_string(length) + " bytes>";
+    } else if (arg.IsNumber()) {
+      summary += std::to_string(arg.As<Napi::Number>().Int64Value());
+    } else if (arg.IsBoolean()) {
+      summary += arg.As<Napi::Boolean>().Value() ? "true" : "false";
+    } else if (arg.IsBuffer()) {
+      summary += "<Buffer " + std::to_string(arg.As<Napi::Buffer<uint8_t>>().Length()) + " bytes>";
+    } else if (arg.IsArray()) {
+      summary += "[" + std::to_string(arg.As<Napi::Array>().Length()) + " items]";
+    } else if (arg.IsFunction()) {
+      summary += "<Function>";
+    } else if (arg.IsNull()) {
+      summary += "null";
+    } else if (arg.IsUndefined()) {
+      summary += "undefined";
+    } else {
+      summary += "{...}";
+    }
+  }
+
+  return summary + ")";
+}
+
+// Must be called with watchdogMutex held
+static void releaseCallback(napi_env env) {
+  auto callback = watchdogCallbacks.find(env);
+  if (callback != watchdogCallbacks.end()) {
+    delete callback->second;
+    watchdogCallbacks.erase(callback);
+  }
+}
+
+static void releaseEnvironment(napi_env env) {
+  std::lock_guard<std::mutex> lock(watchdogMutex);
+
+  releaseCallback(env);
+  watchdogCleanupHooks.erase(env);
+}
+
+void WatchdogReport(const Napi::CallbackInfo& info, const std::string& name, uint64_t durationNs, bool failed) {
+  Napi::Env env = info.Env();
+  WatchdogOffender offender{name, durationNs, summariseArguments(info)};
+  Napi::FunctionReference* callback = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(watchdogMutex);
+
+    if (watchdogTopN > 0 && (watchdogOffenders.size() < watchdogTopN || durationNs > watchdogOffenders.back().durationNs)) {
+      auto position = std::upper_bound(watchdogOffenders.begin(), watchdogOffenders.end(), durationNs,
+        [](uint64_t duration, const WatchdogOffender& existing) { return duration > existing.durationNs; });
+      watchdogOffenders.insert(position, offender);
+      if (watchdogOffenders.size() > watchdogTopN) {
+        watchdogOffenders.pop_back();
+      }
+    }
+
+    auto found = watchdogCallbacks.find(env);
+    if (found != watchdogCallbacks.end()) {
+      callback = found->second;
+    }
+  }
+
+  // A call that threw has a JS exception in flight, so calling back into JS has to wait for the
+  // next slow call. The offender has still been recorded.
+  if (callback == nullptr || failed) {
+    return;
+  }
+
+  Napi::Object warning = Napi::Object::New(env);
+  warning.Set("name", Napi::String::New(env, offender.name));
+  warning.Set("durationMs", Napi::Number::New(env, durationNs / 1e6));
+  warning.Set("thresholdMs", Napi::Number::New(env, watchdogThresholdNs.load() / 1e6));
+  warning.Set("args", Napi::String::New(env, offender.args));
+
+  try {
+    callback->Call({warning});
+  } catch (const Napi::Error&) {
+    // A failing callback must not turn a slow call into a failed one
+  }
+}
+
+/**
+ * Starts (or stops) reporting synchronous export calls that block the JS thread for longer than a
+ * threshold.
+ *
+ * * `thresholdMs` - calls taking at least this long are reported. 0 turns the watchdog off
+ * * `topN` - how many of the slowest calls to keep (see `pactffiWatchdogOffenders`)
+ * * `callback` - optional, called with `{ name, durationMs, thresholdMs, args }` for each slow call
+ */
+Napi::Value PactffiEnableWatchdog(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    throw Napi::Error::New(env, "PactffiEnableWatchdog received < 2 arguments");
+  }
+
+  if (!info[0].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiEnableWatchdog(arg 0) expected a number");
+  }
+
+  if (!info[1].IsNumber()) {
+    throw Napi::Error::New(env, "PactffiEnableWatchdog(arg 1) expected a number");
+  }
+
+  if (info.Length() > 2 && !info[2].IsFunction() && !info[2].IsUndefined()) {
+    throw Napi::Error::New(env, "PactffiEnableWatchdog(arg 2) expected a function");
+  }
+
+  double thresholdMs = info[0].As<Napi::Number>().DoubleValue();
+  int32_t topN = info[1].As<Napi::Number>().Int32Value();
+
+  if (thresholdMs < 0) {
+    throw Napi::Error::New(env, "PactffiEnableWatchdog(arg 0) expected a threshold >= 0");
+  }
+
+  if (topN < 0) {
+    throw Napi::Error::New(env, "PactffiEnableWatchdog(arg 1) expected a count >= 0");
+  }
+
+  bool addCleanupHook = false;
+
+  {
+    std::lock_guard<std::mutex> lock(watchdogMutex);
+
+    releaseCallback(env);
+
+    watchdogTopN = topN;
+    if (watchdogOffenders.size() > watchdogTopN) {
+      watchdogOffenders.resize(watchdogTopN);
+    }
+
+    if (info.Length() > 2 && info[2].IsFunction()) {
+      Napi::FunctionReference* callback = new Napi::FunctionReference();
+      callback->Reset(info[2].As<Napi::Function>(), 1);
+      watchdogCallbacks[env] = callback;
+      addCleanupHook = watchdogCleanupHooks.insert(env).second;
+    }
+  }
+
+  if (addCleanupHook) {
+    env.AddCleanupHook(releaseEnvironment, (napi_env)env);
+  }
+
+  watchdogThresholdNs.store((uint64_t)(thresholdMs * 1e6));
+
+  return env.Undefined();
+}
+
+/**
+ * Returns the slowest calls seen by the watchdog, slowest first, as
+ * `[{ name, durationMs, args }, ...]`.
+ *
+ * * `reset` - optional, clears the list after returning it
+ */
+Napi::Value PactffiWatchdogOffenders(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() > 0 && !info[0].IsBoolean() && !info[0].IsUndefined()) {
+    throw Napi::Error::New(env, "PactffiWatchdogOffenders(arg 0) expected a boolean");
+  }
+
+  bool reset = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>().Value();
+
+  std::lock_guard<std::mutex> lock(watchdogMutex);
+
+  Napi::Array offenders = Napi::Array::New(env, watchdogOffenders.size());
+  for (uint32_t i = 0; i < watchdogOffenders.size(); i++) {
+    Napi::Object offender = Napi::Object::New(env);
+    offender.Set("name", Napi::String::New(env, watchdogOffenders[i].name));
+    offender.Set("durationMs", Napi::Number::New(env, watchdogOffenders[i].durationNs / 1e6));
+    offender.Set("args", Napi::String::New(env, watchdogOffenders[i].args));
+    offenders.Set(i, offender);
+  }
+
+  if (reset) {
+    watchdogOffenders.clear();
+  }
+
+  return offenders;
+}
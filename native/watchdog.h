@@ -0,0 +1,12 @@
+#include <napi.h>
+#include <atomic>
+
+// Threshold in nanoseconds above which a synchronous export call is reported, or 0 when the
+// watchdog is off. Read by the export wrapper in stats.cc on every call.
+extern std::atomic<uint64_t> watchdogThresholdNs;
+
+// Called by the export wrapper when a call took at least `watchdogThresholdNs`
+void WatchdogReport(const Napi::CallbackInfo& info, const std::string& name, uint64_t durationNs, bool failed);
+
+Napi::Value PactffiEnableWatchdog(const Napi::CallbackInfo& info);
+Napi::Value PactffiWatchdogOffenders(const Napi::CallbackInfo& info);
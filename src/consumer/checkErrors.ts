@@ -16,6 +16,27 @@ export const wrapWithCheck =
     return result;
   };
 
+/**
+ * Like `wrapWithCheck`, for the batch setters, which report whether each key
+ * was set rather than one result.
+ */
+export const wrapEachWithCheck =
+  <A extends unknown[]>(
+    f: (...args: A) => Record<string, boolean>,
+    contextMessage: string,
+  ) =>
+  (...args: A): Record<string, boolean> => {
+    const results = f(...args);
+    for (const [key, set] of Object.entries(results)) {
+      if (!set) {
+        logger.pactCrash(
+          `The pact consumer core returned false at '${contextMessage}' for '${key}'. This\nshould only happen if the core methods were invoked out of order`,
+        );
+      }
+    }
+    return results;
+  };
+
 type CheckableFunction<T> = T extends (...args: infer A) => boolean | number
   ? (...args: A) => ReturnType<T>
   : never;
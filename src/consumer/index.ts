@@ -2,6 +2,11 @@ import { getFfiLib } from '../ffi';
 import {
   CREATE_MOCK_SERVER_ERRORS,
   type Ffi,
+  type FfiCloneOverrides,
+  type FfiEntries,
+  type FfiJsonBody,
+  type FfiMultipartPart,
+  type FfiPactHandle,
   type FfiSpecificationVersion,
   INTERACTION_PART_REQUEST,
   INTERACTION_PART_RESPONSE,
@@ -12,17 +17,37 @@ import {
   logErrorAndThrow,
   setLogLevel,
 } from '../logger';
-import { wrapAllWithCheck, wrapWithCheck } from './checkErrors';
-import { mockServerMismatches, writePact } from './internals';
+import {
+  wrapAllWithCheck,
+  wrapEachWithCheck,
+  wrapWithCheck,
+} from './checkErrors';
+import {
+  managePactHandle,
+  matchInProcess,
+  mockServerMismatches,
+  type PactRelease,
+  parseMismatches,
+  retainPact,
+  writePact,
+} from './internals';
 import type {
   AsynchronousMessage,
   ConsumerInteraction,
   ConsumerMessagePact,
   ConsumerPact,
+  InProcessMatchResult,
+  InProcessRequest,
   MatchingResult,
   SynchronousMessage,
 } from './types';
 
+// The batch setters, which report whether each key was set
+type EntrySetters =
+  | 'withQueryParameters'
+  | 'withRequestHeaders'
+  | 'withResponseHeaders';
+
 const asyncMessage = (
   ffi: Ffi,
   interactionPtr: number,
@@ -62,7 +87,7 @@ const asyncMessage = (
     ffi.pactffiAddInteractionReference(interactionPtr, group, name, value),
   setInteractionTestName: (name: string) =>
     ffi.pactffiInteractionTestName(interactionPtr, name),
-  withContents: (body: string, contentType: string) =>
+  withContents: (body: string | FfiJsonBody, contentType: string) =>
     ffi.pactffiMessageWithContents(interactionPtr, contentType, body),
   withBinaryContents: (body: Buffer, contentType: string) =>
     ffi.pactffiMessageWithBinaryContents(
@@ -114,29 +139,314 @@ export const setTestRunId = (
   getFfiLib(logLevel, logFile).pactffiSetTestRunId(testRunId);
 };
 
-export const makeConsumerPact = (
-  consumer: string,
-  provider: string,
-  version: FfiSpecificationVersion = 3,
+/**
+ * Starts collecting mock server logs per test, keyed by the id passed to `setTestRunId` and by
+ * mock server port. Requires a `buffer` log sink (see `setLogSinks`).
+ */
+export const enableTestLogs = (
+  logLevel = getLogLevel(),
+  logFile?: string,
+): void => {
+  getFfiLib(logLevel, logFile).pactffiEnableTestLogs();
+};
+
+/**
+ * Returns the core logs collected for a test run id (or a mock server port), and clears them.
+ * Typically called for a failing test.
+ */
+export const fetchTestLogs = (
+  testRunIdOrPort: string | number,
   logLevel = getLogLevel(),
   logFile?: string,
+): string => getFfiLib(logLevel, logFile).pactffiFetchTestLogs(testRunIdOrPort);
+
+/**
+ * Drops the core logs collected for a test run id without copying them. Typically called for a
+ * passing test.
+ */
+export const discardTestLogs = (
+  testRunId: string,
+  logLevel = getLogLevel(),
+  logFile?: string,
+): void => {
+  getFfiLib(logLevel, logFile).pactffiDiscardTestLogs(testRunId);
+};
+
+type PactHandleOwnership = {
+  // Implements writePactFile
+  write: (dir: string, merge: boolean) => void;
+  // Frees the pact in the core, or drops this reference to a shared one
+  release: PactRelease;
+};
+
+const consumerPact = (
+  ffi: Ffi,
+  pactPtr: FfiPactHandle,
+  ownership: PactHandleOwnership,
 ): ConsumerPact => {
-  if (logLevel) {
-    setLogLevel(logLevel);
-  }
-  const ffi = getFfiLib(logLevel, logFile);
   // We need to track the number of messages so that we can
   // correctly reference them when extracting contents
   let messageCount = 0;
+  // The last request matched in process: they're sent one at a time, so each
+  // can tell which mismatch is its own
+  let inProcess: Promise<unknown> = Promise.resolve();
 
-  const pactPtr = ffi.pactffiNewPact(consumer, provider);
-  if (!ffi.pactffiWithSpecification(pactPtr, version)) {
-    throw new Error(
-      `Unable to set core spec version. The pact FfiSpecificationVersion '${version}' may be invalid (note this is not the same as the pact spec version)`,
+  const interactionWrapper = (interactionPtr: number): ConsumerInteraction =>
+    retainPact(
+      Object.assign(
+        wrapAllWithCheck<Omit<ConsumerInteraction, 'clone' | EntrySetters>>({
+          uponReceiving: (recieveDescription: string) =>
+            ffi.pactffiUponReceiving(interactionPtr, recieveDescription),
+          given: (state: string) => ffi.pactffiGiven(interactionPtr, state),
+          givenWithParam: (state: string, name: string, value: string) =>
+            ffi.pactffiGivenWithParam(interactionPtr, state, name, value),
+          givenWithParams: (state: string, params: string) =>
+            ffi.pactffiGivenWithParams(interactionPtr, state, params),
+          setPending: (pending: boolean) =>
+            ffi.pactffiSetPending(interactionPtr, pending),
+          setKey: (value: string) => ffi.pactffiSetKey(interactionPtr, value),
+          setComment: (key: string, value: string) =>
+            ffi.pactffiSetComment(interactionPtr, key, value),
+          addTextComment: (comment: string) =>
+            ffi.pactffiAddTextComment(interactionPtr, comment),
+          addInteractionReference: (
+            group: string,
+            name: string,
+            value: string,
+          ) =>
+            ffi.pactffiAddInteractionReference(
+              interactionPtr,
+              group,
+              name,
+              value,
+            ),
+          setInteractionTestName: (name: string) =>
+            ffi.pactffiInteractionTestName(interactionPtr, name),
+          withRequest: (method: string, path: string) =>
+            ffi.pactffiWithRequest(interactionPtr, method, path),
+          withQuery: (name: string, index: number, value: string) =>
+            ffi.pactffiWithQueryParameter(interactionPtr, name, index, value),
+          withRequestHeader: (name: string, index: number, value: string) =>
+            ffi.pactffiWithHeader(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              name,
+              index,
+              value,
+            ),
+          withRequestBody: (body: string | FfiJsonBody, contentType: string) =>
+            ffi.pactffiWithBody(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              body,
+            ),
+          withRequestBinaryBody: (body: Buffer, contentType: string) =>
+            ffi.pactffiWithBinaryFile(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              body,
+              body.length,
+            ),
+          withRequestBinaryFile: (path: string, contentType: string) =>
+            ffi.pactffiWithBinaryFilePath(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              path,
+            ),
+          withRequestMatchingRules: (rules: string) =>
+            ffi.pactffiWithMatchingRules(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              rules,
+            ),
+          withResponseMatchingRules: (rules: string) =>
+            ffi.pactffiWithMatchingRules(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              rules,
+            ),
+          withRequestMultipartParts: (
+            parts: FfiMultipartPart[],
+            boundary?: string,
+          ) =>
+            ffi.pactffiWithMultipartParts(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              parts,
+              boundary,
+            ),
+          withRequestMultipartBody: (
+            contentType: string,
+            filename: string,
+            mimePartName: string,
+            boundary?: string,
+          ) => {
+            if (boundary)
+              return (
+                ffi.pactffiWithMultipartFile(
+                  interactionPtr,
+                  INTERACTION_PART_REQUEST,
+                  contentType,
+                  filename,
+                  mimePartName,
+                  boundary,
+                ) === undefined
+              );
+            return (
+              ffi.pactffiWithMultipartFile(
+                interactionPtr,
+                INTERACTION_PART_REQUEST,
+                contentType,
+                filename,
+                mimePartName,
+              ) === undefined
+            );
+          },
+          withResponseHeader: (name: string, index: number, value: string) =>
+            ffi.pactffiWithHeader(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              name,
+              index,
+              value,
+            ),
+          withResponseBody: (body: string | FfiJsonBody, contentType: string) =>
+            ffi.pactffiWithBody(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              body,
+            ),
+          withResponseBinaryBody: (body: Buffer, contentType: string) =>
+            ffi.pactffiWithBinaryFile(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              body,
+              body.length,
+            ),
+          withResponseBinaryFile: (path: string, contentType: string) =>
+            ffi.pactffiWithBinaryFilePath(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              path,
+            ),
+          withResponseMultipartParts: (
+            parts: FfiMultipartPart[],
+            boundary?: string,
+          ) =>
+            ffi.pactffiWithMultipartParts(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              parts,
+              boundary,
+            ),
+          withResponseMultipartBody: (
+            contentType: string,
+            filename: string,
+            mimePartName: string,
+            boundary?: string,
+          ) => {
+            if (boundary)
+              return (
+                ffi.pactffiWithMultipartFile(
+                  interactionPtr,
+                  INTERACTION_PART_REQUEST,
+                  contentType,
+                  filename,
+                  mimePartName,
+                  boundary,
+                ) === undefined
+              );
+            return (
+              ffi.pactffiWithMultipartFile(
+                interactionPtr,
+                INTERACTION_PART_REQUEST,
+                contentType,
+                filename,
+                mimePartName,
+              ) === undefined
+            );
+          },
+          withStatus: (status: number | string) =>
+            ffi.pactffiResponseStatus(interactionPtr, JSON.stringify(status)),
+          withPluginRequestInteractionContents: (
+            contentType: string,
+            contents: string,
+          ) => {
+            ffi.pactffiPluginInteractionContents(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              contents,
+            );
+
+            return true;
+          },
+          withPluginRequestResponseInteractionContents: (
+            contentType: string,
+            contents: string,
+          ) => {
+            ffi.pactffiPluginInteractionContents(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              contents,
+            );
+
+            return true;
+          },
+          withPluginResponseInteractionContents: (
+            contentType: string,
+            contents: string,
+          ) => {
+            ffi.pactffiPluginInteractionContents(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              contents,
+            );
+            return true;
+          },
+        }),
+        {
+          withQueryParameters: wrapEachWithCheck(
+            (parameters: FfiEntries) =>
+              ffi.pactffiWithQueryParameters(interactionPtr, parameters),
+            'withQueryParameters',
+          ),
+          withRequestHeaders: wrapEachWithCheck(
+            (headers: FfiEntries) =>
+              ffi.pactffiWithHeaders(
+                interactionPtr,
+                INTERACTION_PART_REQUEST,
+                headers,
+              ),
+            'withRequestHeaders',
+          ),
+          withResponseHeaders: wrapEachWithCheck(
+            (headers: FfiEntries) =>
+              ffi.pactffiWithHeaders(
+                interactionPtr,
+                INTERACTION_PART_RESPONSE,
+                headers,
+              ),
+            'withResponseHeaders',
+          ),
+          clone: (overrides: FfiCloneOverrides) =>
+            interactionWrapper(
+              ffi.pactffiCloneInteraction(interactionPtr, overrides),
+            ),
+        },
+      ),
+      pact,
     );
-  }
 
-  return {
+  const pact: ConsumerPact = managePactHandle(ownership.release, {
     addPlugin: (name: string, pluginVersion: string) => {
       ffi.pactffiUsingPlugin(pactPtr, name, pluginVersion);
     },
@@ -203,139 +513,172 @@ export const makeConsumerPact = (
         (port: number): boolean => ffi.pactffiCleanupMockServer(port),
         'cleanupMockServer',
       )(mockServerPort),
-    writePactFile: (dir: string, merge = true) =>
-      writePact(ffi, pactPtr, dir, merge),
+    writePactFile: (dir: string, merge = true) => ownership.write(dir, merge),
     writePactFileForPluginServer: (port: number, dir: string, merge = true) =>
       writePact(ffi, pactPtr, dir, merge, port),
     addMetadata: (namespace: string, name: string, value: string): boolean =>
       ffi.pactffiWithPactMetadata(pactPtr, namespace, name, value),
+    enableJournal: () => ffi.pactffiEnableJournal(pactPtr),
+    snapshot: (): Buffer => ffi.pactffiSnapshotPact(pactPtr),
+    matchRequest: (
+      request: InProcessRequest,
+      body?: Buffer,
+    ): Promise<InProcessMatchResult> => {
+      const result = inProcess.then(() =>
+        matchInProcess(ffi, pactPtr, request, body),
+      );
+      inProcess = result.catch(() => undefined);
+      return result;
+    },
+    inProcessMatchedSuccessfully: (): boolean =>
+      ffi.pactffiInProcessMatched(pactPtr),
+    inProcessMismatches: (): MatchingResult[] =>
+      (
+        JSON.parse(ffi.pactffiInProcessMismatches(pactPtr)) as MatchingResult[]
+      ).map(parseMismatches),
     newAsynchronousMessage: (description: string): AsynchronousMessage => {
       const interactionPtr = ffi.pactffiNewAsyncMessage(pactPtr, description);
       const index = messageCount;
       messageCount += 1;
 
-      return asyncMessage(ffi, interactionPtr, pactPtr, messageCount, index);
+      return retainPact(
+        asyncMessage(ffi, interactionPtr, pactPtr, messageCount, index),
+        pact,
+      );
     },
     newSynchronousMessage: (description: string): SynchronousMessage => {
       const interactionPtr = ffi.pactffiNewSyncMessage(pactPtr, description);
       const index = messageCount;
       messageCount += 1;
 
-      return {
-        withPluginRequestInteractionContents: (
-          contentType: string,
-          contents: string,
-        ) => {
-          ffi.pactffiPluginInteractionContents(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            contents,
-          );
-          return true;
-        },
-        withPluginResponseInteractionContents: (
-          contentType: string,
-          contents: string,
-        ) => {
-          ffi.pactffiPluginInteractionContents(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            contentType,
-            contents,
-          );
-          return true;
-        },
-        withPluginRequestResponseInteractionContents: (
-          contentType: string,
-          contents: string,
-        ) => {
-          ffi.pactffiPluginInteractionContents(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            contents,
-          );
-          return true;
+      return retainPact(
+        {
+          withPluginRequestInteractionContents: (
+            contentType: string,
+            contents: string,
+          ) => {
+            ffi.pactffiPluginInteractionContents(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              contents,
+            );
+            return true;
+          },
+          withPluginResponseInteractionContents: (
+            contentType: string,
+            contents: string,
+          ) => {
+            ffi.pactffiPluginInteractionContents(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              contents,
+            );
+            return true;
+          },
+          withPluginRequestResponseInteractionContents: (
+            contentType: string,
+            contents: string,
+          ) => {
+            ffi.pactffiPluginInteractionContents(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              contents,
+            );
+            return true;
+          },
+          given: (state: string) => ffi.pactffiGiven(interactionPtr, state),
+          givenWithParam: (state: string, name: string, value: string) =>
+            ffi.pactffiGivenWithParam(interactionPtr, state, name, value),
+          givenWithParams: (state: string, params: string) =>
+            ffi.pactffiGivenWithParams(interactionPtr, state, params),
+          setPending: (pending: boolean) =>
+            ffi.pactffiSetPending(interactionPtr, pending),
+          setKey: (value: string) => ffi.pactffiSetKey(interactionPtr, value),
+          setComment: (key: string, value: string) =>
+            ffi.pactffiSetComment(interactionPtr, key, value),
+          addTextComment: (comment: string) =>
+            ffi.pactffiAddTextComment(interactionPtr, comment),
+          addInteractionReference: (
+            group: string,
+            name: string,
+            value: string,
+          ) =>
+            ffi.pactffiAddInteractionReference(
+              interactionPtr,
+              group,
+              name,
+              value,
+            ),
+          setInteractionTestName: (name: string) =>
+            ffi.pactffiInteractionTestName(interactionPtr, name),
+          withRequestContents: (
+            body: string | FfiJsonBody,
+            contentType: string,
+          ) =>
+            ffi.pactffiWithBody(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              body,
+            ),
+          withResponseContents: (
+            body: string | FfiJsonBody,
+            contentType: string,
+          ) =>
+            ffi.pactffiWithBody(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              body,
+            ),
+          withRequestMatchingRules: (rules: string) =>
+            ffi.pactffiWithMatchingRules(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              rules,
+            ),
+          withResponseMatchingRules: (rules: string) =>
+            ffi.pactffiWithMatchingRules(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              rules,
+            ),
+          withRequestBinaryContents: (body: Buffer, contentType: string) =>
+            ffi.pactffiWithBinaryFile(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              body,
+              body.length,
+            ),
+          withResponseBinaryContents: (body: Buffer, contentType: string) =>
+            ffi.pactffiWithBinaryFile(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              body,
+              body.length,
+            ),
+          withMetadata: (name: string, value: string) =>
+            ffi.pactffiMessageWithMetadata(interactionPtr, name, value),
+          getRequestContents: () =>
+            ffi.pactffiGetSyncMessageRequestContents(
+              pactPtr,
+              messageCount,
+              index,
+            ),
+          getResponseContents: () =>
+            ffi.pactffiGetSyncMessageResponseContents(
+              pactPtr,
+              messageCount,
+              index,
+            ),
         },
-        given: (state: string) => ffi.pactffiGiven(interactionPtr, state),
-        givenWithParam: (state: string, name: string, value: string) =>
-          ffi.pactffiGivenWithParam(interactionPtr, state, name, value),
-        givenWithParams: (state: string, params: string) =>
-          ffi.pactffiGivenWithParams(interactionPtr, state, params),
-        setPending: (pending: boolean) =>
-          ffi.pactffiSetPending(interactionPtr, pending),
-        setKey: (value: string) => ffi.pactffiSetKey(interactionPtr, value),
-        setComment: (key: string, value: string) =>
-          ffi.pactffiSetComment(interactionPtr, key, value),
-        addTextComment: (comment: string) =>
-          ffi.pactffiAddTextComment(interactionPtr, comment),
-        addInteractionReference: (group: string, name: string, value: string) =>
-          ffi.pactffiAddInteractionReference(
-            interactionPtr,
-            group,
-            name,
-            value,
-          ),
-        setInteractionTestName: (name: string) =>
-          ffi.pactffiInteractionTestName(interactionPtr, name),
-        withRequestContents: (body: string, contentType: string) =>
-          ffi.pactffiWithBody(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            body,
-          ),
-        withResponseContents: (body: string, contentType: string) =>
-          ffi.pactffiWithBody(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            contentType,
-            body,
-          ),
-        withRequestMatchingRules: (rules: string) =>
-          ffi.pactffiWithMatchingRules(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            rules,
-          ),
-        withResponseMatchingRules: (rules: string) =>
-          ffi.pactffiWithMatchingRules(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            rules,
-          ),
-        withRequestBinaryContents: (body: Buffer, contentType: string) =>
-          ffi.pactffiWithBinaryFile(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            body,
-            body.length,
-          ),
-        withResponseBinaryContents: (body: Buffer, contentType: string) =>
-          ffi.pactffiWithBinaryFile(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            contentType,
-            body,
-            body.length,
-          ),
-        withMetadata: (name: string, value: string) =>
-          ffi.pactffiMessageWithMetadata(interactionPtr, name, value),
-        getRequestContents: () =>
-          ffi.pactffiGetSyncMessageRequestContents(
-            pactPtr,
-            messageCount,
-            index,
-          ),
-        getResponseContents: () =>
-          ffi.pactffiGetSyncMessageResponseContents(
-            pactPtr,
-            messageCount,
-            index,
-          ),
-      };
+        pact,
+      );
     },
     pactffiCreateMockServerForTransport(
       address: string,
@@ -351,195 +694,139 @@ export const makeConsumerPact = (
         config,
       );
     },
-    newInteraction: (interactionDescription: string): ConsumerInteraction => {
-      const interactionPtr = ffi.pactffiNewInteraction(
-        pactPtr,
-        interactionDescription,
-      );
+    newInteraction: (interactionDescription: string): ConsumerInteraction =>
+      interactionWrapper(
+        ffi.pactffiNewInteraction(pactPtr, interactionDescription),
+      ),
+  });
 
-      return wrapAllWithCheck<ConsumerInteraction>({
-        uponReceiving: (recieveDescription: string) =>
-          ffi.pactffiUponReceiving(interactionPtr, recieveDescription),
-        given: (state: string) => ffi.pactffiGiven(interactionPtr, state),
-        givenWithParam: (state: string, name: string, value: string) =>
-          ffi.pactffiGivenWithParam(interactionPtr, state, name, value),
-        givenWithParams: (state: string, params: string) =>
-          ffi.pactffiGivenWithParams(interactionPtr, state, params),
-        setPending: (pending: boolean) =>
-          ffi.pactffiSetPending(interactionPtr, pending),
-        setKey: (value: string) => ffi.pactffiSetKey(interactionPtr, value),
-        setComment: (key: string, value: string) =>
-          ffi.pactffiSetComment(interactionPtr, key, value),
-        addTextComment: (comment: string) =>
-          ffi.pactffiAddTextComment(interactionPtr, comment),
-        addInteractionReference: (group: string, name: string, value: string) =>
-          ffi.pactffiAddInteractionReference(
-            interactionPtr,
-            group,
-            name,
-            value,
-          ),
-        setInteractionTestName: (name: string) =>
-          ffi.pactffiInteractionTestName(interactionPtr, name),
-        withRequest: (method: string, path: string) =>
-          ffi.pactffiWithRequest(interactionPtr, method, path),
-        withQuery: (name: string, index: number, value: string) =>
-          ffi.pactffiWithQueryParameter(interactionPtr, name, index, value),
-        withRequestHeader: (name: string, index: number, value: string) =>
-          ffi.pactffiWithHeader(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            name,
-            index,
-            value,
-          ),
-        withRequestBody: (body: string, contentType: string) =>
-          ffi.pactffiWithBody(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            body,
-          ),
-        withRequestBinaryBody: (body: Buffer, contentType: string) =>
-          ffi.pactffiWithBinaryFile(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            body,
-            body.length,
-          ),
-        withRequestMatchingRules: (rules: string) =>
-          ffi.pactffiWithMatchingRules(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            rules,
-          ),
-        withResponseMatchingRules: (rules: string) =>
-          ffi.pactffiWithMatchingRules(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            rules,
-          ),
-        withRequestMultipartBody: (
-          contentType: string,
-          filename: string,
-          mimePartName: string,
-          boundary?: string,
-        ) => {
-          if (boundary)
-            return (
-              ffi.pactffiWithMultipartFile(
-                interactionPtr,
-                INTERACTION_PART_REQUEST,
-                contentType,
-                filename,
-                mimePartName,
-                boundary,
-              ) === undefined
-            );
-          return (
-            ffi.pactffiWithMultipartFile(
-              interactionPtr,
-              INTERACTION_PART_REQUEST,
-              contentType,
-              filename,
-              mimePartName,
-            ) === undefined
-          );
-        },
-        withResponseHeader: (name: string, index: number, value: string) =>
-          ffi.pactffiWithHeader(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            name,
-            index,
-            value,
-          ),
-        withResponseBody: (body: string, contentType: string) =>
-          ffi.pactffiWithBody(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            contentType,
-            body,
-          ),
-        withResponseBinaryBody: (body: Buffer, contentType: string) =>
-          ffi.pactffiWithBinaryFile(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            contentType,
-            body,
-            body.length,
-          ),
-        withResponseMultipartBody: (
-          contentType: string,
-          filename: string,
-          mimePartName: string,
-          boundary?: string,
-        ) => {
-          if (boundary)
-            return (
-              ffi.pactffiWithMultipartFile(
-                interactionPtr,
-                INTERACTION_PART_REQUEST,
-                contentType,
-                filename,
-                mimePartName,
-                boundary,
-              ) === undefined
-            );
-          return (
-            ffi.pactffiWithMultipartFile(
-              interactionPtr,
-              INTERACTION_PART_REQUEST,
-              contentType,
-              filename,
-              mimePartName,
-            ) === undefined
-          );
-        },
-        withStatus: (status: number | string) =>
-          ffi.pactffiResponseStatus(interactionPtr, JSON.stringify(status)),
-        withPluginRequestInteractionContents: (
-          contentType: string,
-          contents: string,
-        ) => {
-          ffi.pactffiPluginInteractionContents(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            contents,
-          );
+  return pact;
+};
 
-          return true;
-        },
-        withPluginRequestResponseInteractionContents: (
-          contentType: string,
-          contents: string,
-        ) => {
-          ffi.pactffiPluginInteractionContents(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            contents,
-          );
+export const makeConsumerPact = (
+  consumer: string,
+  provider: string,
+  version: FfiSpecificationVersion = 3,
+  logLevel = getLogLevel(),
+  logFile?: string,
+): ConsumerPact => {
+  if (logLevel) {
+    setLogLevel(logLevel);
+  }
+  const ffi = getFfiLib(logLevel, logFile);
 
-          return true;
-        },
-        withPluginResponseInteractionContents: (
-          contentType: string,
-          contents: string,
-        ) => {
-          ffi.pactffiPluginInteractionContents(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            contentType,
-            contents,
-          );
-          return true;
-        },
-      });
+  const pactPtr = ffi.pactffiNewPact(consumer, provider);
+  if (!ffi.pactffiWithSpecification(pactPtr, version)) {
+    throw new Error(
+      `Unable to set core spec version. The pact FfiSpecificationVersion '${version}' may be invalid (note this is not the same as the pact spec version)`,
+    );
+  }
+
+  return consumerPact(ffi, pactPtr, {
+    write: (dir, merge) => writePact(ffi, pactPtr, dir, merge),
+    release: { ffi, pactPtr, shared: false },
+  });
+};
+
+/**
+ * Like `makeConsumerPact`, but every call for the same consumer and provider in the process,
+ * including from other worker threads, writes to one shared pact. Each call gets a pact of its
+ * own to add interactions to and start mock servers from, and calls `writePactFile` when done to
+ * add its interactions to the shared pact (or `dispose` to drop out without them); the pact file
+ * is written once, when the last worker has finished, rather than each worker merging into it in
+ * turn. HTTP interactions only, without plugin contents.
+ *
+ * So `writePactFile` returns before the file is written unless it is the last. Whichever release
+ * is last reports a failed write: `writePactFile` throws, and `dispose` or garbage collection logs
+ * it as an error.
+ */
+export const makeSharedConsumerPact = (
+  consumer: string,
+  provider: string,
+  version: FfiSpecificationVersion = 3,
+  logLevel = getLogLevel(),
+  logFile?: string,
+): ConsumerPact => {
+  if (logLevel) {
+    setLogLevel(logLevel);
+  }
+  const ffi = getFfiLib(logLevel, logFile);
+
+  const pactPtr = ffi.pactffiAcquireSharedPact(consumer, provider, version);
+  const release: PactRelease = { ffi, pactPtr, shared: true };
+
+  const pact = consumerPact(ffi, pactPtr, {
+    write: (dir, merge) => {
+      release.writeTo = { dir, merge };
+      pact.dispose();
     },
-  };
+    release,
+  });
+  return pact;
+};
+
+/**
+ * Loads an existing pact file (by path, or its contents) into a new pact, to start a mock server
+ * from or add interactions to, without rebuilding it through the DSL. HTTP pacts only; generators
+ * in the file are not imported. Pass `journal` to enable journaling on the imported pact (see
+ * `ConsumerPact.enableJournal`), so its interactions can be cloned.
+ */
+export const importConsumerPact = (
+  source: string | Buffer,
+  logLevel = getLogLevel(),
+  logFile?: string,
+  journal = false,
+): ConsumerPact => {
+  if (logLevel) {
+    setLogLevel(logLevel);
+  }
+  const ffi = getFfiLib(logLevel, logFile);
+
+  const pactPtr = ffi.pactffiImportPact(source, journal);
+
+  return consumerPact(ffi, pactPtr, {
+    write: (dir, merge) => writePact(ffi, pactPtr, dir, merge),
+    release: { ffi, pactPtr, shared: false },
+  });
+};
+
+/**
+ * Checks values (generated fixtures, say) against a matcher definition such as
+ * `matching(regex, '[0-9]+', '100')`, with the core's matching semantics. Returns
+ * an entry per value: null if it matches, otherwise why not.
+ */
+export const matchValues = (
+  definition: string,
+  values: string[],
+  logLevel = getLogLevel(),
+  logFile?: string,
+): (string | null)[] => {
+  if (logLevel) {
+    setLogLevel(logLevel);
+  }
+  return getFfiLib(logLevel, logFile).pactffiMatchValues(definition, values);
+};
+
+/**
+ * Rebuilds a pact from a snapshot taken with `ConsumerPact.snapshot`, so a common base pact can
+ * be built once and restored by each test file that adds to it.
+ */
+export const restoreConsumerPact = (
+  snapshot: Buffer,
+  logLevel = getLogLevel(),
+  logFile?: string,
+): ConsumerPact => {
+  if (logLevel) {
+    setLogLevel(logLevel);
+  }
+  const ffi = getFfiLib(logLevel, logFile);
+
+  const pactPtr = ffi.pactffiRestorePact(snapshot);
+
+  return consumerPact(ffi, pactPtr, {
+    write: (dir, merge) => writePact(ffi, pactPtr, dir, merge),
+    release: { ffi, pactPtr, shared: false },
+  });
 };
 
 export const makeConsumerMessagePact = (
@@ -564,7 +851,9 @@ export const makeConsumerMessagePact = (
     );
   }
 
-  return {
+  const release: PactRelease = { ffi, pactPtr, shared: false };
+
+  const pact: ConsumerMessagePact = managePactHandle(release, {
     addPlugin: (name: string, pluginVersion: string) => {
       ffi.pactffiUsingPlugin(pactPtr, name, pluginVersion);
     },
@@ -600,14 +889,20 @@ export const makeConsumerMessagePact = (
       const index = messageCount;
       messageCount += 1;
 
-      return asyncMessage(ffi, interactionPtr, pactPtr, messageCount, index);
+      return retainPact(
+        asyncMessage(ffi, interactionPtr, pactPtr, messageCount, index),
+        pact,
+      );
     },
     newAsynchronousMessage: (description: string): AsynchronousMessage => {
       const interactionPtr = ffi.pactffiNewAsyncMessage(pactPtr, description);
       const index = messageCount;
       messageCount += 1;
 
-      return asyncMessage(ffi, interactionPtr, pactPtr, messageCount, index);
+      return retainPact(
+        asyncMessage(ffi, interactionPtr, pactPtr, messageCount, index),
+        pact,
+      );
     },
     newSynchronousMessage: (description: string): SynchronousMessage => {
       const index = messageCount;
@@ -616,121 +911,134 @@ export const makeConsumerMessagePact = (
       // TODO: will this automatically set the correct spec version?
       const interactionPtr = ffi.pactffiNewSyncMessage(pactPtr, description);
 
-      return {
-        withPluginRequestInteractionContents: (
-          contentType: string,
-          contents: string,
-        ) => {
-          ffi.pactffiPluginInteractionContents(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            contents,
-          );
-          return true;
-        },
-        withPluginResponseInteractionContents: (
-          contentType: string,
-          contents: string,
-        ) => {
-          ffi.pactffiPluginInteractionContents(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            contentType,
-            contents,
-          );
-          return true;
-        },
-        withPluginRequestResponseInteractionContents: (
-          contentType: string,
-          contents: string,
-        ) => {
-          ffi.pactffiPluginInteractionContents(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            contents,
-          );
-          return true;
+      return retainPact(
+        {
+          withPluginRequestInteractionContents: (
+            contentType: string,
+            contents: string,
+          ) => {
+            ffi.pactffiPluginInteractionContents(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              contents,
+            );
+            return true;
+          },
+          withPluginResponseInteractionContents: (
+            contentType: string,
+            contents: string,
+          ) => {
+            ffi.pactffiPluginInteractionContents(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              contents,
+            );
+            return true;
+          },
+          withPluginRequestResponseInteractionContents: (
+            contentType: string,
+            contents: string,
+          ) => {
+            ffi.pactffiPluginInteractionContents(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              contents,
+            );
+            return true;
+          },
+          given: (state: string) => ffi.pactffiGiven(interactionPtr, state),
+          givenWithParam: (state: string, name: string, value: string) =>
+            ffi.pactffiGivenWithParam(interactionPtr, state, name, value),
+          givenWithParams: (state: string, params: string) =>
+            ffi.pactffiGivenWithParams(interactionPtr, state, params),
+          setPending: (pending: boolean) =>
+            ffi.pactffiSetPending(interactionPtr, pending),
+          setKey: (value: string) => ffi.pactffiSetKey(interactionPtr, value),
+          setComment: (key: string, value: string) =>
+            ffi.pactffiSetComment(interactionPtr, key, value),
+          addTextComment: (comment: string) =>
+            ffi.pactffiAddTextComment(interactionPtr, comment),
+          addInteractionReference: (
+            group: string,
+            name: string,
+            value: string,
+          ) =>
+            ffi.pactffiAddInteractionReference(
+              interactionPtr,
+              group,
+              name,
+              value,
+            ),
+          setInteractionTestName: (name: string) =>
+            ffi.pactffiInteractionTestName(interactionPtr, name),
+          withRequestContents: (
+            body: string | FfiJsonBody,
+            contentType: string,
+          ) =>
+            ffi.pactffiWithBody(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              body,
+            ),
+          withResponseContents: (
+            body: string | FfiJsonBody,
+            contentType: string,
+          ) =>
+            ffi.pactffiWithBody(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              body,
+            ),
+          withRequestMatchingRules: (rules: string) =>
+            ffi.pactffiWithMatchingRules(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              rules,
+            ),
+          withResponseMatchingRules: (rules: string) =>
+            ffi.pactffiWithMatchingRules(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              rules,
+            ),
+          withRequestBinaryContents: (body: Buffer, contentType: string) =>
+            ffi.pactffiWithBinaryFile(
+              interactionPtr,
+              INTERACTION_PART_REQUEST,
+              contentType,
+              body,
+              body.length,
+            ),
+          withResponseBinaryContents: (body: Buffer, contentType: string) =>
+            ffi.pactffiWithBinaryFile(
+              interactionPtr,
+              INTERACTION_PART_RESPONSE,
+              contentType,
+              body,
+              body.length,
+            ),
+          withMetadata: (name: string, value: string) =>
+            ffi.pactffiMessageWithMetadata(interactionPtr, name, value),
+          getRequestContents: () =>
+            ffi.pactffiGetSyncMessageRequestContents(
+              pactPtr,
+              messageCount,
+              index,
+            ),
+          getResponseContents: () =>
+            ffi.pactffiGetSyncMessageResponseContents(
+              pactPtr,
+              messageCount,
+              index,
+            ),
         },
-        given: (state: string) => ffi.pactffiGiven(interactionPtr, state),
-        givenWithParam: (state: string, name: string, value: string) =>
-          ffi.pactffiGivenWithParam(interactionPtr, state, name, value),
-        givenWithParams: (state: string, params: string) =>
-          ffi.pactffiGivenWithParams(interactionPtr, state, params),
-        setPending: (pending: boolean) =>
-          ffi.pactffiSetPending(interactionPtr, pending),
-        setKey: (value: string) => ffi.pactffiSetKey(interactionPtr, value),
-        setComment: (key: string, value: string) =>
-          ffi.pactffiSetComment(interactionPtr, key, value),
-        addTextComment: (comment: string) =>
-          ffi.pactffiAddTextComment(interactionPtr, comment),
-        addInteractionReference: (group: string, name: string, value: string) =>
-          ffi.pactffiAddInteractionReference(
-            interactionPtr,
-            group,
-            name,
-            value,
-          ),
-        setInteractionTestName: (name: string) =>
-          ffi.pactffiInteractionTestName(interactionPtr, name),
-        withRequestContents: (body: string, contentType: string) =>
-          ffi.pactffiWithBody(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            body,
-          ),
-        withResponseContents: (body: string, contentType: string) =>
-          ffi.pactffiWithBody(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            contentType,
-            body,
-          ),
-        withRequestMatchingRules: (rules: string) =>
-          ffi.pactffiWithMatchingRules(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            rules,
-          ),
-        withResponseMatchingRules: (rules: string) =>
-          ffi.pactffiWithMatchingRules(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            rules,
-          ),
-        withRequestBinaryContents: (body: Buffer, contentType: string) =>
-          ffi.pactffiWithBinaryFile(
-            interactionPtr,
-            INTERACTION_PART_REQUEST,
-            contentType,
-            body,
-            body.length,
-          ),
-        withResponseBinaryContents: (body: Buffer, contentType: string) =>
-          ffi.pactffiWithBinaryFile(
-            interactionPtr,
-            INTERACTION_PART_RESPONSE,
-            contentType,
-            body,
-            body.length,
-          ),
-        withMetadata: (name: string, value: string) =>
-          ffi.pactffiMessageWithMetadata(interactionPtr, name, value),
-        getRequestContents: () =>
-          ffi.pactffiGetSyncMessageRequestContents(
-            pactPtr,
-            messageCount,
-            index,
-          ),
-        getResponseContents: () =>
-          ffi.pactffiGetSyncMessageResponseContents(
-            pactPtr,
-            messageCount,
-            index,
-          ),
-      };
+        pact,
+      );
     },
     pactffiCreateMockServerForTransport(
       address: string,
@@ -750,7 +1058,9 @@ export const makeConsumerMessagePact = (
       ffi.pactffiMockServerMatched(port),
     mockServerMismatches: (port: number): MatchingResult[] =>
       mockServerMismatches(ffi, port),
-  };
+  });
+
+  return pact;
 };
 
 export const makeConsumerAsyncMessagePact = makeConsumerMessagePact;
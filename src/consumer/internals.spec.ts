@@ -0,0 +1,40 @@
+import type { Ffi } from '../ffi/types';
+import { managePactHandle } from './internals';
+
+describe('managePactHandle', () => {
+  const counting = () => {
+    const ffi = {
+      freed: 0,
+      pactffiFreePactHandle: () => {
+        ffi.freed += 1;
+        return 0;
+      },
+    };
+    return ffi;
+  };
+
+  it('releases the pact on dispose', () => {
+    const ffi = counting();
+
+    const pact = managePactHandle(
+      { ffi: ffi as unknown as Ffi, pactPtr: 1, shared: false },
+      {},
+    );
+    pact.dispose();
+
+    expect(ffi.freed).toBe(1);
+  });
+
+  it('only releases the pact once', () => {
+    const ffi = counting();
+
+    const pact = managePactHandle(
+      { ffi: ffi as unknown as Ffi, pactPtr: 1, shared: false },
+      {},
+    );
+    pact.dispose();
+    pact.dispose();
+
+    expect(ffi.freed).toBe(1);
+  });
+});
@@ -3,8 +3,98 @@ import {
   type FfiPactHandle,
   FfiWritePactResponse,
 } from '../ffi/types';
-import { logCrashAndThrow, logErrorAndThrow } from '../logger';
-import type { MatchingResult, Mismatch } from './types';
+import logger, { logCrashAndThrow, logErrorAndThrow } from '../logger';
+import type {
+  InProcessMatchResult,
+  InProcessRequest,
+  MatchingResult,
+  Mismatch,
+} from './types';
+
+/**
+ * How to release a pact in the core. Plain data rather than a closure: a closure shares its
+ * context with every other closure in the scope it was made in, and one of those referencing the
+ * wrapper would keep the wrapper alive from the registry.
+ *
+ * A shared pact (`makeSharedConsumerPact`) is released with `pactffiReleaseSharedPact`, which adds
+ * its interactions to the shared pact when `writeTo` has been set by `writePactFile`.
+ */
+export type PactRelease = {
+  ffi: Ffi;
+  pactPtr: FfiPactHandle;
+  shared: boolean;
+  writeTo?: { dir: string; merge: boolean };
+};
+
+const releasePact = ({ ffi, pactPtr, shared, writeTo }: PactRelease): void => {
+  if (!shared) {
+    ffi.pactffiFreePactHandle(pactPtr);
+    return;
+  }
+
+  const result = ffi.pactffiReleaseSharedPact(
+    pactPtr,
+    writeTo?.dir ?? '',
+    !(writeTo?.merge ?? true),
+  );
+  if (writeTo) {
+    checkWritePactResult(result);
+  } else if (result !== FfiWritePactResponse['SUCCESS']) {
+    // The last release writes the file for every worker that asked for it,
+    // so reports a failure even when it is a dispose or a garbage collection
+    logger.error(
+      `The pact core was unable to write the shared pact file (error ${result})`,
+    );
+  }
+};
+
+// Releases a pact in the core once its JS wrapper, and every interaction wrapper created from it
+// (see `retainPact`), has been garbage collected
+const pactHandleRegistry = new FinalizationRegistry<PactRelease>(releasePact);
+
+/**
+ * Adds `dispose()` to a pact wrapper, which releases the pact once, and releases it automatically
+ * if the wrapper is garbage collected without being disposed.
+ */
+export const managePactHandle = <T extends object>(
+  release: PactRelease,
+  pact: T,
+): T & { dispose: () => void } => {
+  let disposed = false;
+  const managed = Object.assign(pact, {
+    dispose: () => {
+      if (disposed) {
+        return;
+      }
+      disposed = true;
+      pactHandleRegistry.unregister(managed);
+      releasePact(release);
+    },
+  });
+  pactHandleRegistry.register(managed, release, managed);
+  return managed;
+};
+
+const PACT = Symbol('pact');
+
+/**
+ * Keeps `pact` reachable for as long as `interaction` is. Interaction handles belong to their
+ * pact, so the pact must not be finalized while an interaction is still in use.
+ */
+export const retainPact = <T extends object>(interaction: T, pact: object): T =>
+  Object.defineProperty(interaction, PACT, { value: pact });
+
+// The core reports some mismatches as JSON strings within the JSON
+export const parseMismatches = (result: MatchingResult): MatchingResult => ({
+  ...result,
+  ...('mismatches' in result
+    ? {
+        mismatches: result.mismatches.map((m: string | Mismatch) =>
+          typeof m === 'string' ? JSON.parse(m) : m,
+        ),
+      }
+    : {}),
+});
 
 export const mockServerMismatches = (
   ffi: Ffi,
@@ -13,33 +103,102 @@ export const mockServerMismatches = (
   const results: MatchingResult[] = JSON.parse(
     ffi.pactffiMockServerMismatches(port),
   );
-  return results.map((result: MatchingResult) => ({
-    ...result,
-    ...('mismatches' in result
-      ? {
-          mismatches: result.mismatches.map((m: string | Mismatch) =>
-            typeof m === 'string' ? JSON.parse(m) : m,
-          ),
-        }
-      : {}),
-  }));
+  return results.map(parseMismatches);
 };
 
-export const writePact = (
+// Set by the client for the connection rather than the request, so not sent on
+const CONNECTION_HEADERS = [
+  'host',
+  'connection',
+  'content-length',
+  'transfer-encoding',
+];
+
+const queryString = (query: InProcessRequest['query']): string =>
+  Object.entries(query ?? {})
+    .flatMap(([name, values]) =>
+      [values]
+        .flat()
+        .map((v) => `${encodeURIComponent(name)}=${encodeURIComponent(v)}`),
+    )
+    .join('&');
+
+// The requests that reached the server and didn't match, in the order they came in
+const recordedMismatches = (ffi: Ffi, pactPtr: FfiPactHandle) =>
+  (
+    JSON.parse(ffi.pactffiInProcessMismatches(pactPtr)) as MatchingResult[]
+  ).filter((m) => m.type !== 'missing-request');
+
+/**
+ * Sends a request intercepted in process on to the pact's matching server (see
+ * `pactffiInProcessPort`), and reads back what it made of it. The server only
+ * says why a request didn't match in its list of every mismatch so far, so the
+ * caller must send one request at a time for this request's to be the one
+ * added while it was in flight.
+ */
+export const matchInProcess = async (
   ffi: Ffi,
   pactPtr: FfiPactHandle,
-  dir: string,
-  merge = true,
-  port = 0,
-): void => {
-  let result: FfiWritePactResponse;
+  request: InProcessRequest,
+  body?: Buffer,
+): Promise<InProcessMatchResult> => {
+  const port = ffi.pactffiInProcessPort(pactPtr);
+  const before = recordedMismatches(ffi, pactPtr).length;
 
-  if (port) {
-    result = ffi.pactffiWritePactFileByPort(port, dir, !merge);
-  } else {
-    result = ffi.pactffiWritePactFile(pactPtr, dir, !merge);
+  const query = queryString(request.query);
+  const separator = request.path.includes('?') ? '&' : '?';
+  const headers = new Headers();
+  for (const [name, values] of Object.entries(request.headers ?? {})) {
+    if (!CONNECTION_HEADERS.includes(name.toLowerCase())) {
+      for (const value of [values].flat()) {
+        headers.append(name, value);
+      }
+    }
+  }
+
+  const res = await fetch(
+    `http://127.0.0.1:${port}${request.path}${query ? separator + query : ''}`,
+    { method: request.method, headers, body },
+  );
+  const resBody = Buffer.from(await res.arrayBuffer());
+
+  const matchKey = res.headers.get('x-pact');
+  if (matchKey === null || matchKey === 'Request-Matched') {
+    const resHeaders: Record<string, string> = {};
+    res.headers.forEach((value, name) => {
+      if (name !== 'x-pact') {
+        resHeaders[name] = value;
+      }
+    });
+    return {
+      matched: true,
+      status: res.status,
+      headers: resHeaders,
+      body: resBody,
+    };
+  }
+
+  // The server explains the mismatch in a JSON body's `error`; anything else
+  // is passed on as it is
+  let error = resBody.toString();
+  try {
+    const parsed = JSON.parse(error);
+    if (typeof parsed?.error === 'string') {
+      error = parsed.error;
+    }
+  } catch {
+    // Not JSON
   }
 
+  const mismatch = recordedMismatches(ffi, pactPtr)[before];
+  return {
+    matched: false,
+    error,
+    mismatch: mismatch ? parseMismatches(mismatch) : null,
+  };
+};
+
+export const checkWritePactResult = (result: FfiWritePactResponse): void => {
   switch (result) {
     case FfiWritePactResponse['SUCCESS']:
       return;
@@ -60,3 +219,21 @@ export const writePact = (
       );
   }
 };
+
+export const writePact = (
+  ffi: Ffi,
+  pactPtr: FfiPactHandle,
+  dir: string,
+  merge = true,
+  port = 0,
+): void => {
+  let result: FfiWritePactResponse;
+
+  if (port) {
+    result = ffi.pactffiWritePactFileByPort(port, dir, !merge);
+  } else {
+    result = ffi.pactffiWritePactFile(pactPtr, dir, !merge);
+  }
+
+  checkWritePactResult(result);
+};
@@ -1,3 +1,10 @@
+import type {
+  FfiCloneOverrides,
+  FfiEntries,
+  FfiJsonBody,
+  FfiMultipartPart,
+} from '../ffi/types';
+
 export type MatchingResult =
   | MatchingResultSuccess
   | MatchingResultRequestMismatch
@@ -5,6 +12,32 @@ export type MatchingResult =
   | MatchingResultMissingRequest
   | MatchingResultPlugin;
 
+/**
+ * A request intercepted in process, to match against a pact (see
+ * `matchRequest`). The path is sent as it is, so should already be encoded;
+ * query parameters are encoded when the request is sent.
+ */
+export type InProcessRequest = {
+  method: string;
+  path: string;
+  query?: Record<string, string | string[]>;
+  headers?: Record<string, string | string[]>;
+};
+
+/**
+ * The outcome of matching a request in process: the matched interaction's
+ * response (repeated headers joined with commas), or why the request didn't
+ * match (null if the core didn't record a mismatch for it).
+ */
+export type InProcessMatchResult =
+  | {
+      matched: true;
+      status: number;
+      headers: Record<string, string>;
+      body: Buffer;
+    }
+  | { matched: false; error: string; mismatch: MatchingResult | null };
+
 // As far as I can tell, MatchingResultSuccess is actually
 // never produced by the FFI lib
 export type MatchingResultSuccess = {
@@ -165,6 +198,13 @@ export type PluginPact = {
   ) => void;
   cleanupPlugins: () => void;
   cleanupMockServer: (port: number) => boolean;
+  /**
+   * Frees the pact model held by the core, along with every interaction and message created from
+   * it. Running mock servers are unaffected. Pacts are also freed automatically once they, and
+   * everything created from them, are garbage collected; call this for deterministic cleanup in
+   * long running processes such as watch mode runners. Safe to call more than once.
+   */
+  dispose: () => void;
 };
 
 export type ConsumerInteraction = PluginInteraction & {
@@ -184,27 +224,69 @@ export type ConsumerInteraction = PluginInteraction & {
   setInteractionTestName: (name: string) => number;
   withRequest: (method: string, path: string) => boolean;
   withQuery: (name: string, index: number, value: string) => boolean;
+  /**
+   * Sets several query parameters in one call. Returns, for each name, whether
+   * all of its values were set.
+   */
+  withQueryParameters: (parameters: FfiEntries) => Record<string, boolean>;
   withStatus: (status: number) => boolean;
   withRequestHeader: (name: string, index: number, value: string) => boolean;
-  withRequestBody: (body: string, contentType: string) => boolean;
+  /**
+   * Sets several request headers in one call. Returns, for each name, whether
+   * all of its values were set.
+   */
+  withRequestHeaders: (headers: FfiEntries) => Record<string, boolean>;
+  withRequestBody: (body: string | FfiJsonBody, contentType: string) => boolean;
   withRequestBinaryBody: (body: Buffer, contentType: string) => boolean;
+  /**
+   * Like `withRequestBinaryBody`, with the body read from a file, which is
+   * memory mapped rather than loaded into a Buffer.
+   */
+  withRequestBinaryFile: (path: string, contentType: string) => boolean;
   withRequestMultipartBody: (
     contentType: string,
     filename: string,
     mimePartName: string,
     boundary?: string,
   ) => boolean;
+  /**
+   * Sets a multipart body from parts held in memory, without writing them to
+   * files first.
+   */
+  withRequestMultipartParts: (
+    parts: FfiMultipartPart[],
+    boundary?: string,
+  ) => boolean;
   withRequestMatchingRules: (rules: string) => boolean;
   withResponseMatchingRules: (rules: string) => boolean;
   withResponseHeader: (name: string, index: number, value: string) => boolean;
-  withResponseBody: (body: string, contentType: string) => boolean;
+  /**
+   * Sets several response headers in one call. Returns, for each name, whether
+   * all of its values were set.
+   */
+  withResponseHeaders: (headers: FfiEntries) => Record<string, boolean>;
+  withResponseBody: (
+    body: string | FfiJsonBody,
+    contentType: string,
+  ) => boolean;
   withResponseBinaryBody: (body: Buffer, contentType: string) => boolean;
+  withResponseBinaryFile: (path: string, contentType: string) => boolean;
   withResponseMultipartBody: (
     contentType: string,
     filename: string,
     mimePartName: string,
     boundary?: string,
   ) => boolean;
+  withResponseMultipartParts: (
+    parts: FfiMultipartPart[],
+    boundary?: string,
+  ) => boolean;
+  /**
+   * Copies this interaction into a new one in the same pact, with `overrides`
+   * applied, in one native call. Interactions with plugin contents can't be
+   * copied, and the pact must have journaling enabled (`enableJournal`).
+   */
+  clone: (overrides: FfiCloneOverrides) => ConsumerInteraction;
 };
 
 export type ConsumerPact = PluginPact & {
@@ -253,6 +335,39 @@ export type ConsumerPact = PluginPact & {
    */
   mockServerMatchedSuccessfully: (port: number) => boolean;
   addMetadata: (namespace: string, name: string, value: string) => boolean;
+  /**
+   * Records the calls that build the pact's interactions, so they can be cloned
+   * or the pact snapshotted. Off by default, as it keeps a copy of every body;
+   * call it before adding any interactions.
+   */
+  enableJournal: () => void;
+  /**
+   * Writes the pact and its interactions to a Buffer, which `restoreConsumerPact` rebuilds
+   * it from. Pacts with messages or plugin contents can't be snapshotted, and the pact must
+   * have journaling enabled (`enableJournal`).
+   */
+  snapshot: () => Buffer;
+  /**
+   * Matches a request against the pact's interactions, for tests that intercept
+   * HTTP in process and so have no mock server of their own to send it to. The
+   * request is sent on to a loopback mock server started for the pact on the
+   * first call (see `pactffiInProcessPort`), one request at a time, so each
+   * result carries its own mismatch. The pact is matched as it is on the first
+   * call: interactions added afterwards aren't seen.
+   *
+   * @param request the request line and headers; the path should be encoded
+   * @param body the request body, if any
+   */
+  matchRequest: (
+    request: InProcessRequest,
+    body?: Buffer,
+  ) => Promise<InProcessMatchResult>;
+  /**
+   * Check if every interaction has been matched by `matchRequest`, and no
+   * request failed to match. False if `matchRequest` hasn't been called.
+   */
+  inProcessMatchedSuccessfully: () => boolean;
+  inProcessMismatches: () => MatchingResult[];
 };
 
 export type AsynchronousMessage = RequestPluginInteraction & {
@@ -271,7 +386,7 @@ export type AsynchronousMessage = RequestPluginInteraction & {
   setInteractionTestName: (name: string) => number;
   expectsToReceive: (description: string) => void;
   withMetadata: (name: string, value: string) => void;
-  withContents: (body: string, contentType: string) => void;
+  withContents: (body: string | FfiJsonBody, contentType: string) => void;
   withBinaryContents: (body: Buffer, contentType: string) => void;
   withMatchingRules: (rules: string) => void;
   reifyMessage: () => string;
@@ -295,8 +410,14 @@ export type SynchronousMessage = PluginInteraction & {
   ) => boolean;
   setInteractionTestName: (name: string) => number;
   withMetadata: (name: string, value: string) => void;
-  withRequestContents: (body: string, contentType: string) => void;
-  withResponseContents: (body: string, contentType: string) => void;
+  withRequestContents: (
+    body: string | FfiJsonBody,
+    contentType: string,
+  ) => void;
+  withResponseContents: (
+    body: string | FfiJsonBody,
+    contentType: string,
+  ) => void;
   withRequestBinaryContents: (body: Buffer, contentType: string) => void;
   withRequestMatchingRules: (rules: string) => void;
   withResponseMatchingRules: (rules: string) => void;
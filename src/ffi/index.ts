@@ -1,8 +1,15 @@
 import path from 'node:path';
 import { isNonGlibcLinuxSync } from 'detect-libc';
-import logger, { DEFAULT_LOG_LEVEL } from '../logger';
-import type { LogLevel } from '../logger/types';
-import { type Ffi, FfiLogLevelFilter } from './types';
+import logger, { DEFAULT_LOG_LEVEL, getLogLevel } from '../logger';
+import type { LogLevel, LogSink } from '../logger/types';
+import {
+  type Ffi,
+  type FfiExportGroup,
+  FfiLogLevelFilter,
+  type FfiLogSink,
+  type FfiStats,
+  type FfiWatchdogOffender,
+} from './types';
 
 const bindings = require('node-gyp-build') as (dir?: string) => Ffi;
 
@@ -71,14 +78,19 @@ const supportedPlatformsMessage = [
   'Supported platforms are: ',
   ` - ${supportedPlatforms.join('\n - ')}`,
 ].join('\n');
-const detectedMessage = `We detected your platform as: \n\n - ${platform}`;
-logger.debug(detectedMessage);
-if (!supportedPlatforms.includes(platform)) {
-  logger.warn(supportedPlatformsMessage);
-  logger.warn(detectedMessage);
-  logger.error(`Unsupported platform: ${platform}`);
-  throw new Error(`Unsupported platform: ${platform}`);
-}
+
+// Checked when the native library is first needed rather than on require, so
+// importing the package (e.g. for its types) costs nothing on any platform
+const checkPlatform = () => {
+  const detectedMessage = `We detected your platform as: \n\n - ${platform}`;
+  logger.debug(detectedMessage);
+  if (!supportedPlatforms.includes(platform)) {
+    logger.warn(supportedPlatformsMessage);
+    logger.warn(detectedMessage);
+    logger.error(`Unsupported platform: ${platform}`);
+    throw new Error(`Unsupported platform: ${platform}`);
+  }
+};
 
 const loadPathMessage = (bindingsPath: string) =>
   `: attempting to load native module from: \n\n - ${path.join(
@@ -98,15 +110,13 @@ const loadPathMessage = (bindingsPath: string) =>
 const bindingsResolver = (bindingsPath: string | undefined) =>
   bindings(bindingsPath);
 
-const localBindingPath =
-  process.env['PACT_PREBUILD_LOCATION']?.toString() ?? path.resolve();
-const bindingPaths = [
-  localBindingPath,
+const getBindingPaths = () => [
+  process.env['PACT_PREBUILD_LOCATION']?.toString() ?? path.resolve(),
   path.resolve(getPlatformArchSpecificPackage()),
 ];
 let ffiLib: Ffi;
 
-const renderBinaryErrorMessage = (error: unknown) => {
+const renderBinaryErrorMessage = (error: unknown, bindingPaths: string[]) => {
   logger.debug(supportedPlatformsMessage);
   logger.error(`Failed to find native module for ${platform}: ${error}`);
   bindingPaths.forEach((bindingPath) => {
@@ -132,8 +142,78 @@ const renderBinaryErrorMessage = (error: unknown) => {
 };
 
 let ffi: typeof ffiLib;
+let logSinks: LogSink[] | undefined;
+
+const toFfiLogSink = (sink: LogSink): FfiLogSink => ({
+  specifier: sink.type === 'file' ? `file ${sink.path}` : sink.type,
+  level: FfiLogLevelFilter[sink.level] ?? 3,
+});
+
+/**
+ * Sends the native core's logs to several sinks at once, each filtered at its
+ * own level - for example errors to stderr and trace to a file.
+ *
+ * The core logger can only be configured once per process, so this must be
+ * called before the first pact or verifier is created. When set, it takes
+ * precedence over the `logFile` option.
+ */
+export const setLogSinks = (sinks: LogSink[]): void => {
+  if (ffi) {
+    logger.warn(
+      'The native core has already been initialised, so the log sinks will not be applied',
+    );
+    return;
+  }
+  logSinks = sinks;
+};
+
+/**
+ * Stands in for the exports of each deferred group (see
+ * `pactffiExportGroups`) with getters that register the whole group on first
+ * access. A process that only verifies never creates the consumer's function
+ * objects, and vice versa.
+ *
+ * Setting PACT_EAGER_EXPORT_GROUPS registers every group up front instead,
+ * which is what the startup benchmark compares against.
+ */
+const deferExportGroups = (lib: Ffi): Ffi => {
+  const exports = lib as unknown as Record<string, unknown>;
+  const groups = lib.pactffiExportGroups();
+
+  if (process.env['PACT_EAGER_EXPORT_GROUPS']) {
+    for (const group of Object.keys(groups)) {
+      lib.pactffiLoadExportGroup(group as FfiExportGroup);
+    }
+    return lib;
+  }
+
+  for (const [group, names] of Object.entries(groups)) {
+    const load = () => {
+      logger.trace(`Loading the native ${group} exports`);
+      for (const name of names) {
+        delete exports[name];
+      }
+      lib.pactffiLoadExportGroup(group as FfiExportGroup);
+    };
+
+    for (const name of names) {
+      Object.defineProperty(exports, name, {
+        configurable: true,
+        enumerable: true,
+        get: () => {
+          load();
+          return exports[name];
+        },
+      });
+    }
+  }
+
+  return lib;
+};
 
 const initialiseFfi = (): typeof ffi => {
+  checkPlatform();
+  const bindingPaths = getBindingPaths();
   // @ts-expect-error
   if (process.stdout._handle) {
     // @ts-expect-error
@@ -157,12 +237,12 @@ const initialiseFfi = (): typeof ffi => {
       }
     });
   } catch (error) {
-    renderBinaryErrorMessage(error);
+    renderBinaryErrorMessage(error, bindingPaths);
     throw new Error(
       `Failed to load native module, try setting LOG_LEVEL=debug for more info`,
     );
   }
-  return ffiLib;
+  return deferExportGroups(ffiLib);
 };
 
 export const getFfiLib = (
@@ -176,7 +256,15 @@ export const getFfiLib = (
       `Initialising native core at log level '${logLevel}'`,
       logFile,
     );
-    if (logFile) {
+    if (logSinks && logSinks.length > 0) {
+      logger.debug(
+        `writing core logs to ${logSinks.map((sink) => sink.type).join(', ')}`,
+      );
+      const res = ffiLib.pactffiLogToSinks(logSinks.map(toFfiLogSink));
+      if (res !== 0) {
+        logger.warn(`Failed to configure the log sinks, reason: ${res}`);
+      }
+    } else if (logFile) {
       logger.debug(`writing log file at level ${logLevel} to ${logFile}`);
       const res = ffiLib.pactffiLogToFile(
         logFile,
@@ -191,3 +279,60 @@ export const getFfiLib = (
   }
   return ffi;
 };
+
+/**
+ * Starts (or stops) recording call counts and latency histograms for every
+ * native export. Recording is off by default.
+ */
+export const enableNativeStats = (enabled = true): void => {
+  getFfiLib(getLogLevel()).pactffiEnableStats(enabled);
+};
+
+/**
+ * Returns the call counts and latency histograms recorded for each native
+ * export since recording started, or since the last reset.
+ */
+export const getNativeStats = (reset = false): FfiStats =>
+  getFfiLib(getLogLevel()).pactffiStats(reset);
+
+/**
+ * Warns (through the logger) about native calls that block the JS thread for
+ * at least `thresholdMs`, and keeps the `topN` slowest of them. A threshold of
+ * 0 turns the watchdog off.
+ */
+export const enableNativeWatchdog = (thresholdMs = 50, topN = 10): void => {
+  getFfiLib(getLogLevel()).pactffiEnableWatchdog(
+    thresholdMs,
+    topN,
+    (warning) => {
+      logger.warn(
+        `native call ${warning.name}${warning.args} blocked the event loop for ${warning.durationMs.toFixed(1)}ms (threshold ${warning.thresholdMs}ms)`,
+      );
+    },
+  );
+};
+
+/**
+ * Returns the slowest native calls seen by the watchdog, slowest first.
+ */
+export const getNativeWatchdogOffenders = (
+  reset = false,
+): FfiWatchdogOffender[] =>
+  getFfiLib(getLogLevel()).pactffiWatchdogOffenders(reset);
+
+/**
+ * Starts (or stops) recording a timeline of native calls, verifier runs and
+ * mock server lifecycle events. If `exitPath` is given, the timeline is
+ * written there when the process exits.
+ */
+export const enableNativeTrace = (enabled = true, exitPath?: string): void => {
+  getFfiLib(getLogLevel()).pactffiEnableTrace(enabled, exitPath);
+};
+
+/**
+ * Writes the recorded timeline as Chrome trace event JSON, which can be
+ * loaded in Perfetto (https://ui.perfetto.dev). Returns the number of events
+ * written.
+ */
+export const writeNativeTrace = (path: string, clear = false): number =>
+  getFfiLib(getLogLevel()).pactffiWriteTrace(path, clear);
@@ -61,6 +61,48 @@ export type FfiInteractionPart = 0 | 1;
 export const INTERACTION_PART_REQUEST: FfiInteractionPart = 0;
 export const INTERACTION_PART_RESPONSE: FfiInteractionPart = 1;
 
+/**
+ * A JSON body given as a value rather than a string. It is serialised to JSON
+ * natively, following the rules of JSON.stringify, and keys are kept as they
+ * are, so embedded matchers (`pact:matcher:type` etc.) reach the core intact.
+ */
+export type FfiJsonBody = Record<string, unknown> | unknown[];
+
+/**
+ * Header or query parameter values for the batch setters, keyed by name. A
+ * value is a string, a matcher object, or an array of them for an entry with
+ * multiple values.
+ */
+export type FfiEntryValue = string | Record<string, unknown>;
+export type FfiEntries = Record<string, FfiEntryValue | FfiEntryValue[]>;
+
+/**
+ * One part of a multipart body built in memory (see `pactffiWithMultipartParts`).
+ */
+export type FfiMultipartPart = {
+  name: string;
+  contentType: string;
+  body: Buffer;
+  filename?: string;
+};
+
+/**
+ * What to change in a copy of an interaction (see `pactffiCloneInteraction`).
+ * Anything not given keeps the original's value. Bodies keep the content type
+ * of the original's body.
+ */
+export type FfiCloneOverrides = {
+  description: string;
+  method?: string;
+  path?: string;
+  query?: FfiEntries;
+  requestHeaders?: FfiEntries;
+  responseHeaders?: FfiEntries;
+  requestBody?: string | FfiJsonBody;
+  responseBody?: string | FfiJsonBody;
+  status?: number | string;
+};
+
 export const CREATE_MOCK_SERVER_ERRORS = {
   NULL_POINTER: -1,
   JSON_PARSE_ERROR: -2,
@@ -107,9 +149,91 @@ export enum FfiLogLevelFilter {
   trace = 5,
 }
 
+/**
+ * A core log sink. The specifier is one of `stdout`, `stderr`, `buffer` or
+ * `file <path>`, and each sink filters records at its own level.
+ */
+export type FfiLogSink = {
+  specifier: string;
+  level: FfiLogLevelFilter;
+};
+
+/**
+ * Call counts and latencies recorded for one native export. Latencies are in
+ * nanoseconds, and `histogram` holds `[upperBoundNs, count]` pairs for the
+ * non-empty buckets.
+ */
+export type FfiExportStats = {
+  calls: number;
+  errors: number;
+  totalNs: number;
+  maxNs: number;
+  p50Ns: number;
+  p90Ns: number;
+  p99Ns: number;
+  p999Ns: number;
+  histogram: [number, number][];
+};
+
+export type FfiAllocatorStats = {
+  allocatedBytes: number;
+  source: string;
+};
+
+/**
+ * String arguments decoded on the calling thread: how many there were, how
+ * many were too long to decode on the stack, and how many of those needed a
+ * heap allocation.
+ */
+export type FfiMarshallingStats = {
+  strings: number;
+  pooled: number;
+  heapAllocations: number;
+};
+
+export type FfiStats = {
+  enabled: boolean;
+  exports: Record<string, FfiExportStats>;
+  marshalling: FfiMarshallingStats;
+};
+
+/**
+ * A synchronous native call that blocked the JS thread for longer than the
+ * watchdog threshold. `args` is a short summary of the arguments, giving only
+ * the length of strings, as they can be credentials.
+ */
+export type FfiWatchdogOffender = {
+  name: string;
+  durationMs: number;
+  args: string;
+};
+
+export type FfiWatchdogWarning = FfiWatchdogOffender & {
+  thresholdMs: number;
+};
+
+/**
+ * Groups of native exports that are only registered when one of them is
+ * first used, rather than when the addon loads.
+ */
+export type FfiExportGroup = 'consumer' | 'provider' | 'plugin';
+
 export type Ffi = {
   pactffiInit(logLevel: string): string;
   pactffiVersion(): string;
+  pactffiEnableStats(enabled: boolean): void;
+  pactffiStats(reset?: boolean): FfiStats;
+  pactffiAllocatorStats(): FfiAllocatorStats | null;
+  pactffiEnableWatchdog(
+    thresholdMs: number,
+    topN: number,
+    callback?: (warning: FfiWatchdogWarning) => void,
+  ): void;
+  pactffiWatchdogOffenders(reset?: boolean): FfiWatchdogOffender[];
+  pactffiEnableTrace(enabled: boolean, exitPath?: string): void;
+  pactffiWriteTrace(path: string, clear?: boolean): number;
+  pactffiExportGroups(): Record<FfiExportGroup, string[]>;
+  pactffiLoadExportGroup(group: FfiExportGroup): void;
 } & FfiConsumerFunctions &
   FfiVerificationFunctions;
 
@@ -122,6 +246,25 @@ export type FfiConsumerFunctions = {
     config: string,
   ): number;
   pactffiNewPact(consumer: string, provider: string): FfiPactHandle;
+  pactffiFreePactHandle(handle: FfiPactHandle): number;
+  pactffiAcquireSharedPact(
+    consumer: string,
+    provider: string,
+    specification: FfiSpecificationVersion,
+  ): FfiPactHandle;
+  pactffiReleaseSharedPact(
+    handle: FfiPactHandle,
+    dir: string,
+    overwrite: boolean,
+  ): FfiWritePactResponse;
+  pactffiImportPact(source: string | Buffer, journal?: boolean): FfiPactHandle;
+  pactffiEnableJournal(handle: FfiPactHandle): void;
+  pactffiSnapshotPact(handle: FfiPactHandle): Buffer;
+  pactffiRestorePact(snapshot: Buffer): FfiPactHandle;
+  pactffiInProcessPort(handle: FfiPactHandle): number;
+  pactffiInProcessMatched(handle: FfiPactHandle): boolean;
+  pactffiInProcessMismatches(handle: FfiPactHandle): string;
+  pactffiMatchValues(definition: string, values: string[]): (string | null)[];
   pactffiWithSpecification(
     handle: FfiPactHandle,
     specification: FfiSpecificationVersion,
@@ -136,6 +279,10 @@ export type FfiConsumerFunctions = {
     handle: FfiPactHandle,
     description: string,
   ): FfiInteractionHandle;
+  pactffiCloneInteraction(
+    handle: FfiInteractionHandle,
+    overrides: FfiCloneOverrides,
+  ): FfiInteractionHandle;
   pactffiUponReceiving(
     handle: FfiInteractionHandle,
     description: string,
@@ -188,11 +335,20 @@ export type FfiConsumerFunctions = {
     index: number,
     value: string,
   ): boolean;
+  pactffiWithHeaders(
+    handle: FfiInteractionHandle,
+    part: FfiInteractionPart,
+    headers: FfiEntries,
+  ): Record<string, boolean>;
+  pactffiWithQueryParameters(
+    handle: FfiInteractionHandle,
+    parameters: FfiEntries,
+  ): Record<string, boolean>;
   pactffiWithBody(
     handle: FfiInteractionHandle,
     part: FfiInteractionPart,
     contentType: string,
-    body: string,
+    body: string | FfiJsonBody,
   ): boolean;
   pactffiWithBinaryFile(
     handle: FfiInteractionHandle,
@@ -201,6 +357,12 @@ export type FfiConsumerFunctions = {
     body: Buffer,
     size: number,
   ): boolean;
+  pactffiWithBinaryFilePath(
+    handle: FfiInteractionHandle,
+    part: FfiInteractionPart,
+    contentType: string,
+    path: string,
+  ): boolean;
   pactffiWithMatchingRules(
     handle: FfiInteractionHandle,
     part: FfiInteractionPart,
@@ -214,6 +376,12 @@ export type FfiConsumerFunctions = {
     partName: string,
     boundary?: string,
   ): void;
+  pactffiWithMultipartParts(
+    handle: FfiInteractionHandle,
+    part: FfiInteractionPart,
+    parts: FfiMultipartPart[],
+    boundary?: string,
+  ): boolean;
   pactffiResponseStatus(handle: FfiInteractionHandle, status: string): boolean;
   pactffiWritePactFile(
     handle: FfiPactHandle,
@@ -233,8 +401,13 @@ export type FfiConsumerFunctions = {
   pactffiLogToBuffer(level: FfiLogLevelFilter): number;
   pactffiInitWithLogLevel(level: string): void;
   pactffiLogToStdout(level: FfiLogLevelFilter): number;
+  pactffiLogToStderr(level: FfiLogLevelFilter): number;
   pactffiLogToFile(fileName: string, level: FfiLogLevelFilter): number;
-  pactffiFetchLogBuffer(logId: number): string;
+  pactffiLogToSinks(sinks: FfiLogSink[]): number;
+  pactffiFetchLogBuffer(logId: string): string | null;
+  pactffiEnableTestLogs(): void;
+  pactffiFetchTestLogs(key: string | number): string;
+  pactffiDiscardTestLogs(testRunId: string): void;
   pactffiUsingPlugin(
     handle: FfiPactHandle,
     name: string,
@@ -306,7 +479,7 @@ export type FfiConsumerFunctions = {
   pactffiMessageWithContents(
     handle: FfiMessageHandle,
     contentType: string,
-    data: string,
+    data: string | FfiJsonBody,
   ): void;
   pactffiMessageWithBinaryContents(
     handle: FfiMessageHandle,
@@ -1,5 +1,13 @@
 export type LogLevel = 'debug' | 'error' | 'info' | 'trace' | 'warn';
 
+/**
+ * A destination for the native core's logs. `buffer` keeps records in memory
+ * so they can be fetched later, and `file` requires a `path`.
+ */
+export type LogSink =
+  | { type: 'stdout' | 'stderr' | 'buffer'; level: LogLevel }
+  | { type: 'file'; path: string; level: LogLevel };
+
 export type Logger = {
   pactCrash: (message: string, context?: string) => void;
   error: (message: string, context?: string) => void;
@@ -9,7 +9,10 @@ import {
   type ConsumerPact,
   getTlsCaCertificate,
   type MatchingResultRequestMismatch,
+  importConsumerPact,
   makeConsumerPact,
+  matchValues,
+  restoreConsumerPact,
 } from '../src';
 import { FfiSpecificationVersion } from '../src/ffi/types';
 
@@ -82,6 +85,310 @@ describe('FFI integration test for the HTTP Consumer API', () => {
         }));
   });
 
+  describe('with a JSON body given as an object', () => {
+    beforeEach(() => {
+      pact = makeConsumerPact(
+        'object-body-consumer',
+        'object-body-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V4,
+      );
+
+      const interaction = pact.newInteraction('object body test');
+      interaction.uponReceiving('a request with an object body');
+      interaction.withRequest('POST', '/dogs');
+      interaction.withRequestBody(
+        { name: like('fido'), tags: ['good', 'dog'] },
+        'application/json',
+      );
+      interaction.withStatus(201);
+      interaction.withResponseBody(
+        {
+          id: like(1234),
+          name: 'fido "the dog"\n',
+          weight: 12.5,
+          collar: null,
+          vet: undefined,
+        },
+        'application/json',
+      );
+      port = pact.createMockServer(HOST);
+    });
+
+    it('serialises the body and keeps embedded matchers', () =>
+      axios
+        .request({
+          baseURL: `http://${HOST}:${port}`,
+          data: { name: 'rex', tags: ['good', 'dog'] },
+          headers: { 'Content-Type': 'application/json' },
+          method: 'POST',
+          url: '/dogs',
+        })
+        .then((res) => {
+          expect(res.data).toEqual({
+            id: 1234,
+            name: 'fido "the dog"\n',
+            weight: 12.5,
+            collar: null,
+          });
+          expect(pact.mockServerMatchedSuccessfully(port)).toBe(true);
+        })
+        .finally(() => {
+          pact.cleanupMockServer(port);
+        }));
+  });
+
+  describe('with headers and query parameters set in one call', () => {
+    beforeEach(() => {
+      pact = makeConsumerPact(
+        'batch-consumer',
+        'batch-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V4,
+      );
+
+      const interaction = pact.newInteraction('batch setters test');
+      interaction.uponReceiving('a request with headers and a query');
+      interaction.withRequest('GET', '/dogs');
+      expect(
+        interaction.withQueryParameters({
+          breed: 'collie',
+          tag: ['good', 'fluffy'],
+        }),
+      ).toEqual({ breed: true, tag: true });
+      expect(
+        interaction.withRequestHeaders({
+          'x-request-id': {
+            value: '42',
+            'pact:matcher:type': 'regex',
+            regex: '\\d+',
+          },
+        }),
+      ).toEqual({ 'x-request-id': true });
+      interaction.withStatus(200);
+      expect(interaction.withResponseHeaders({ 'x-count': '2' })).toEqual({
+        'x-count': true,
+      });
+      port = pact.createMockServer(HOST);
+    });
+
+    it('matches every value', () =>
+      axios
+        .request({
+          baseURL: `http://${HOST}:${port}`,
+          headers: { 'x-request-id': '1234' },
+          method: 'GET',
+          url: '/dogs?breed=collie&tag=good&tag=fluffy',
+        })
+        .then((res) => {
+          expect(res.headers['x-count']).toEqual('2');
+          expect(pact.mockServerMatchedSuccessfully(port)).toBe(true);
+        })
+        .finally(() => {
+          pact.cleanupMockServer(port);
+        }));
+  });
+
+  describe('with cloned interactions', () => {
+    beforeEach(() => {
+      pact = makeConsumerPact(
+        'clone-consumer',
+        'clone-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V4,
+      );
+      pact.enableJournal();
+
+      const interaction = pact.newInteraction('a request for dog 1');
+      interaction.uponReceiving('a request for a dog');
+      interaction.given('dogs exist');
+      interaction.withRequest('GET', '/dogs/1');
+      interaction.withRequestHeader('Accept', 0, 'application/json');
+      interaction.withStatus(200);
+      interaction.withResponseBody({ id: like(1) }, 'application/json');
+
+      interaction.clone({
+        description: 'a request for dog 2',
+        path: '/dogs/2',
+        responseBody: { id: like(2), name: 'rex' },
+      });
+      port = pact.createMockServer(HOST);
+    });
+
+    it('serves the original and the copy', () => {
+      const request = (url: string) =>
+        axios.request({
+          baseURL: `http://${HOST}:${port}`,
+          headers: { Accept: 'application/json' },
+          method: 'GET',
+          url,
+        });
+
+      return Promise.all([request('/dogs/1'), request('/dogs/2')])
+        .then(([first, second]) => {
+          expect(first.data).toEqual({ id: 1 });
+          expect(second.data).toEqual({ id: 2, name: 'rex' });
+          expect(pact.mockServerMatchedSuccessfully(port)).toBe(true);
+
+          pact.writePactFile(path.join(__dirname, '__testoutput__'), false);
+          const pactJson = JSON.parse(
+            fs.readFileSync(
+              path.join(
+                __dirname,
+                '__testoutput__',
+                'clone-consumer-clone-provider.json',
+              ),
+              'utf8',
+            ),
+          );
+          const descriptions = (
+            pactJson.interactions as Array<{ description: string }>
+          ).map((entry) => entry.description);
+          expect(descriptions.sort()).toEqual([
+            'a request for a dog',
+            'a request for dog 2',
+          ]);
+        })
+        .finally(() => {
+          pact.cleanupMockServer(port);
+        });
+    });
+  });
+
+  describe('with an imported pact', () => {
+    const pactFile = {
+      consumer: { name: 'import-consumer' },
+      provider: { name: 'import-provider' },
+      interactions: [
+        {
+          description: 'a request for dog 1',
+          providerStates: [{ name: 'dogs exist', params: { id: 1 } }],
+          request: {
+            method: 'GET',
+            path: '/dogs/1',
+            query: { include: ['owner'] },
+            headers: { Accept: 'application/json' },
+          },
+          response: {
+            status: 200,
+            headers: { 'Content-Type': 'application/json' },
+            body: { id: 1, owner: 'alice' },
+            matchingRules: {
+              body: { '$.id': { matchers: [{ match: 'type' }] } },
+            },
+          },
+        },
+      ],
+      metadata: { pactSpecification: { version: '3.0.0' } },
+    };
+
+    beforeEach(() => {
+      pact = importConsumerPact(Buffer.from(JSON.stringify(pactFile)));
+      port = pact.createMockServer(HOST);
+    });
+
+    it('serves the interactions in the file', () =>
+      axios
+        .request({
+          baseURL: `http://${HOST}:${port}`,
+          headers: { Accept: 'application/json' },
+          method: 'GET',
+          url: '/dogs/1?include=owner',
+        })
+        .then((res) => {
+          expect(res.data).toEqual({ id: 1, owner: 'alice' });
+          expect(pact.mockServerMatchedSuccessfully(port)).toBe(true);
+        })
+        .finally(() => {
+          pact.cleanupMockServer(port);
+        }));
+
+    it('rejects pacts it cannot import', () => {
+      expect(() =>
+        importConsumerPact(Buffer.from(JSON.stringify({ consumer: {} }))),
+      ).toThrow(/no consumer name/);
+      pact.cleanupMockServer(port);
+    });
+  });
+
+  describe('with a restored snapshot', () => {
+    beforeEach(() => {
+      const base = makeConsumerPact(
+        'snapshot-consumer',
+        'snapshot-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V4,
+      );
+      base.enableJournal();
+      const login = base.newInteraction('a login');
+      login.uponReceiving('a login');
+      login.withRequest('POST', '/login');
+      login.withStatus(204);
+      const snapshot = base.snapshot();
+      base.dispose();
+
+      pact = restoreConsumerPact(snapshot);
+      const interaction = pact.newInteraction('a request for dog 1');
+      interaction.uponReceiving('a request for dog 1');
+      interaction.withRequest('GET', '/dogs/1');
+      interaction.withStatus(200);
+      interaction.withResponseBody({ id: 1 }, 'application/json');
+      port = pact.createMockServer(HOST);
+    });
+
+    it('serves the base interactions and the new ones', () => {
+      const client = axios.create({ baseURL: `http://${HOST}:${port}` });
+
+      return Promise.all([client.post('/login'), client.get('/dogs/1')])
+        .then(([login, dog]) => {
+          expect(login.status).toBe(204);
+          expect(dog.data).toEqual({ id: 1 });
+          expect(pact.mockServerMatchedSuccessfully(port)).toBe(true);
+        })
+        .finally(() => {
+          pact.cleanupMockServer(port);
+        });
+    });
+
+    it('rejects buffers that are not snapshots', () => {
+      expect(() => restoreConsumerPact(Buffer.from('{}'))).toThrow(
+        /not a pact snapshot/,
+      );
+      pact.cleanupMockServer(port);
+    });
+
+    it('keeps bodies from files, which may have gone by the restore', () => {
+      pact.cleanupMockServer(port);
+
+      const file = path.join(__dirname, '__testoutput__', 'snapshot-body.bin');
+      fs.writeFileSync(file, Buffer.from([1, 2, 3, 4]));
+      const base = makeConsumerPact(
+        'snapshot-file-consumer',
+        'snapshot-file-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V4,
+      );
+      base.enableJournal();
+      const interaction = base.newInteraction('a request for a file');
+      interaction.uponReceiving('a request for a file');
+      interaction.withRequest('GET', '/file');
+      interaction.withStatus(200);
+      interaction.withResponseBinaryFile(file, 'application/octet-stream');
+      const snapshot = base.snapshot();
+      base.dispose();
+      fs.rmSync(file);
+
+      const restored = restoreConsumerPact(snapshot);
+      const restoredPort = restored.createMockServer(HOST);
+      return axios
+        .get(`http://${HOST}:${restoredPort}/file`, {
+          responseType: 'arraybuffer',
+        })
+        .then((res) => {
+          expect(Buffer.from(res.data)).toEqual(Buffer.from([1, 2, 3, 4]));
+        })
+        .finally(() => {
+          restored.cleanupMockServer(restoredPort);
+          restored.dispose();
+        });
+    });
+  });
+
   describe('with JSON data', () => {
     beforeEach(() => {
       pact = makeConsumerPact(
@@ -557,6 +864,57 @@ describe('FFI integration test for the HTTP Consumer API', () => {
         }));
   });
 
+  describe('with binary data from a file', () => {
+    const bodyFile = path.join(__dirname, '__testoutput__', 'binary-body.gz');
+
+    beforeEach(() => {
+      fs.mkdirSync(path.dirname(bodyFile), { recursive: true });
+      fs.writeFileSync(bodyFile, bytes);
+
+      pact = makeConsumerPact(
+        'foo-consumer',
+        'bar-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V3,
+      );
+
+      const interaction = pact.newInteraction('some description');
+      interaction.uponReceiving('a request to upload a file');
+      interaction.withRequest('POST', '/uploads');
+      interaction.withRequestBinaryFile(bodyFile, 'application/gzip');
+      interaction.withStatus(201);
+
+      port = pact.createMockServer(HOST);
+    });
+
+    it('matches the file contents', () =>
+      axios
+        .request({
+          baseURL: `http://${HOST}:${port}`,
+          headers: { 'content-type': 'application/gzip' },
+          data: bytes,
+          method: 'POST',
+          url: '/uploads',
+        })
+        .then((res) => {
+          expect(res.status).toBe(201);
+          expect(pact.mockServerMatchedSuccessfully(port)).toBe(true);
+        })
+        .finally(() => {
+          pact.cleanupMockServer(port);
+        }));
+
+    it('throws for a missing file', () => {
+      const interaction = pact.newInteraction('a missing file');
+      expect(() =>
+        interaction.withResponseBinaryFile(
+          path.join(__dirname, '__testoutput__', 'missing.bin'),
+          'application/octet-stream',
+        ),
+      ).toThrow(/unable to open/);
+      pact.cleanupMockServer(port);
+    });
+  });
+
   // Should only run this if the plugin is installed
   const skipPluginTests = process.env['SKIP_PLUGIN_TESTS'] === 'true';
   (skipPluginTests ? describe.skip : describe)(
@@ -721,4 +1079,181 @@ describe('FFI integration test for the HTTP Consumer API', () => {
           pact.cleanupMockServer(port);
         }));
   });
+
+  describe('with multipart data from Buffers', () => {
+    const json = Buffer.from(JSON.stringify({ name: 'fido' }));
+    const photo = Buffer.alloc(256, 0xab);
+
+    beforeEach(() => {
+      pact = makeConsumerPact(
+        'foo-consumer',
+        'bar-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V3,
+      );
+
+      const interaction = pact.newInteraction('some description');
+      interaction.uponReceiving('a request to create a dog with a photo');
+      interaction.withRequest('POST', '/dogs');
+      interaction.withRequestMultipartParts([
+        { name: 'dog', contentType: 'application/json', body: json },
+        {
+          name: 'photo',
+          contentType: 'application/octet-stream',
+          body: photo,
+          filename: 'fido.bin',
+        },
+      ]);
+      interaction.withStatus(201);
+
+      port = pact.createMockServer(HOST);
+    });
+
+    it('matches a multipart request with both parts', () => {
+      const form = new FormData();
+      form.append('dog', json, { contentType: 'application/json' });
+      form.append('photo', photo, {
+        contentType: 'application/octet-stream',
+        filename: 'fido.bin',
+      });
+
+      return axios
+        .request({
+          baseURL: `http://${HOST}:${port}`,
+          headers: form.getHeaders(),
+          data: form.getBuffer(),
+          method: 'POST',
+          url: '/dogs',
+        })
+        .then((res) => {
+          expect(res.status).toBe(201);
+          expect(pact.mockServerMatchedSuccessfully(port)).toBe(true);
+        })
+        .finally(() => {
+          pact.cleanupMockServer(port);
+        });
+    });
+  });
+
+  describe('with in-process matching', () => {
+    beforeEach(() => {
+      pact = makeConsumerPact(
+        'in-process-consumer',
+        'in-process-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V3,
+      );
+
+      const interaction = pact.newInteraction('a request for dogs');
+      interaction.uponReceiving('a request for dogs');
+      interaction.withRequest('POST', '/dogs');
+      interaction.withQuery('breed', 0, 'a b');
+      interaction.withRequestBody({ name: 'fido' }, 'application/json');
+      interaction.withStatus(201);
+      interaction.withResponseHeader('x-dog', 0, 'fido');
+      interaction.withResponseBody({ id: 1 }, 'application/json');
+    });
+
+    afterEach(() => {
+      pact.dispose();
+    });
+
+    it('returns the response of the interaction a request matches', () =>
+      pact
+        .matchRequest(
+          {
+            method: 'POST',
+            path: '/dogs',
+            query: { breed: 'a b' },
+            headers: { 'content-type': 'application/json' },
+          },
+          Buffer.from(JSON.stringify({ name: 'fido' })),
+        )
+        .then((result) => {
+          expect(result.matched).toBe(true);
+          if (result.matched) {
+            expect(result.status).toBe(201);
+            expect(result.headers['x-dog']).toBe('fido');
+            expect(JSON.parse(result.body.toString())).toEqual({ id: 1 });
+          }
+          expect(pact.inProcessMatchedSuccessfully()).toBe(true);
+        }));
+
+    it('reports the mismatch for a request that does not match', () =>
+      pact
+        .matchRequest(
+          {
+            method: 'POST',
+            path: '/dogs',
+            query: { breed: 'a b' },
+            headers: { 'content-type': 'application/json' },
+          },
+          Buffer.from(JSON.stringify({ name: 'rex' })),
+        )
+        .then((result) => {
+          expect(result.matched).toBe(false);
+          if (!result.matched) {
+            expect(result.mismatch?.type).toBe('request-mismatch');
+            expect(
+              (result.mismatch as MatchingResultRequestMismatch).mismatches[0]
+                .type,
+            ).toBe('BodyMismatch');
+          }
+          expect(pact.inProcessMatchedSuccessfully()).toBe(false);
+          expect(pact.inProcessMismatches().length).toBeGreaterThan(0);
+        }));
+
+    it('gives each of two requests in flight together its own mismatch', async () => {
+      const [mismatched, notFound] = await Promise.all([
+        pact.matchRequest(
+          {
+            method: 'POST',
+            path: '/dogs',
+            query: { breed: 'a b' },
+            headers: { 'content-type': 'application/json' },
+          },
+          Buffer.from(JSON.stringify({ name: 'rex' })),
+        ),
+        pact.matchRequest({ method: 'GET', path: '/cats' }),
+      ]);
+
+      expect(mismatched.matched).toBe(false);
+      expect(notFound.matched).toBe(false);
+      if (!mismatched.matched) {
+        expect(mismatched.mismatch?.type).toBe('request-mismatch');
+      }
+      if (!notFound.matched) {
+        expect(notFound.mismatch?.type).toBe('request-not-found');
+        expect(notFound.mismatch).toMatchObject({ path: '/cats' });
+      }
+    });
+
+    it('does not start matching to answer whether it has matched', () => {
+      expect(pact.inProcessMatchedSuccessfully()).toBe(false);
+      expect(pact.inProcessMismatches()).toEqual([]);
+      const interaction = pact.newInteraction('a request for cats');
+      expect(interaction.uponReceiving('a request for cats')).toBe(true);
+    });
+  });
+
+  describe('with matcher definitions', () => {
+    it('checks every value against the matcher', () => {
+      expect(
+        matchValues("matching(regex, '[0-9]+', '100')", ['1', 'x', '42']),
+      ).toEqual([null, expect.stringContaining("'x'"), null]);
+    });
+
+    it('checks values against a datetime format', () => {
+      const results = matchValues(
+        "matching(datetime, 'yyyy-MM-dd', '2000-01-01')",
+        ['2024-02-29', '2024-13-01'],
+      );
+      expect(results[0]).toBeNull();
+      expect(results[1]).toEqual(expect.any(String));
+    });
+
+    it('rejects definitions that cannot be parsed', () => {
+      expect(() => matchValues('matching(regex', ['1'])).toThrow(
+        /not a valid matcher definition/,
+      );
+    });
+  });
 });
@@ -0,0 +1,80 @@
+import * as fs from 'node:fs';
+import * as path from 'node:path';
+import * as v8 from 'node:v8';
+import * as vm from 'node:vm';
+import { makeConsumerMessagePact, makeSharedConsumerPact } from '../src';
+import { getFfiLib } from '../src/ffi';
+import { FfiSpecificationVersion } from '../src/ffi/types';
+
+v8.setFlagsFromString('--expose-gc');
+const gc = vm.runInNewContext('gc') as () => void;
+
+// Finalizers run in a later task than the collection, so this collects and
+// yields until `released` holds or it gives up
+const collectUntil = async (released: () => boolean): Promise<boolean> => {
+  for (let i = 0; i < 50 && !released(); i += 1) {
+    gc();
+    await new Promise((resolve) => setTimeout(resolve, 10));
+  }
+  return released();
+};
+
+describe('Pacts dropped without being disposed', () => {
+  const ffi = getFfiLib();
+  const dir = path.join(__dirname, '__testoutput__');
+
+  beforeAll(() => {
+    // Loaded up front, so the exports are plain functions to spy on
+    ffi.pactffiLoadExportGroup('consumer');
+  });
+
+  afterEach(() => {
+    vi.restoreAllMocks();
+  });
+
+  it('frees a message pact once it is collected', async () => {
+    const free = vi.spyOn(ffi, 'pactffiFreePactHandle');
+
+    (() => {
+      const pact = makeConsumerMessagePact(
+        'release-consumer',
+        'release-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V4,
+      );
+      pact.newAsynchronousMessage('a dropped message');
+    })();
+
+    expect(await collectUntil(() => free.mock.calls.length > 0)).toBe(true);
+  });
+
+  it('releases a shared pact once it is collected, so the file is written', async () => {
+    const file = path.join(
+      dir,
+      'release-shared-consumer-release-shared-provider.json',
+    );
+    fs.rmSync(file, { force: true });
+
+    (() => {
+      makeSharedConsumerPact(
+        'release-shared-consumer',
+        'release-shared-provider',
+        FfiSpecificationVersion.SPECIFICATION_VERSION_V3,
+      );
+    })();
+
+    const pact = makeSharedConsumerPact(
+      'release-shared-consumer',
+      'release-shared-provider',
+      FfiSpecificationVersion.SPECIFICATION_VERSION_V3,
+    );
+    const interaction = pact.newInteraction('a request for dogs');
+    interaction.uponReceiving('a request for dogs');
+    interaction.withRequest('GET', '/dogs');
+    interaction.withStatus(200);
+    pact.writePactFile(dir, false);
+
+    // The dropped pact still holds a reference, so the write waits for it
+    expect(fs.existsSync(file)).toBe(false);
+    expect(await collectUntil(() => fs.existsSync(file))).toBe(true);
+  });
+});
@@ -0,0 +1,70 @@
+import axios from 'axios';
+import {
+  discardTestLogs,
+  enableTestLogs,
+  fetchTestLogs,
+  makeConsumerPact,
+  setLogSinks,
+  setTestRunId,
+} from '../src';
+import { FfiSpecificationVersion } from '../src/ffi/types';
+
+const HOST = '127.0.0.1';
+
+// The core logger is configured once per process, so this file has its own
+// (vitest runs each file in a fork) with a buffer sink to collect from
+setLogSinks([{ type: 'buffer', level: 'debug' }]);
+
+describe('FFI integration test for per-test core logs', () => {
+  const runTest = (testRunId: string, dogsPath = '/dogs') => {
+    setTestRunId(testRunId);
+    const pact = makeConsumerPact(
+      'logs-consumer',
+      'logs-provider',
+      FfiSpecificationVersion.SPECIFICATION_VERSION_V3,
+    );
+    const interaction = pact.newInteraction('a request for dogs');
+    interaction.uponReceiving('a request for dogs');
+    interaction.withRequest('GET', dogsPath);
+    interaction.withStatus(200);
+    const port = pact.createMockServer(HOST);
+
+    return axios
+      .get(`http://${HOST}:${port}${dogsPath}`)
+      .then(() => port)
+      .finally(() => {
+        setTestRunId('');
+        pact.cleanupMockServer(port);
+        pact.dispose();
+      });
+  };
+
+  beforeAll(() => {
+    enableTestLogs();
+  });
+
+  it('returns the mock server records collected for a test, once', () =>
+    runTest('fetched').then(() => {
+      expect(fetchTestLogs('fetched')).toContain('/dogs');
+      expect(fetchTestLogs('fetched')).toBe('');
+    }));
+
+  it('drops the records of a discarded test', () =>
+    runTest('discarded').then(() => {
+      discardTestLogs('discarded');
+      expect(fetchTestLogs('discarded')).toBe('');
+    }));
+
+  it('keeps the records of each test apart', () =>
+    Promise.all([
+      runTest('first', '/dogs/first'),
+      runTest('second', '/dogs/second'),
+    ]).then(() => {
+      const first = fetchTestLogs('first');
+      const second = fetchTestLogs('second');
+      expect(first).toContain('/dogs/first');
+      expect(first).not.toContain('/dogs/second');
+      expect(second).toContain('/dogs/second');
+      expect(second).not.toContain('/dogs/first');
+    }));
+});
@@ -0,0 +1,153 @@
+import * as fs from 'node:fs';
+import * as path from 'node:path';
+import { Worker } from 'node:worker_threads';
+
+// Each worker loads its own copy of the addon, creates verifiers and a mock
+// server, and checks it only ever sees its own handles
+const workerSource = `
+const { parentPort, workerData } = require('node:worker_threads');
+const ffi = require('node-gyp-build')(workerData.bindingPath);
+ffi.pactffiLoadExportGroup('consumer');
+ffi.pactffiLoadExportGroup('provider');
+
+const verifiers = [];
+for (let i = 0; i < 20; i += 1) {
+  verifiers.push(ffi.pactffiVerifierNewForApplication('worker-' + workerData.id, '1.0.0'));
+}
+
+const pact = ffi.pactffiNewPact('worker-consumer-' + workerData.id, 'worker-provider');
+const interaction = ffi.pactffiNewInteraction(pact, 'a request');
+ffi.pactffiUponReceiving(interaction, 'a request');
+ffi.pactffiWithRequest(interaction, 'GET', '/');
+ffi.pactffiResponseStatus(interaction, '200');
+const port = ffi.pactffiCreateMockServerForTransport(pact, '127.0.0.1', 0, 'http', '');
+const matched = ffi.pactffiMockServerMatched(port);
+ffi.pactffiCleanupMockServer(port);
+ffi.pactffiFreePactHandle(pact);
+
+for (const verifier of verifiers) {
+  ffi.pactffiVerifierShutdown(verifier);
+}
+
+parentPort.postMessage({ verifiers, port, matched });
+`;
+
+const runWorker = (id: number) =>
+  new Promise<{ verifiers: number[]; port: number; matched: boolean }>(
+    (resolve, reject) => {
+      const worker = new Worker(workerSource, {
+        eval: true,
+        workerData: {
+          id,
+          bindingPath: process.env['PACT_PREBUILD_LOCATION'] ?? path.resolve(),
+        },
+      });
+      worker.once('message', resolve);
+      worker.once('error', reject);
+    },
+  );
+
+describe('Loading the addon from worker threads', () => {
+  it('keeps handle tables separate per worker', async () => {
+    const results = await Promise.all(
+      Array.from({ length: 8 }, (_, id) => runWorker(id)),
+    );
+
+    for (const result of results) {
+      // Ids start from 0 in every worker, as each has its own table
+      expect(result.verifiers).toEqual(Array.from({ length: 20 }, (_, i) => i));
+      expect(result.port).toBeGreaterThan(0);
+      expect(result.matched).toBe(false);
+    }
+  });
+});
+
+// Two workers share a pact for the same consumer and provider. The second adds
+// its interaction after the first has started a mock server, and each only
+// calls its own.
+const sharedWorkerSource = `
+const { parentPort, workerData } = require('node:worker_threads');
+const ffi = require('node-gyp-build')(workerData.bindingPath);
+ffi.pactffiLoadExportGroup('consumer');
+
+const description = 'a request from worker ' + workerData.id;
+const pact = ffi.pactffiAcquireSharedPact('shared-consumer', 'shared-provider', 3);
+const interaction = ffi.pactffiNewInteraction(pact, description);
+const added = [
+  ffi.pactffiUponReceiving(interaction, description),
+  ffi.pactffiWithRequest(interaction, 'GET', '/' + workerData.id),
+  ffi.pactffiResponseStatus(interaction, '200'),
+].every(Boolean);
+const port = ffi.pactffiCreateMockServerForTransport(pact, '127.0.0.1', 0, 'http', '');
+parentPort.postMessage({ added });
+
+parentPort.once('message', async () => {
+  const res = await fetch('http://127.0.0.1:' + port + '/' + workerData.id);
+  const matched = ffi.pactffiMockServerMatched(port);
+  ffi.pactffiCleanupMockServer(port);
+  const written = ffi.pactffiReleaseSharedPact(pact, workerData.dir, true);
+  parentPort.postMessage({ status: res.status, matched, written });
+});
+`;
+
+type SharedWorkerResult = {
+  status: number;
+  matched: boolean;
+  written: number;
+};
+
+describe('Sharing a pact between worker threads', () => {
+  const dir = path.join(__dirname, '__testoutput__');
+
+  const startWorker = (id: number) =>
+    new Promise<{ worker: Worker; added: boolean }>((resolve, reject) => {
+      const worker = new Worker(sharedWorkerSource, {
+        eval: true,
+        workerData: {
+          id,
+          dir,
+          bindingPath: process.env['PACT_PREBUILD_LOCATION'] ?? path.resolve(),
+        },
+      });
+      worker.once('message', ({ added }) => resolve({ worker, added }));
+      worker.once('error', reject);
+    });
+
+  const finish = (worker: Worker) =>
+    new Promise<SharedWorkerResult>((resolve, reject) => {
+      worker.once('message', resolve);
+      worker.once('error', reject);
+      worker.postMessage('finish');
+    });
+
+  it('gives each worker a mock server of its own, writing both', async () => {
+    const first = await startWorker(1);
+    const second = await startWorker(2);
+    expect(first.added).toBe(true);
+    expect(second.added).toBe(true);
+
+    // In turn, so the second release is the one that writes the file
+    const firstResult = await finish(first.worker);
+    const secondResult = await finish(second.worker);
+
+    for (const result of [firstResult, secondResult]) {
+      expect(result.status).toBe(200);
+      expect(result.matched).toBe(true);
+      expect(result.written).toBe(0);
+    }
+
+    const pactJson = JSON.parse(
+      fs.readFileSync(
+        path.join(dir, 'shared-consumer-shared-provider.json'),
+        'utf8',
+      ),
+    );
+    const descriptions = (
+      pactJson.interactions as Array<{ description: string }>
+    ).map((entry) => entry.description);
+    expect(descriptions.sort()).toEqual([
+      'a request from worker 1',
+      'a request from worker 2',
+    ]);
+  });
+});